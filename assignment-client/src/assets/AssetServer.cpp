@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -36,6 +37,7 @@
 #include <image/TextureProcessing.h>
 
 #include "AssetServerLogging.h"
+#include "AssetStore.h"
 #include "BakeAssetTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
@@ -117,7 +119,7 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath, _numOvenThreads);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -131,6 +133,15 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     }
 }
 
+void AssetServer::prioritizeBake(const AssetUtils::AssetHash& assetHash) {
+    // bakes that have already started stay where they are
+    auto it = _pendingBakes.find(assetHash);
+    if (it != _pendingBakes.end() && _bakingTaskPool.tryTake(it->get())) {
+        // the most recently asked for assets bake first, then the rest in the order they were queued
+        _bakingTaskPool.start(it->get(), ++_lastRequestedBakePriority);
+    }
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -293,6 +304,7 @@ void updateConsumedCores() {
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
+    _pendingAssetGets(std::make_shared<PendingAssetGets>()),
     _transferTaskPool(this),
     _bakingTaskPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
@@ -423,6 +435,7 @@ void AssetServer::completeSetup() {
         setFinished(true);
         return;
     }
+    _assetStore = std::make_shared<AssetStore>(_filesDirectory);
 
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
@@ -458,6 +471,20 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // bakes share a number of cores with the mixers running next to the asset server, the ovens are made with no more
+    // worker threads than that between them
+    static const QString BAKING_CORES_OPTION = "baking_cores";
+    static const int CORES_PER_BAKE = 2;
+    int bakingCores = assetServerObject[BAKING_CORES_OPTION].toInt(0);
+    if (bakingCores <= 0) {
+        bakingCores = std::max(1, (int)std::thread::hardware_concurrency() / 2);
+    }
+    int numConcurrentBakes = std::max(1, bakingCores / CORES_PER_BAKE);
+    _numOvenThreads = std::max(1, bakingCores / numConcurrentBakes);
+    _bakingTaskPool.setMaxThreadCount(numConcurrentBakes);
+    qCInfo(asset_server) << "Baking on" << bakingCores << "cores," << numConcurrentBakes << "assets at a time with"
+        << _numOvenThreads << "threads each.";
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -536,6 +563,7 @@ void AssetServer::cleanupUnmappedFiles() {
             }
             if (!matched) {
                 // remove the unmapped file
+                _assetStore->remove(filename);
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -695,6 +723,11 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
                     maybeBake(assetPath, originalAssetHash);
                 }
             }
+
+            // someone is waiting on the baked version
+            if (!bakingDisabled) {
+                prioritizeBake(originalAssetHash);
+            }
         }
     } else {
         replyPacket.writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -841,13 +874,13 @@ void AssetServer::handleAssetGetInfo(QSharedPointer<ReceivedMessage> message, Sh
     replyPacket->writePrimitive(messageID);
     replyPacket->write(assetHash);
 
-    QString fileName = QString(hexHash);
-    QFileInfo fileInfo { _filesDirectory.filePath(fileName) };
+    // the asset is usually about to be downloaded, so it's mapped here for that, and the infos asked for while it's
+    // mapped don't go to the disk
+    MappedAssetPointer asset = _assetStore->get(QString(hexHash));
 
-    if (fileInfo.exists() && fileInfo.isReadable()) {
-        qCDebug(asset_server) << "Opening file: " << fileInfo.filePath();
+    if (asset) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-        replyPacket->writePrimitive(fileInfo.size());
+        replyPacket->writePrimitive(asset->getSize());
     } else {
         qCDebug(asset_server) << "Asset not found: " << QString(hexHash);
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -866,9 +899,21 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
         return;
     }
 
-    // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
-    _transferTaskPool.start(task);
+    PendingAssetGets::Key key;
+    PendingAssetGets::Request request { message, senderNode, 0 };
+    message->readPrimitive(&request.messageID);
+    key.hash = message->read(AssetUtils::SHA256_HASH_LENGTH);
+    message->readPrimitive(&key.byteRange.fromInclusive);
+    message->readPrimitive(&key.byteRange.toExclusive);
+
+    qCDebug(asset_server) << "Received a request for the file (" << request.messageID << "): " << key.hash.toHex()
+        << " from " << key.byteRange.fromInclusive << " to " << key.byteRange.toExclusive;
+
+    // Queue task, unless one is already looking up this range and can send it to this node too
+    if (_pendingAssetGets->add(key, request)) {
+        auto task = new SendAssetTask(key, _pendingAssetGets, _assetStore);
+        _transferTaskPool.start(task);
+    }
 }
 
 void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -881,7 +926,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _assetStore, _filesizeLimit);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -957,6 +1002,14 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    quint64 numGets = _pendingAssetGets->getNumRequests();
+    quint64 numCoalescedGets = _pendingAssetGets->getNumCoalescedRequests();
+    QJsonObject getStats;
+    getStats["1. Requests"] = (double)numGets;
+    getStats["2. Coalesced"] = (double)numCoalescedGets;
+    getStats["3. Coalesce Ratio"] = numGets > 0 ? (double)numCoalescedGets / numGets : 0.0;
+    serverStats["Asset Gets"] = getStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1170,6 +1223,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
+            _assetStore->remove(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
@@ -1537,13 +1591,18 @@ bool AssetServer::writeMetaFile(AssetUtils::AssetHash originalAssetHash, const A
     // get a hash for the contents of the meta-file
     AssetUtils::AssetHash metaFileHash = QCryptographicHash::hash(metaFileJSON, QCryptographicHash::Sha256).toHex();
 
-    // create the meta file in our files folder, named by the hash of its contents
-    QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
+    // create the meta file in our files folder, named by the hash of its contents. One that already exists has the
+    // same contents and may be mapped by the asset store, so it is left alone, and a new one is written atomically
+    auto metaFilePath = _filesDirectory.absoluteFilePath(metaFileHash);
+    bool hasMetaFile = QFile::exists(metaFilePath);
 
-    if (metaFile.open(QIODevice::WriteOnly)) {
-        metaFile.write(metaFileJSON);
-        metaFile.close();
+    if (!hasMetaFile) {
+        QSaveFile metaFile(metaFilePath);
+        hasMetaFile = metaFile.open(QIODevice::WriteOnly) && metaFile.write(metaFileJSON) == metaFileJSON.size()
+            && metaFile.commit();
+    }
 
+    if (hasMetaFile) {
         // add a mapping to the meta file so it doesn't get deleted because it is unmapped
         auto metaFileMapping = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + originalAssetHash + "/" + "meta.json";
 
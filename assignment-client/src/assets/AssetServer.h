@@ -68,7 +68,9 @@ struct AssetMeta {
     QString redirectTarget;
 };
 
+class AssetStore;
 class BakeAssetTask;
+class PendingAssetGets;
 
 class AssetServer : public ThreadedAssignment {
     Q_OBJECT
@@ -135,6 +137,8 @@ private:
     bool hasMetaFile(const AssetUtils::AssetHash& hash);
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    /// Move a queued bake ahead of the others, because its asset was just asked for
+    void prioritizeBake(const AssetUtils::AssetHash& assetHash);
 
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
@@ -153,11 +157,19 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// The asset files downloads are sent from
+    std::shared_ptr<AssetStore> _assetStore;
+
+    /// Downloads waiting on the same range of the same asset, which are sent together
+    std::shared_ptr<PendingAssetGets> _pendingAssetGets;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
+    int _numOvenThreads { 0 };
+    int _lastRequestedBakePriority { 0 };
 
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
@@ -0,0 +1,96 @@
+//
+//  AssetStore.cpp
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-06-27.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetStore.h"
+
+#include "AssetServerLogging.h"
+
+MappedAsset::MappedAsset(const QString& filePath) :
+    _file(filePath)
+{
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    _size = _file.size();
+    if (_size == 0) {
+        // empty files can't be mapped, but are still assets
+        _isValid = true;
+        return;
+    }
+    _data = _file.map(0, _size);
+    if (!_data) {
+        qCWarning(asset_server) << "Failed to map asset file" << filePath << _file.errorString();
+        return;
+    }
+    _isValid = true;
+}
+
+MappedAsset::~MappedAsset() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+AssetStore::AssetStore(const QDir& filesDirectory, int maxMappedAssets, qint64 maxMappedBytes) :
+    _filesDirectory(filesDirectory),
+    _maxMappedAssets(maxMappedAssets),
+    _maxMappedBytes(maxMappedBytes)
+{
+}
+
+MappedAssetPointer AssetStore::get(const AssetUtils::AssetHash& hash) {
+    {
+        QMutexLocker locker(&_mutex);
+        auto it = _mappedAssets.find(hash);
+        if (it != _mappedAssets.end()) {
+            _lru.splice(_lru.begin(), _lru, it.value());
+            return _lru.front().second;
+        }
+    }
+
+    // map it without the lock, so that requests for other assets don't wait on the disk
+    auto asset = std::make_shared<const MappedAsset>(_filesDirectory.filePath(hash));
+    if (!asset->isValid()) {
+        return nullptr;
+    }
+
+    QMutexLocker locker(&_mutex);
+    auto it = _mappedAssets.find(hash);
+    if (it != _mappedAssets.end()) {
+        // another request mapped it first
+        _lru.splice(_lru.begin(), _lru, it.value());
+        return _lru.front().second;
+    }
+    _lru.emplace_front(hash, asset);
+    _mappedAssets.insert(hash, _lru.begin());
+    _mappedBytes += asset->getSize();
+    evict();
+    return asset;
+}
+
+void AssetStore::remove(const AssetUtils::AssetHash& hash) {
+    QMutexLocker locker(&_mutex);
+    auto it = _mappedAssets.find(hash);
+    if (it != _mappedAssets.end()) {
+        _mappedBytes -= it.value()->second->getSize();
+        _lru.erase(it.value());
+        _mappedAssets.erase(it);
+    }
+}
+
+void AssetStore::evict() {
+    // the asset just added is always kept, the requests already sending the evicted ones keep them mapped until they're done
+    while (_lru.size() > 1 && ((int)_lru.size() > _maxMappedAssets || _mappedBytes > _maxMappedBytes)) {
+        _mappedBytes -= _lru.back().second->getSize();
+        _mappedAssets.remove(_lru.back().first);
+        _lru.pop_back();
+    }
+}
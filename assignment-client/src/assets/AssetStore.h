@@ -0,0 +1,77 @@
+//
+//  AssetStore.h
+//  assignment-client/src/assets
+//
+//  Created by High Fidelity on 2019-06-27.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetStore_h
+#define hifi_AssetStore_h
+
+#include <list>
+#include <memory>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+
+#include <AssetUtils.h>
+
+// An asset file mapped into memory, whose ranges are written to packets straight from the page cache.
+class MappedAsset {
+public:
+    MappedAsset(const QString& filePath);
+    ~MappedAsset();
+
+    bool isValid() const { return _isValid; }
+    const char* getData() const { return reinterpret_cast<const char*>(_data); }
+    qint64 getSize() const { return _size; }
+
+private:
+    QFile _file;
+    uchar* _data { nullptr };
+    qint64 _size { 0 };
+    bool _isValid { false };
+};
+
+using MappedAssetPointer = std::shared_ptr<const MappedAsset>;
+
+// The asset files the asset server sends. The most recently requested ones stay mapped, up to a number of files and
+// a total size, so that a burst of requests for the same assets (everyone arriving in a domain at once) doesn't open
+// and map them again for each request. Asset files never change once they're written, so a mapping stays good until
+// its file is deleted. Thread-safe.
+class AssetStore {
+public:
+    static const int DEFAULT_MAX_MAPPED_ASSETS = 512;
+    static const qint64 DEFAULT_MAX_MAPPED_BYTES = 1024LL * 1024 * 1024;
+
+    AssetStore(const QDir& filesDirectory, int maxMappedAssets = DEFAULT_MAX_MAPPED_ASSETS,
+               qint64 maxMappedBytes = DEFAULT_MAX_MAPPED_BYTES);
+
+    // returns nullptr if there's no such asset
+    MappedAssetPointer get(const AssetUtils::AssetHash& hash);
+
+    // drops the mapping of an asset, call before its file is deleted
+    void remove(const AssetUtils::AssetHash& hash);
+
+private:
+    using LRUList = std::list<std::pair<AssetUtils::AssetHash, MappedAssetPointer>>;
+
+    void evict();
+
+    QDir _filesDirectory;
+    int _maxMappedAssets;
+    qint64 _maxMappedBytes;
+
+    QMutex _mutex;
+    LRUList _lru; // most recently requested first
+    QHash<AssetUtils::AssetHash, LRUList::iterator> _mappedAssets;
+    qint64 _mappedBytes { 0 };
+};
+
+#endif // hifi_AssetStore_h
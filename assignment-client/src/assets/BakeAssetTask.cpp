@@ -24,10 +24,12 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 std::once_flag registerMetaTypesFlag;
 
-BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
+BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                             int numOvenThreads) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _numOvenThreads(numOvenThreads)
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -71,6 +73,9 @@ void BakeAssetTask::run() {
         "-o", tempOutputDir,
         "-t", extension,
     };
+    if (_numOvenThreads > 0) {
+        args << "--threads" << QString::number(_numOvenThreads);
+    }
 
     _ovenProcess.reset(new QProcess());
 
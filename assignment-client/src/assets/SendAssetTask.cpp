@@ -13,8 +13,6 @@
 
 #include <cmath>
 
-#include <QFile>
-
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
 #include <NLPacket.h>
@@ -23,98 +21,110 @@
 #include <udt/Packet.h>
 
 #include "AssetUtils.h"
-#include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+bool PendingAssetGets::add(const Key& key, const Request& request) {
+    QMutexLocker locker(&_mutex);
+    _numRequests++;
+    auto& requests = _requests[key];
+    requests.push_back(request);
+    if (requests.size() > 1) {
+        _numCoalescedRequests++;
+        return false;
+    }
+    return true;
+}
+
+std::vector<PendingAssetGets::Request> PendingAssetGets::take(const Key& key) {
+    QMutexLocker locker(&_mutex);
+    std::vector<Request> requests;
+    auto it = _requests.find(key);
+    if (it != _requests.end()) {
+        requests.swap(it->second);
+        _requests.erase(it);
+    }
+    return requests;
+}
+
+SendAssetTask::SendAssetTask(const PendingAssetGets::Key& key, std::shared_ptr<PendingAssetGets> pendingGets,
+                             std::shared_ptr<AssetStore> assetStore) :
     QRunnable(),
-    _message(message),
-    _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _key(key),
+    _pendingGets(pendingGets),
+    _assetStore(assetStore)
 {
-    
+
 }
 
 void SendAssetTask::run() {
-    MessageID messageID;
-    ByteRange byteRange;
-
-    _message->readPrimitive(&messageID);
-    QByteArray assetHash = _message->read(AssetUtils::SHA256_HASH_LENGTH);
-
     // `start` and `end` indicate the range of data to retrieve for the asset identified by `assetHash`.
     // `start` is inclusive, `end` is exclusive. Requesting `start` = 1, `end` = 10 will retrieve 9 bytes of data,
     // starting at index 1.
-    _message->readPrimitive(&byteRange.fromInclusive);
-    _message->readPrimitive(&byteRange.toExclusive);
-    
-    QString hexHash = assetHash.toHex();
-    
-    qDebug() << "Received a request for the file (" << messageID << "): " << hexHash << " from "
-        << byteRange.fromInclusive << " to " << byteRange.toExclusive;
-    
-    qDebug() << "Starting task to send asset: " << hexHash << " for messageID " << messageID;
-    auto replyPacketList = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
+    ByteRange byteRange = _key.byteRange;
+    QString hexHash = _key.hash.toHex();
 
-    replyPacketList->write(assetHash);
+    qDebug() << "Starting task to send asset: " << hexHash << " from "
+        << byteRange.fromInclusive << " to " << byteRange.toExclusive;
 
-    replyPacketList->writePrimitive(messageID);
+    // the range is looked up once for everyone who asks for it while this runs
+    AssetUtils::AssetServerError error = AssetUtils::AssetServerError::NoError;
+    MappedAssetPointer asset;
+    int64_t offset = 0;
+    int64_t size = 0;
 
     if (!byteRange.isValid()) {
-        replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+        error = AssetUtils::AssetServerError::InvalidByteRange;
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        asset = _assetStore->get(hexHash);
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (asset) {
+            qint64 fileSize = asset->getSize();
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
-                replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
+                error = AssetUtils::AssetServerError::InvalidByteRange;
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
             } else {
-                // we have a valid byte range, handle it and send the asset
-                auto size = byteRange.size();
-
-                if (byteRange.fromInclusive >= 0) {
+                // we have a valid byte range, a negative range is read back from the end of the file
+                size = byteRange.size();
+                offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
+            }
+        } else {
+            qCDebug(networking) << "Asset not found: " << hexHash;
+            error = AssetUtils::AssetServerError::AssetNotFound;
+        }
+    }
 
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto requests = _pendingGets->take(_key);
+    for (const auto& request : requests) {
+        auto replyPacketList = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
 
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+        replyPacketList->write(_key.hash);
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
+        replyPacketList->writePrimitive(request.messageID);
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+        replyPacketList->writePrimitive(error);
+        if (error == AssetUtils::AssetServerError::NoError) {
+            replyPacketList->writePrimitive(size);
 
-                qCDebug(networking) << "Sending asset: " << hexHash;
+            // straight from the mapped file into the packets
+            if (size > 0) {
+                replyPacketList->write(asset->getData() + offset, size);
             }
-            file.close();
-        } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
-            replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
+
+            qCDebug(networking) << "Sending asset: " << hexHash << " for messageID " << request.messageID;
         }
-    }
 
-    auto nodeList = DependencyManager::get<NodeList>();
-    if (_senderNode) {
-        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
-    } else {
-        nodeList->sendPacketList(std::move(replyPacketList), _message->getSenderSockAddr());
+        if (request.senderNode) {
+            nodeList->sendPacketList(std::move(replyPacketList), *request.senderNode);
+        } else {
+            nodeList->sendPacketList(std::move(replyPacketList), request.message->getSenderSockAddr());
+        }
     }
 }
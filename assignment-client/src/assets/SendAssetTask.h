@@ -12,27 +12,72 @@
 #ifndef hifi_SendAssetTask_h
 #define hifi_SendAssetTask_h
 
+#include <atomic>
+#include <map>
+#include <tuple>
+#include <vector>
+
 #include <QtCore/QByteArray>
+#include <QtCore/QMutex>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QString>
 #include <QtCore/QRunnable>
 
 #include "AssetUtils.h"
 #include "AssetServer.h"
+#include "AssetStore.h"
+#include "ByteRange.h"
 #include "Node.h"
 
 class NLPacket;
 
+// The asset gets that are waiting on the same range of the same asset. When a domain loads, many agents ask for the
+// same assets at about the same time, and the ones that ask while a range is already being looked up are answered
+// along with the first, by the same task. Thread-safe.
+class PendingAssetGets {
+public:
+    struct Key {
+        QByteArray hash;
+        ByteRange byteRange;
+
+        bool operator<(const Key& other) const {
+            return std::tie(hash, byteRange.fromInclusive, byteRange.toExclusive) <
+                std::tie(other.hash, other.byteRange.fromInclusive, other.byteRange.toExclusive);
+        }
+    };
+
+    struct Request {
+        QSharedPointer<ReceivedMessage> message;
+        SharedNodePointer senderNode;
+        MessageID messageID;
+    };
+
+    // returns true if this is the only request for the range, which then needs a task to send it
+    bool add(const Key& key, const Request& request);
+    // takes the requests for the range, those added after this need another task
+    std::vector<Request> take(const Key& key);
+
+    quint64 getNumRequests() const { return _numRequests; }
+    quint64 getNumCoalescedRequests() const { return _numCoalescedRequests; }
+
+private:
+    QMutex _mutex;
+    std::map<Key, std::vector<Request>> _requests;
+    std::atomic<quint64> _numRequests { 0 };
+    std::atomic<quint64> _numCoalescedRequests { 0 };
+};
+
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(const PendingAssetGets::Key& key, std::shared_ptr<PendingAssetGets> pendingGets,
+                  std::shared_ptr<AssetStore> assetStore);
 
     void run() override;
 
 private:
-    QSharedPointer<ReceivedMessage> _message;
-    SharedNodePointer _senderNode;
-    QDir _resourcesDir;
+    PendingAssetGets::Key _key;
+    std::shared_ptr<PendingAssetGets> _pendingGets;
+    std::shared_ptr<AssetStore> _assetStore;
 };
 
 #endif
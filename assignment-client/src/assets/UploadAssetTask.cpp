@@ -11,8 +11,10 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
+#include <cstring>
+
 #include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
@@ -21,26 +23,26 @@
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, std::shared_ptr<AssetStore> assetStore,
+                                 uint64_t filesizeLimit) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
+    _assetStore(assetStore),
     _filesizeLimit(filesizeLimit)
 {
     
 }
 
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
+    // the upload is read in place from the received message, without copying it
+    _receivedMessage->seek(0);
+
     MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
+    _receivedMessage->readPrimitive(&messageID);
     
     uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    _receivedMessage->readPrimitive(&fileSize);
 
     if (_senderNode) {
         qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
@@ -53,8 +55,11 @@ void UploadAssetTask::run() {
     
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else if (fileSize > (uint64_t)_receivedMessage->getBytesLeftToRead()) {
+        qWarning() << "Upload is shorter than its file size of" << fileSize << "bytes - upload failed.";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
+        QByteArray fileData = _receivedMessage->readWithoutCopy(fileSize);
         
         auto hash = AssetUtils::hashData(fileData);
         auto hexHash = hash.toHex();
@@ -64,14 +69,14 @@ void UploadAssetTask::run() {
         } else {
             qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
         }
-        
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
 
+        // check if the local file has the correct contents, otherwise we overwrite; it's compared through its mapping
+        // instead of being read and hashed again
         bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
+        MappedAssetPointer existingAsset = _assetStore->get(QString(hexHash));
+        if (existingAsset) {
+            if (existingAsset->getSize() == fileData.size() &&
+                (fileData.isEmpty() || memcmp(existingAsset->getData(), fileData.constData(), fileData.size()) == 0)) {
                 qDebug() << "Not overwriting existing verified file: " << hexHash;
 
                 existingCorrectFile = true;
@@ -80,32 +85,28 @@ void UploadAssetTask::run() {
                 replyPacket->write(hash);
             } else {
                 qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
             }
+            existingAsset.reset();
         }
 
         if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            // the file is written next to where it goes and then renamed over it, so that it's never seen half written,
+            // and the requests still sending the old file keep what they mapped
+            QSaveFile file { _resourcesDir.filePath(QString(hexHash)) };
+
+            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize) && file.commit()) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
+                _assetStore->remove(QString(hexHash));
 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
                 replyPacket->write(hash);
             } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
-
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
+                // upload has failed - the file is left as it was, and an error is returned
+                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed." << file.errorString();
 
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
-                
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
             }
         }
-
-
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
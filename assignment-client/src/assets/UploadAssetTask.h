@@ -19,6 +19,7 @@
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include "AssetStore.h"
 #include "ReceivedMessage.h"
 
 class NLPacketList;
@@ -26,8 +27,8 @@ class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
-    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+    UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode,
+                    const QDir& resourcesDir, std::shared_ptr<AssetStore> assetStore, uint64_t filesizeLimit);
 
     void run() override;
 
@@ -35,6 +36,7 @@ private:
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
+    std::shared_ptr<AssetStore> _assetStore;
     uint64_t _filesizeLimit;
 };
 
@@ -129,7 +129,7 @@ void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, Share
         _numSilentPackets++;
     }
 
-    getOrCreateClientData(node.data())->queuePacket(message, node);
+    getOrCreateClientData(node.data())->queuePacket(message);
 }
 
 void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> message) {
@@ -157,7 +157,7 @@ void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> mess
                                                                      versionForPacketType(rewrittenType),
                                                                      message->getSenderSockAddr(), Node::NULL_LOCAL_ID);
 
-    getOrCreateClientData(replicatedNode.data())->queuePacket(replicatedMessage, replicatedNode);
+    getOrCreateClientData(replicatedNode.data())->queuePacket(replicatedMessage);
 }
 
 void AudioMixer::handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -281,6 +281,7 @@ void AudioMixer::sendStatsPacket() {
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
 
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["thread_steals_per_frame"] = (float)_slavePool.sampleNumSteals() / (float)_numStatFrames;
 
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
@@ -290,6 +291,12 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
+    statsObject["packet_queue_contentions"] = _stats.packetQueueContentions;
+    statsObject["packet_queue_overflows"] = _stats.packetQueueOverflows;
+
+    auto sendStats = DependencyManager::get<NodeList>()->sampleSendStats();
+    statsObject["send_datagrams_per_frame"] = (float)sendStats.datagrams / (float)_numStatFrames;
+    statsObject["send_syscalls_per_frame"] = (float)sendStats.syscalls / (float)_numStatFrames;
 
     // timing stats
     QJsonObject timingStats;
@@ -326,10 +333,13 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_shared_hrtf_renders"] = (int)(_stats.sharedHRTFRenders / (float)_numStatFrames);
+    mixStats["1_shared_hrtf_mixes"] = (int)(_stats.sharedHRTFMixes / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
+    mixStats["2_out_of_range_streams"] = (int)(_stats.outOfRange / (float)_numStatFrames);
 
     mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
     mixStats["3_skippped_to_inactive"] = (int)(_stats.skippedToInactive / (float)_numStatFrames);
@@ -337,6 +347,10 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_inactive_to_active"] = (int)(_stats.inactiveToActive / (float)_numStatFrames);
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
+    mixStats["3_skippped_to_out_of_range"] = (int)(_stats.skippedToOutOfRange / (float)_numStatFrames);
+    mixStats["3_inactive_to_out_of_range"] = (int)(_stats.inactiveToOutOfRange / (float)_numStatFrames);
+    mixStats["3_active_to_out_of_range"] = (int)(_stats.activeToOutOfRange / (float)_numStatFrames);
+    mixStats["3_out_of_range_to_active"] = (int)(_stats.outOfRangeToActive / (float)_numStatFrames);
 
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
@@ -461,6 +475,8 @@ void AudioMixer::start() {
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
+            _workerSharedData.spatialCache.prepareFrame(cbegin, cend, frame);
+            _workerSharedData.streamGrid.build(cbegin, cend);
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
 
@@ -571,6 +587,24 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString PIN_THREADS = "pin_threads";
+        bool pinThreads = audioThreadingGroupObject[PIN_THREADS].toBool();
+        const QString PIN_THREADS_FIRST_CORE = "pin_threads_first_core";
+        int firstCore = audioThreadingGroupObject[PIN_THREADS_FIRST_CORE].toString().toInt();
+        _slavePool.setPinThreads(pinThreads, firstCore);
+        if (pinThreads) {
+            qCDebug(audio) << "Pin Threads: enabled, starting at core" << firstCore;
+        } else {
+            qCDebug(audio) << "Pin Threads: disabled";
+        }
+
+        const QString INGRESS_THREADS = "ingress_threads";
+        bool ok;
+        int ingressThreads = audioThreadingGroupObject[INGRESS_THREADS].toString().toInt(&ok);
+        if (ok) {
+            DependencyManager::get<NodeList>()->setNumIngressShards(ingressThreads);
+        }
+
         const QString THROTTLE_START_KEY = "throttle_start";
         const QString THROTTLE_BACKOFF_KEY = "throttle_backoff";
 
@@ -588,6 +622,37 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        const QString SPATIAL_CACHE_TOLERANCE_KEY = "spatial_cache_tolerance";
+        const QString SPATIAL_CACHE_ANGLE_KEY = "spatial_cache_angle";
+        const float DEFAULT_SPATIAL_CACHE_ANGLE = 15.0f;
+
+        float spatialCacheTolerance = audioThreadingGroupObject[SPATIAL_CACHE_TOLERANCE_KEY].toDouble(0.0);
+        float spatialCacheAngle = audioThreadingGroupObject[SPATIAL_CACHE_ANGLE_KEY].toDouble(DEFAULT_SPATIAL_CACHE_ANGLE);
+        _workerSharedData.spatialCache.setTolerance(spatialCacheTolerance, spatialCacheAngle);
+
+        if (_workerSharedData.spatialCache.isEnabled()) {
+            qCDebug(audio) << "Shared spatial mixes for listeners within" << spatialCacheTolerance << "m and"
+                << spatialCacheAngle << "degrees";
+        }
+
+        const QString AUDIBLE_RANGE_KEY = "audible_range";
+        float audibleRange = audioThreadingGroupObject[AUDIBLE_RANGE_KEY].toDouble(0.0);
+        _workerSharedData.streamGrid.setAudibleRange(audibleRange);
+
+        if (_workerSharedData.streamGrid.isEnabled()) {
+            qCDebug(audio) << "Only mixing streams within" << _workerSharedData.streamGrid.getAudibleRange() << "m";
+        }
+
+        const QString BATCHED_RECEIVE_KEY = "batched_receive";
+        bool batchedReceive = audioThreadingGroupObject[BATCHED_RECEIVE_KEY].toBool();
+        DependencyManager::get<NodeList>()->setBatchedReceiveEnabled(batchedReceive);
+        qCDebug(audio) << "Batched Receive:" << (batchedReceive ? "enabled" : "disabled");
+
+        const QString BATCHED_SEND_KEY = "batched_send";
+        bool batchedSend = audioThreadingGroupObject[BATCHED_SEND_KEY].toBool();
+        DependencyManager::get<NodeList>()->setBatchedSendEnabled(batchedSend);
+        qCDebug(audio) << "Batched Send:" << (batchedSend ? "enabled" : "disabled");
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
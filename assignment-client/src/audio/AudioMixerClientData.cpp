@@ -50,21 +50,29 @@ AudioMixerClientData::~AudioMixerClientData() {
     }
 }
 
-void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (!_packetQueue.node) {
-        _packetQueue.node = node;
+void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message) {
+    switch (message->getType()) {
+        case PacketType::MicrophoneAudioNoEcho:
+        case PacketType::MicrophoneAudioWithEcho:
+        case PacketType::InjectAudio:
+        case PacketType::SilentAudioFrame:
+            // audio frames are sent unreliably, a full queue drops them and the drop is counted in the mixer stats
+            _packetQueue.push(std::move(message));
+            return;
+        default:
+            break;
     }
-    _packetQueue.push(message);
-}
-
-int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
 
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    // once a message overflows the ones after it wait behind it, so that they are processed in order
+    if (_hasPacketOverflow || !_packetQueue.push(std::move(message))) {
+        std::lock_guard<std::mutex> lock(_packetOverflowMutex);
+        _packetOverflow.push_back(std::move(message));
+        _hasPacketOverflow = true;
+    }
+}
 
+int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams, const SharedNodePointer& node) {
+    auto processPacket = [&](QSharedPointer<ReceivedMessage>& packet) {
         switch (packet->getType()) {
             case PacketType::MicrophoneAudioNoEcho:
             case PacketType::MicrophoneAudioWithEcho:
@@ -110,10 +118,25 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
             default:
                 Q_UNREACHABLE();
         }
+    };
+
+    QSharedPointer<ReceivedMessage> packet;
+    while (_packetQueue.pop(packet)) {
+        processPacket(packet);
+    }
 
-        _packetQueue.pop();
+    // the overflow only holds messages queued after the ones that were in the ring
+    if (_hasPacketOverflow) {
+        std::vector<QSharedPointer<ReceivedMessage>> overflow;
+        {
+            std::lock_guard<std::mutex> lock(_packetOverflowMutex);
+            overflow.swap(_packetOverflow);
+            _hasPacketOverflow = false;
+        }
+        for (auto& overflowPacket : overflow) {
+            processPacket(overflowPacket);
+        }
     }
-    assert(_packetQueue.empty());
 
     // now that we have processed all packets for this frame
     // we can prepare the sources from this client to be ready for mixing
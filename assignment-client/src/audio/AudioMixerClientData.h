@@ -12,7 +12,10 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
-#include <queue>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <tbb/concurrent_vector.h>
 
@@ -21,6 +24,7 @@
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
+#include <MPSCRing.h>
 #include <UUIDHasher.h>
 
 #include <plugins/Forward.h>
@@ -49,8 +53,13 @@ public:
     using SharedStreamPointer = std::shared_ptr<PositionalAudioStream>;
     using AudioStreamVector = std::vector<SharedStreamPointer>;
 
-    void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
-    int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
+    // thread-safe, packets over the queue capacity are dropped
+    void queuePacket(QSharedPointer<ReceivedMessage> packet); // thread-safe, drops audio frames over the queue capacity
+    // returns the number of available streams this frame
+    int processPackets(ConcurrentAddedStreams& addedStreams, const SharedNodePointer& node);
+
+    uint32_t samplePacketQueueContentions() { return _packetQueue.sampleNumContended(); }
+    uint32_t samplePacketQueueOverflows() { return _packetQueue.sampleNumOverflows(); }
 
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
     AvatarAudioStream* getAvatarAudioStream();
@@ -120,6 +129,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool usedSharedRender { false };
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -128,10 +138,14 @@ public:
     };
 
     using MixableStreamsVector = std::vector<MixableStream>;
+    using MixableStreamsMap = std::unordered_map<const PositionalAudioStream*, MixableStream>;
     struct Streams {
         MixableStreamsVector active;
         MixableStreamsVector inactive;
         MixableStreamsVector skipped;
+
+        // beyond audible range, not visited until the stream grid finds them in range again
+        MixableStreamsMap outOfRange;
     };
 
     Streams& getStreams() { return _streams; }
@@ -169,10 +183,15 @@ public slots:
     void sendSelectAudioFormat(SharedNodePointer node, const QString& selectedCodecName);
 
 private:
-    struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
-        QWeakPointer<Node> node;
-    };
+    // a client sends a handful of packets per frame, this leaves room for a few stalled frames
+    static const size_t PACKET_QUEUE_CAPACITY = 256;
+    using PacketQueue = MPSCRing<QSharedPointer<ReceivedMessage>, PACKET_QUEUE_CAPACITY>;
     PacketQueue _packetQueue;
+    // messages other than audio frames that did not fit in the packet queue, and everything after them
+    // until processPackets drains it
+    std::mutex _packetOverflowMutex;
+    std::vector<QSharedPointer<ReceivedMessage>> _packetOverflow;
+    std::atomic<bool> _hasPacketOverflow { false };
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
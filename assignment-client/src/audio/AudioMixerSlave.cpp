@@ -50,16 +50,19 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
 
 // mix helpers
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
-inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
+inline float computeGain(float masterAvatarGain, float masterInjectorGain, const glm::vec3& listenerPosition,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
-inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        const glm::vec3& relativePosition);
+inline float computeAzimuth(const glm::quat& listenerOrientation, const glm::vec3& relativePosition);
+inline float computeRepeatedFrameGain(const PositionalAudioStream& streamToAdd);
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
         // process packets and collect the number of streams available for this frame
-        stats.sumStreams += data->processPackets(_sharedData.addedStreams);
+        stats.sumStreams += data->processPackets(_sharedData.addedStreams, node);
+
+        stats.packetQueueContentions += data->samplePacketQueueContentions();
+        stats.packetQueueOverflows += data->samplePacketQueueOverflows();
     }
 }
 
@@ -239,14 +242,7 @@ bool shouldBeInactive(MixableStream& stream) {
             stream.positionalStream->getLastPopOutputLoudness() == 0.0f);
 };
 
-bool shouldBeSkipped(MixableStream& stream, const Node& listener,
-                     const AvatarAudioStream& listenerAudioStream,
-                     const AudioMixerClientData& listenerData) {
-
-    if (stream.nodeStreamID.nodeLocalID == listener.getLocalID()) {
-        return !stream.positionalStream->shouldLoopbackForNode();
-    }
-
+void updateIgnoreFlags(MixableStream& stream, const AudioMixerClientData& listenerData) {
     // grab the unprocessed ignores and unignores from and for this listener
     const auto& nodesIgnoredByListener = listenerData.getNewIgnoredNodeIDs();
     const auto& nodesUnignoredByListener = listenerData.getNewUnignoredNodeIDs();
@@ -266,6 +262,17 @@ bool shouldBeSkipped(MixableStream& stream, const Node& listener,
     } else {
         stream.ignoringListener = contains(nodesIgnoringListener, stream.nodeStreamID.nodeID);
     }
+}
+
+bool shouldBeSkipped(MixableStream& stream, const Node& listener,
+                     const AvatarAudioStream& listenerAudioStream,
+                     const AudioMixerClientData& listenerData) {
+
+    if (stream.nodeStreamID.nodeLocalID == listener.getLocalID()) {
+        return !stream.positionalStream->shouldLoopbackForNode();
+    }
+
+    updateIgnoreFlags(stream, listenerData);
 
     bool listenerIsAdmin = listenerData.getRequestsDomainListData() && listener.getCanKick();
     if (stream.ignoredByListener || (stream.ignoringListener && !listenerIsAdmin)) {
@@ -306,6 +313,71 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
 };
 
+// streams are let go a little past the audible range, so that one hovering at the edge doesn't flip every frame
+const float OUT_OF_RANGE_HYSTERESIS = 1.1f;
+
+bool isOutOfRange(const MixableStream& stream, const AvatarAudioStream& listenerAudioStream, float range) {
+    if (stream.positionalStream == &listenerAudioStream) {
+        return false;
+    }
+
+    float maxDistance = range * OUT_OF_RANGE_HYSTERESIS;
+    return glm::distance2(stream.positionalStream->getPosition(), listenerAudioStream.getPosition()) >
+        maxDistance * maxDistance;
+};
+
+void AudioMixerSlave::updateOutOfRangeStreams(AudioMixerClientData& listenerData,
+                                              const AvatarAudioStream& listenerAudioStream,
+                                              bool isRangeLimited) {
+    auto& streams = listenerData.getStreams();
+    auto& outOfRange = streams.outOfRange;
+
+    // removed streams are dropped first, their address may already belong to a new stream
+    if (!outOfRange.empty() && (!_sharedData.removedNodes.empty() || !_sharedData.removedStreams.empty())) {
+        for (auto it = outOfRange.begin(); it != outOfRange.end();) {
+            if (shouldBeRemoved(it->second, _sharedData)) {
+                it = outOfRange.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (outOfRange.empty()) {
+        return;
+    }
+
+    // ignore changes are only staged for this frame, parked streams must not miss them
+    bool hasIgnoreChanges = !listenerData.getNewIgnoredNodeIDs().empty() ||
+        !listenerData.getNewUnignoredNodeIDs().empty() ||
+        !listenerData.getNewIgnoringNodeIDs().empty() ||
+        !listenerData.getNewUnignoringNodeIDs().empty();
+    if (hasIgnoreChanges) {
+        for (auto& pair : outOfRange) {
+            updateIgnoreFlags(pair.second, listenerData);
+        }
+    }
+
+    if (!isRangeLimited) {
+        // everything is a candidate again, let the regular passes sort them out
+        for (auto& pair : outOfRange) {
+            streams.active.push_back(move(pair.second));
+        }
+        outOfRange.clear();
+        return;
+    }
+
+    // only look at what the grid says is in range
+    _sharedData.streamGrid.forEachStreamInRange(listenerAudioStream.getPosition(), [&](PositionalAudioStream* stream) {
+        auto it = outOfRange.find(stream);
+        if (it != outOfRange.end()) {
+            streams.active.push_back(move(it->second));
+            outOfRange.erase(it);
+            ++stats.outOfRangeToActive;
+        }
+    });
+}
+
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
@@ -316,16 +388,39 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     bool isThrottling = _numToRetain != -1;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
 
+    // share spatialized renders with the listeners around us, if clustering is enabled
+    _cluster = _sharedData.spatialCache.getCluster(listener->getLocalID());
+
     auto& streams = listenerData->getStreams();
 
     addStreams(*listener, *listenerData);
 
+    // with an audible range, far away streams are parked and only the grid's candidates are considered
+    // (a soloing listener hears its soloed nodes from anywhere)
+    bool isRangeLimited = _sharedData.streamGrid.isEnabled() && !isSoloing;
+    float audibleRange = _sharedData.streamGrid.getAudibleRange();
+    updateOutOfRangeStreams(*listenerData, *listenerAudioStream, isRangeLimited);
+
+    auto parkIfOutOfRange = [&](MixableStream& stream) {
+        if (isRangeLimited && isOutOfRange(stream, *listenerAudioStream, audibleRange)) {
+            const PositionalAudioStream* key = stream.positionalStream;
+            streams.outOfRange.emplace(key, move(stream));
+            return true;
+        }
+        return false;
+    };
+
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
             return true;
         }
 
+        if (parkIfOutOfRange(stream)) {
+            ++stats.skippedToOutOfRange;
+            return true;
+        }
+
         if (!shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
             if (shouldBeInactive(stream)) {
                 streams.inactive.push_back(move(stream));
@@ -350,6 +445,11 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (parkIfOutOfRange(stream)) {
+            ++stats.inactiveToOutOfRange;
+            return true;
+        }
+
         if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
             streams.skipped.push_back(move(stream));
             ++stats.inactiveToSkipped;
@@ -375,6 +475,13 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (parkIfOutOfRange(stream)) {
+            // flush the tail now, the HRTF will start over if the stream comes back in range
+            resetHRTFState(stream);
+            ++stats.activeToOutOfRange;
+            return true;
+        }
+
         if (isThrottling) {
             // we're throttling, so we need to update the approximate volume for any un-skipped streams
             // unless this is simply for an echo (in which case the approx volume is 1.0)
@@ -463,6 +570,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
+    stats.outOfRange += (int)streams.outOfRange.size();
 
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
@@ -504,34 +612,34 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
+
+    // far enough sources of a clustered listener are spatialized once for the whole cluster
+    if (_cluster && !isEcho && !isSoloing && !streamToAdd->isStereo() &&
+        distance > _sharedData.spatialCache.getNearFieldDistance()) {
+        addSharedStream(mixableStream, masterAvatarGain, masterInjectorGain);
+        return;
+    }
+
+    if (mixableStream.usedSharedRender) {
+        // our own HRTF has not been running, don't let it pick up from a stale state
+        resetHRTFState(mixableStream);
+        mixableStream.usedSharedRender = false;
+    }
+
     float gain = isEcho ? 1.0f
                         : (isSoloing ? masterAvatarGain
-                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd,
-                                                   relativePosition, distance));
-    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(),
+                                                   *streamToAdd, relativePosition, distance));
+    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream.getOrientation(), relativePosition);
 
     const int HRTF_DATASET_INDEX = 1;
 
     if (!streamToAdd->lastPopSucceeded()) {
-        bool forceSilentBlock = true;
-
-        if (!streamToAdd->getLastPopOutput().isNull()) {
-            bool isInjector = dynamic_cast<const InjectedAudioStream*>(streamToAdd);
-
-            // in an injector, just go silent - the injector has likely ended
-            // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
-            if (!isInjector) {
-                // calculate its fade factor, which depends on how many times it's already been repeated.
-                float fadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd->getConsecutiveNotMixedCount() - 1);
-                if (fadeFactor > 0.0f) {
-                    // apply the fadeFactor to the gain
-                    gain *= fadeFactor;
-                    forceSilentBlock = false;
-                }
-            }
-        }
+        float repeatedFrameGain = computeRepeatedFrameGain(*streamToAdd);
 
-        if (forceSilentBlock) {
+        if (repeatedFrameGain > 0.0f) {
+            gain *= repeatedFrameGain;
+        } else {
             // call renderSilent with a forced silent block to reduce artifacts
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
@@ -575,6 +683,60 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     }
 }
 
+void AudioMixerSlave::addSharedStream(AudioMixerClientData::MixableStream& mixableStream,
+                                      float masterAvatarGain,
+                                      float masterInjectorGain) {
+    auto streamToAdd = mixableStream.positionalStream;
+    auto& cluster = *_cluster;
+
+    const float* sharedSamples = cluster.getRender(mixableStream.nodeStreamID, streamToAdd, _frame,
+                                                   [&](AudioHRTF& hrtf, float* output) {
+        glm::vec3 relativePosition = streamToAdd->getPosition() - cluster.position;
+        float distance = glm::max(glm::length(relativePosition), EPSILON);
+
+        // render at unity master gain, each listener applies its own
+        float gain = computeGain(1.0f, 1.0f, cluster.position, *streamToAdd, relativePosition, distance);
+        float azimuth = computeAzimuth(cluster.orientation, relativePosition);
+
+        const int HRTF_DATASET_INDEX = 1;
+
+        if (!streamToAdd->lastPopSucceeded()) {
+            float repeatedFrameGain = computeRepeatedFrameGain(*streamToAdd);
+
+            if (repeatedFrameGain > 0.0f) {
+                gain *= repeatedFrameGain;
+            } else {
+                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+                hrtf.render(silentMonoBlock, output, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                            AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+                ++stats.sharedHRTFRenders;
+                return;
+            }
+        }
+
+        streamToAdd->getLastPopOutput().readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        hrtf.render(_bufferSamples, output, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        ++stats.sharedHRTFRenders;
+    });
+
+    float gain = (streamToAdd->getType() == PositionalAudioStream::Injector) ? masterInjectorGain : masterAvatarGain;
+
+    // the per-source gain set by this listener lives on its own HRTF
+    gain *= mixableStream.hrtf->getGainAdjustment();
+
+    if (gain > 0.0f) {
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+            _mixSamples[i] += gain * sharedSamples[i];
+        }
+    }
+
+    mixableStream.usedSharedRender = true;
+    ++stats.sharedHRTFMixes;
+}
+
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                                            AvatarAudioStream& listeningNodeStream,
                                            float masterAvatarGain,
@@ -587,9 +749,9 @@ void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream&
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
-    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd, 
-                                             relativePosition, distance);
-    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(),
+                                             *streamToAdd, relativePosition, distance);
+    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream.getOrientation(), relativePosition);
 
     mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
 
@@ -728,7 +890,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
 
 float computeGain(float masterAvatarGain,
                   float masterInjectorGain,
-                  const AvatarAudioStream& listeningNodeStream,
+                  const glm::vec3& listenerPosition,
                   const PositionalAudioStream& streamToAdd,
                   const glm::vec3& relativePosition,
                   float distance) {
@@ -765,7 +927,7 @@ float computeGain(float masterAvatarGain,
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
         if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+            audioZones[settings.listener].area.contains(listenerPosition)) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
         }
@@ -797,10 +959,8 @@ float computeGain(float masterAvatarGain,
     return gain;
 }
 
-float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
-                     const PositionalAudioStream& streamToAdd,
-                     const glm::vec3& relativePosition) {
-    glm::quat inverseOrientation = glm::inverse(listeningNodeStream.getOrientation());
+float computeAzimuth(const glm::quat& listenerOrientation, const glm::vec3& relativePosition) {
+    glm::quat inverseOrientation = glm::inverse(listenerOrientation);
 
     glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
 
@@ -822,3 +982,14 @@ float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
         return 0.0f; 
     }
 }
+
+float computeRepeatedFrameGain(const PositionalAudioStream& streamToAdd) {
+    // in an injector, just go silent - the injector has likely ended
+    // in other inputs (microphone, &c.), repeat with fade to avoid the harsh jump to silence
+    if (streamToAdd.getLastPopOutput().isNull() || dynamic_cast<const InjectedAudioStream*>(&streamToAdd)) {
+        return 0.0f;
+    }
+
+    // calculate its fade factor, which depends on how many times it's already been repeated.
+    return calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
+}
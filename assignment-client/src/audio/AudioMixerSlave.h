@@ -23,7 +23,9 @@
 #include <PositionalAudioStream.h>
 
 #include "AudioMixerClientData.h"
+#include "AudioMixerSpatialCache.h"
 #include "AudioMixerStats.h"
+#include "AudioMixerStreamGrid.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
@@ -36,6 +38,8 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerSpatialCache spatialCache;
+        AudioMixerStreamGrid streamGrid;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -60,6 +64,9 @@ private:
                    float masterAvatarGain,
                    float masterInjectorGain,
                    bool isSoloing);
+    void addSharedStream(AudioMixerClientData::MixableStream& mixableStream,
+                         float masterAvatarGain,
+                         float masterInjectorGain);
     void updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                               AvatarAudioStream& listeningNodeStream,
                               float masterAvatarGain,
@@ -67,6 +74,8 @@ private:
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
+    void updateOutOfRangeStreams(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerAudioStream,
+                                 bool isRangeLimited);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
@@ -78,6 +87,9 @@ private:
     unsigned int _frame { 0 };
     int _numToRetain { -1 };
 
+    // listener state
+    AudioMixerSpatialCache::Cluster* _cluster { nullptr };
+
     SharedData& _sharedData;
 };
 
@@ -13,17 +13,31 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <limits>
+
+#include <PortableHighResolutionClock.h>
+#include <SharedUtil.h>
 
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
+        // coalesce what this slave sends while it works through its nodes
+        auto nodeList = DependencyManager::get<NodeList>();
+        nodeList->beginSendBatch();
+
+        // iterate over all available nodes, timing each one to balance the next frame
+        size_t task;
         SharedNodePointer node;
-        while (try_pop(node)) {
+        while (try_pop(task, node)) {
+            auto start = p_high_resolution_clock::now();
             (this->*_function)(node);
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start);
+            setCost(task, (uint32_t)std::min<int64_t>(elapsed.count(), std::numeric_limits<uint32_t>::max()));
         }
 
+        nodeList->flushSendBatch();
+
         bool stopping = _stop;
         notify(stopping);
         if (stopping) {
@@ -33,6 +47,7 @@ void AudioMixerSlaveThread::run() {
 }
 
 void AudioMixerSlaveThread::wait() {
+    int core;
     {
         Lock lock(_pool._mutex);
         _pool._slaveCondition.wait(lock, [&] {
@@ -40,6 +55,15 @@ void AudioMixerSlaveThread::wait() {
             return _pool._numStarted != _pool._numThreads;
         });
         ++_pool._numStarted;
+        int numCores = std::max(QThread::idealThreadCount(), 1);
+        core = _pool._pinThreads ? (std::max(_pool._pinFirstCore, 0) + _index) % numCores : -1;
+    }
+
+    if (core != _pinnedCore) {
+        _pinnedCore = core;
+        if (!setCurrentThreadCore(core)) {
+            qWarning("%s: could not %s slave %d", __FUNCTION__, core >= 0 ? "pin" : "unpin", _index);
+        }
     }
 
     if (_pool._configure) {
@@ -60,14 +84,22 @@ void AudioMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+bool AudioMixerSlaveThread::try_pop(size_t& task, SharedNodePointer& node) {
+    if (_pool._scheduler.next(_index, task)) {
+        node = *(_pool._begin + task);
+        return true;
+    }
+    return false;
+}
+
+void AudioMixerSlaveThread::setCost(size_t task, uint32_t cost) {
+    _pool._costs[task] = cost;
 }
 
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    run(begin, end, _processPacketsCosts);
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
@@ -76,17 +108,37 @@ void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame
         slave.configureMix(_begin, _end, frame, numToRetain);
     };
 
-    run(begin, end);
+    run(begin, end, _mixCosts);
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, TaskCosts& taskCosts) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // estimate each node from what it cost last frame, new nodes are assumed to be average
+    size_t numNodes = std::distance(_begin, _end);
+    _costs.assign(numNodes, 0);
+
+    uint64_t knownCost = 0;
+    size_t numKnown = 0;
+    for (size_t i = 0; i < numNodes; ++i) {
+        auto cost = taskCosts.find((*(_begin + i))->getLocalID());
+        if (cost != taskCosts.end()) {
+            _costs[i] = cost->second;
+            knownCost += cost->second;
+            ++numKnown;
+        }
+    }
+
+    uint32_t averageCost = numKnown > 0 ? (uint32_t)(knownCost / numKnown) : 1;
+    for (auto& cost : _costs) {
+        if (cost == 0) {
+            cost = averageCost;
+        }
+    }
+
+    // split the nodes between the slaves
+    _scheduler.prepare(_costs);
 
     {
         Lock lock(_mutex);
@@ -104,7 +156,11 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    // keep what each node cost for the next frame, this also forgets nodes that are gone
+    taskCosts.clear();
+    for (size_t i = 0; i < numNodes; ++i) {
+        taskCosts[(*(_begin + i))->getLocalID()] = _costs[i];
+    }
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -156,7 +212,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
+            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData, (int)_slaves.size());
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -196,4 +252,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
 
     _numThreads = _numStarted = _numFinished = numThreads;
     assert(_numThreads == (int)_slaves.size());
+
+    // the slaves are all idle, so the scheduler can be resized under them
+    _scheduler.setNumWorkers(_numThreads);
 }
@@ -14,11 +14,12 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <QThread>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
+#include <WorkStealingScheduler.h>
 
 #include "AudioMixerSlave.h"
 
@@ -31,8 +32,8 @@ class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData)
-        : AudioMixerSlave(sharedData), _pool(pool) {}
+    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData, int index)
+        : AudioMixerSlave(sharedData), _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -41,17 +42,20 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
+    bool try_pop(size_t& task, SharedNodePointer& node);
+    void setCost(size_t task, uint32_t cost);
 
     AudioMixerSlavePool& _pool;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
+    const int _index;
+    int _pinnedCore { -1 };
     bool _stop { false };
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
+    using TaskCosts = std::unordered_map<Node::LocalID, uint32_t>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -79,15 +83,23 @@ public:
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
+    // pin each slave thread to its own core, slave N to core firstCore + N, wrapping around
+    // off by default, when both mixers run on one machine give them first cores that keep them apart
+    void setPinThreads(bool pinThreads, int firstCore = 0) { _pinThreads = pinThreads; _pinFirstCore = firstCore; }
+
+    // number of times a slave ran out of nodes and took some from another slave, since last sampled
+    uint32_t sampleNumSteals() { return _scheduler.sampleNumSteals(); }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, TaskCosts& taskCosts);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
 
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AudioMixerSlaveThread::try_pop(size_t& task, SharedNodePointer& node);
+    friend void AudioMixerSlaveThread::setCost(size_t task, uint32_t cost);
 
     // synchronization state
     Mutex _mutex;
@@ -99,12 +111,19 @@ private:
     int _numStarted { 0 }; // guarded by _mutex
     int _numFinished { 0 }; // guarded by _mutex
     int _numStopped { 0 }; // guarded by _mutex
+    bool _pinThreads { false };
+    int _pinFirstCore { 0 };
 
     // frame state
-    Queue _queue;
+    WorkStealingScheduler _scheduler;
+    WorkStealingScheduler::Costs _costs; // estimated from the last frame, then measured (in ns) by the slaves
     ConstIter _begin;
     ConstIter _end;
 
+    // per node cost of each job in the last frame
+    TaskCosts _processPacketsCosts;
+    TaskCosts _mixCosts;
+
     AudioMixerSlave::SharedData& _workerSharedData;
 };
 
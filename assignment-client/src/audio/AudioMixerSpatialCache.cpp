@@ -0,0 +1,122 @@
+//
+//  AudioMixerSpatialCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-06-14.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerSpatialCache.h"
+
+#include <algorithm>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+
+#include "AudioMixerClientData.h"
+#include "AvatarAudioStream.h"
+
+void AudioMixerSpatialCache::setTolerance(float positionTolerance, float angleTolerance) {
+    const float MIN_POSITION_TOLERANCE = 0.1f;    // meters
+    const float MIN_ANGLE_TOLERANCE = 1.0f;       // degrees
+    const float MAX_ANGLE_TOLERANCE = 90.0f;
+
+    if (positionTolerance <= 0.0f) {
+        _positionTolerance = 0.0f;
+    } else {
+        _positionTolerance = std::max(positionTolerance, MIN_POSITION_TOLERANCE);
+    }
+    _angleTolerance = glm::radians(glm::clamp(angleTolerance, MIN_ANGLE_TOLERANCE, MAX_ANGLE_TOLERANCE));
+
+    // a listener can be up to half a cell diagonal from its cluster position,
+    // so only share renders of sources far enough away for that to stay within the angle tolerance
+    float maxPositionError = 0.5f * SQUARE_ROOT_OF_3 * _positionTolerance;
+    _nearFieldDistance = std::max(2.0f * _positionTolerance, maxPositionError / _angleTolerance);
+
+    // start over with the new clustering
+    _clusters.clear();
+    _listenerClusters.clear();
+}
+
+AudioMixerSpatialCache::ClusterKey AudioMixerSpatialCache::computeKey(const glm::vec3& position,
+                                                                      const glm::quat& orientation) const {
+    glm::vec3 cell = glm::floor(position / _positionTolerance);
+
+    // yaw of the forward direction, about the y-axis
+    glm::vec3 forward = orientation * Vectors::FRONT;
+    float yaw = atan2f(-forward.x, -forward.z);
+
+    return { (int32_t)cell.x, (int32_t)cell.y, (int32_t)cell.z, (int32_t)floorf(yaw / _angleTolerance) };
+}
+
+void AudioMixerSpatialCache::prepareFrame(ConstIter begin, ConstIter end, unsigned int frame) {
+    _listenerClusters.clear();
+
+    if (!isEnabled()) {
+        _clusters.clear();
+        return;
+    }
+
+    // quantize each listener
+    _listenerKeys.clear();
+    _clusterSizes.clear();
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!data || node->isUpstream() || node->getType() != NodeType::Agent) {
+            return;
+        }
+
+        auto stream = data->getAvatarAudioStream();
+        if (!stream) {
+            return;
+        }
+
+        ClusterKey key = computeKey(stream->getPosition(), stream->getOrientation());
+        _listenerKeys.emplace_back(node->getLocalID(), key);
+        ++_clusterSizes[key];
+    });
+
+    // listeners alone in their cell keep mixing on their own, exactly
+    for (const auto& listenerKey : _listenerKeys) {
+        const ClusterKey& key = listenerKey.second;
+        if (_clusterSizes[key] < 2) {
+            continue;
+        }
+
+        auto& cluster = _clusters[key];
+        if (!cluster) {
+            cluster.reset(new Cluster);
+            cluster->position = (glm::vec3(key.x, key.y, key.z) + 0.5f) * _positionTolerance;
+            cluster->orientation = glm::angleAxis((key.yaw + 0.5f) * _angleTolerance, Vectors::UP);
+        }
+        cluster->frame = frame;
+
+        _listenerClusters[listenerKey.first] = cluster.get();
+    }
+
+    // drop clusters that broke up, and renders that were not needed last frame
+    for (auto it = _clusters.begin(); it != _clusters.end();) {
+        if (it->second->frame != frame) {
+            it = _clusters.erase(it);
+            continue;
+        }
+
+        auto& renders = it->second->_renders;
+        for (auto renderIt = renders.begin(); renderIt != renders.end();) {
+            if (renderIt->second->frame + 1 < frame) {
+                renderIt = renders.erase(renderIt);
+            } else {
+                ++renderIt;
+            }
+        }
+        ++it;
+    }
+}
+
+AudioMixerSpatialCache::Cluster* AudioMixerSpatialCache::getCluster(Node::LocalID listenerID) const {
+    auto it = _listenerClusters.find(listenerID);
+    return it != _listenerClusters.end() ? it->second : nullptr;
+}
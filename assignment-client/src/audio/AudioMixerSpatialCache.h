@@ -0,0 +1,146 @@
+//
+//  AudioMixerSpatialCache.h
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-06-14.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerSpatialCache_h
+#define hifi_AudioMixerSpatialCache_h
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <NodeList.h>
+#include <PositionalAudioStream.h>
+
+// Shares HRTF renders between listeners that stand close together and face the same way.
+//
+// Once per frame (before mixing) listeners are quantized by position and yaw into clusters.
+// Within a cluster of two or more listeners, a source is spatialized once, relative to the cluster,
+// and every member adds that render scaled by its own master gain instead of running its own HRTF.
+class AudioMixerSpatialCache {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Render {
+        std::mutex mutex;
+        Node::LocalID nodeLocalID { 0 };
+        StreamID streamID;
+        unsigned int frame { 0 };
+        AudioHRTF hrtf;
+        float samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    };
+
+    struct Cluster {
+        glm::vec3 position;
+        glm::quat orientation;
+        unsigned int frame { 0 };
+
+        // returns the samples of this source rendered for the cluster this frame;
+        // the first caller renders them with render(AudioHRTF&, float* output), the others wait and reuse them
+        template <typename F>
+        const float* getRender(const NodeIDStreamID& nodeStreamID, const PositionalAudioStream* stream,
+                               unsigned int currentFrame, F&& render);
+
+    private:
+        friend class AudioMixerSpatialCache;
+
+        std::mutex _rendersMutex;
+        std::unordered_map<const PositionalAudioStream*, std::unique_ptr<Render>> _renders;
+    };
+
+    // a position tolerance of 0 disables the cache
+    void setTolerance(float positionTolerance, float angleTolerance);
+    bool isEnabled() const { return _positionTolerance > 0.0f; }
+
+    // sources closer than this to a listener are rendered by that listener, where the cluster error would be audible
+    float getNearFieldDistance() const { return _nearFieldDistance; }
+
+    // cluster listeners for this frame, not thread-safe (call before mixing)
+    void prepareFrame(ConstIter begin, ConstIter end, unsigned int frame);
+
+    // thread-safe during mixing, returns nullptr if the listener is not sharing renders this frame
+    Cluster* getCluster(Node::LocalID listenerID) const;
+
+private:
+    struct ClusterKey {
+        int32_t x;
+        int32_t y;
+        int32_t z;
+        int32_t yaw;
+
+        bool operator==(const ClusterKey& other) const {
+            return x == other.x && y == other.y && z == other.z && yaw == other.yaw;
+        }
+    };
+
+    struct ClusterKeyHasher {
+        size_t operator()(const ClusterKey& key) const {
+            size_t hash = std::hash<int32_t>()(key.x);
+            hash = hash * 31 + std::hash<int32_t>()(key.y);
+            hash = hash * 31 + std::hash<int32_t>()(key.z);
+            return hash * 31 + std::hash<int32_t>()(key.yaw);
+        }
+    };
+
+    ClusterKey computeKey(const glm::vec3& position, const glm::quat& orientation) const;
+
+    float _positionTolerance { 0.0f };
+    float _angleTolerance { 0.0f };
+    float _nearFieldDistance { 0.0f };
+
+    std::unordered_map<ClusterKey, std::unique_ptr<Cluster>, ClusterKeyHasher> _clusters;
+    std::unordered_map<Node::LocalID, Cluster*> _listenerClusters;
+
+    // per frame scratch, kept to avoid reallocating
+    std::vector<std::pair<Node::LocalID, ClusterKey>> _listenerKeys;
+    std::unordered_map<ClusterKey, int, ClusterKeyHasher> _clusterSizes;
+};
+
+template <typename F>
+const float* AudioMixerSpatialCache::Cluster::getRender(const NodeIDStreamID& nodeStreamID,
+                                                        const PositionalAudioStream* stream,
+                                                        unsigned int currentFrame, F&& render) {
+    Render* cachedRender;
+    {
+        std::lock_guard<std::mutex> lock(_rendersMutex);
+        auto& entry = _renders[stream];
+        if (!entry) {
+            entry.reset(new Render);
+        }
+        cachedRender = entry.get();
+    }
+
+    std::lock_guard<std::mutex> lock(cachedRender->mutex);
+    if (cachedRender->frame != currentFrame) {
+        bool isSameStream = cachedRender->nodeLocalID == nodeStreamID.nodeLocalID &&
+            cachedRender->streamID == nodeStreamID.streamID;
+
+        if (!isSameStream || cachedRender->frame + 1 != currentFrame) {
+            // the filter history is only valid for a source rendered continuously
+            cachedRender->hrtf.reset();
+            cachedRender->nodeLocalID = nodeStreamID.nodeLocalID;
+            cachedRender->streamID = nodeStreamID.streamID;
+        }
+
+        memset(cachedRender->samples, 0, sizeof(cachedRender->samples));
+        render(cachedRender->hrtf, cachedRender->samples);
+        cachedRender->frame = currentFrame;
+    }
+
+    return cachedRender->samples;
+}
+
+#endif // hifi_AudioMixerSpatialCache_h
@@ -16,12 +16,18 @@ void AudioMixerStats::reset() {
     sumListeners = 0;
     sumListenersSilent = 0;
 
+    packetQueueContentions = 0;
+    packetQueueOverflows = 0;
+
     totalMixes = 0;
 
     hrtfRenders = 0;
     hrtfResets = 0;
     hrtfUpdates = 0;
 
+    sharedHRTFRenders = 0;
+    sharedHRTFMixes = 0;
+
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
@@ -31,10 +37,15 @@ void AudioMixerStats::reset() {
     inactiveToActive = 0;
     activeToSkipped = 0;
     activeToInactive = 0;
+    skippedToOutOfRange = 0;
+    inactiveToOutOfRange = 0;
+    activeToOutOfRange = 0;
+    outOfRangeToActive = 0;
 
     skipped = 0;
     inactive = 0;
     active = 0;
+    outOfRange = 0;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
@@ -46,12 +57,18 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
 
+    packetQueueContentions += otherStats.packetQueueContentions;
+    packetQueueOverflows += otherStats.packetQueueOverflows;
+
     totalMixes += otherStats.totalMixes;
 
     hrtfRenders += otherStats.hrtfRenders;
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
 
+    sharedHRTFRenders += otherStats.sharedHRTFRenders;
+    sharedHRTFMixes += otherStats.sharedHRTFMixes;
+
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
@@ -61,10 +78,15 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactiveToActive += otherStats.inactiveToActive;
     activeToSkipped += otherStats.activeToSkipped;
     activeToInactive += otherStats.activeToInactive;
+    skippedToOutOfRange += otherStats.skippedToOutOfRange;
+    inactiveToOutOfRange += otherStats.inactiveToOutOfRange;
+    activeToOutOfRange += otherStats.activeToOutOfRange;
+    outOfRangeToActive += otherStats.outOfRangeToActive;
 
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
     active += otherStats.active;
+    outOfRange += otherStats.outOfRange;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
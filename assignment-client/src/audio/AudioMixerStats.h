@@ -21,12 +21,18 @@ struct AudioMixerStats {
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
 
+    int packetQueueContentions { 0 };
+    int packetQueueOverflows { 0 };
+
     int totalMixes { 0 };
 
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
 
+    int sharedHRTFRenders { 0 };
+    int sharedHRTFMixes { 0 };
+
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
@@ -36,10 +42,15 @@ struct AudioMixerStats {
     int inactiveToActive { 0 };
     int activeToSkipped { 0 };
     int activeToInactive { 0 };
+    int skippedToOutOfRange { 0 };
+    int inactiveToOutOfRange { 0 };
+    int activeToOutOfRange { 0 };
+    int outOfRangeToActive { 0 };
 
     int skipped { 0 };
     int inactive { 0 };
     int active { 0 };
+    int outOfRange { 0 };
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
@@ -0,0 +1,61 @@
+//
+//  AudioMixerStreamGrid.cpp
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-06-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerStreamGrid.h"
+
+#include <algorithm>
+
+#include "AudioMixerClientData.h"
+
+void AudioMixerStreamGrid::setAudibleRange(float range) {
+    const float MIN_AUDIBLE_RANGE = 1.0f;    // meters
+
+    _range = (range > 0.0f) ? std::max(range, MIN_AUDIBLE_RANGE) : 0.0f;
+    _cells.clear();
+}
+
+AudioMixerStreamGrid::CellKey AudioMixerStreamGrid::cellFor(const glm::vec3& position) const {
+    glm::vec3 cell = glm::floor(position / _range);
+    return { (int32_t)cell.x, (int32_t)cell.y, (int32_t)cell.z };
+}
+
+void AudioMixerStreamGrid::build(ConstIter begin, ConstIter end) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    for (auto& cell : _cells) {
+        cell.second.clear();
+    }
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        for (auto& stream : nodeData->getAudioStreams()) {
+            _cells[cellFor(stream->getPosition())].push_back(stream.get());
+        }
+    });
+
+    // once there are many cells, drop the empty ones so a roaming crowd doesn't leave a trail behind
+    const size_t MAX_CELLS = 1024;
+    if (_cells.size() > MAX_CELLS) {
+        for (auto it = _cells.begin(); it != _cells.end();) {
+            if (it->second.empty()) {
+                it = _cells.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
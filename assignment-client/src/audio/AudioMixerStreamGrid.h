@@ -0,0 +1,91 @@
+//
+//  AudioMixerStreamGrid.h
+//  assignment-client/src/audio
+//
+//  Created by High Fidelity on 2019-06-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerStreamGrid_h
+#define hifi_AudioMixerStreamGrid_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <NodeList.h>
+#include <PositionalAudioStream.h>
+
+// Uniform grid of every positional stream, rebuilt once per frame before mixing and then only read
+// (concurrently) by the slaves, so that a listener can find the streams within audible range
+// without looking at all of them. The cell size is the audible range, so a query visits 27 cells.
+class AudioMixerStreamGrid {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    // an audible range of 0 disables the grid, every stream is always a candidate
+    void setAudibleRange(float range);
+    float getAudibleRange() const { return _range; }
+    bool isEnabled() const { return _range > 0.0f; }
+
+    // not thread-safe (call before mixing)
+    void build(ConstIter begin, ConstIter end);
+
+    // calls f(PositionalAudioStream*) for every stream within the audible range of position
+    template <typename F>
+    void forEachStreamInRange(const glm::vec3& position, F&& f) const;
+
+private:
+    struct CellKey {
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        bool operator==(const CellKey& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+
+    struct CellKeyHasher {
+        size_t operator()(const CellKey& key) const {
+            size_t hash = std::hash<int32_t>()(key.x);
+            hash = hash * 31 + std::hash<int32_t>()(key.y);
+            return hash * 31 + std::hash<int32_t>()(key.z);
+        }
+    };
+
+    CellKey cellFor(const glm::vec3& position) const;
+
+    float _range { 0.0f };
+
+    // cells are cleared, not erased, between frames to keep their storage
+    std::unordered_map<CellKey, std::vector<PositionalAudioStream*>, CellKeyHasher> _cells;
+};
+
+template <typename F>
+void AudioMixerStreamGrid::forEachStreamInRange(const glm::vec3& position, F&& f) const {
+    CellKey center = cellFor(position);
+    float range2 = _range * _range;
+
+    for (int32_t x = center.x - 1; x <= center.x + 1; ++x) {
+        for (int32_t y = center.y - 1; y <= center.y + 1; ++y) {
+            for (int32_t z = center.z - 1; z <= center.z + 1; ++z) {
+                auto it = _cells.find({ x, y, z });
+                if (it == _cells.end()) {
+                    continue;
+                }
+
+                for (auto stream : it->second) {
+                    if (glm::distance2(stream->getPosition(), position) <= range2) {
+                        f(stream);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif // hifi_AudioMixerStreamGrid_h
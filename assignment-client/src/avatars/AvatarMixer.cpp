@@ -81,6 +81,7 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::RequestsDomainListData, this, "handleRequestsDomainListDataPacket");
     packetReceiver.registerListener(PacketType::SetAvatarTraits, this, "queueIncomingPacket");
     packetReceiver.registerListener(PacketType::BulkAvatarTraitsAck, this, "queueIncomingPacket");
+    packetReceiver.registerListener(PacketType::BulkAvatarDataAck, this, "queueIncomingPacket");
     packetReceiver.registerListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
         this, "handleOctreePacket");
     packetReceiver.registerListener(PacketType::ChallengeOwnership, this, "queueIncomingPacket");
@@ -162,7 +163,7 @@ void AvatarMixer::handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessag
 
         // queue up the replicated avatar data with the client data for the replicated node
         auto start = usecTimestampNow();
-        getOrCreateClientData(replicatedNode)->queuePacket(replicatedMessage, replicatedNode);
+        getOrCreateClientData(replicatedNode)->queuePacket(replicatedMessage);
         auto end = usecTimestampNow();
         _queueIncomingPacketElapsedTime += (end - start);
     }
@@ -205,7 +206,7 @@ void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node
 
 void AvatarMixer::queueIncomingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
     auto start = usecTimestampNow();
-    getOrCreateClientData(node)->queuePacket(message, node);
+    getOrCreateClientData(node)->queuePacket(message);
     auto end = usecTimestampNow();
     _queueIncomingPacketElapsedTime += (end - start);
 }
@@ -333,6 +334,7 @@ void AvatarMixer::start() {
             _broadcastAvatarDataNodeTransform += nodeTransform;
             _broadcastAvatarDataNodeFunctor += functor;
         }
+        ++_numStatFrames;
 
         ++frame;
         ++_numTightLoopFrames;
@@ -771,6 +773,14 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["average_listeners_last_second"] = TIGHT_LOOP_STAT(_sumListeners);
 
+    // the sends happen in the broadcasts, so these are per broadcast frame whatever the loop does
+    auto sendStats = DependencyManager::get<NodeList>()->sampleSendStats();
+    statsObject["send_datagrams_per_frame"] = _numStatFrames ? (float)sendStats.datagrams / (float)_numStatFrames : 0.0f;
+    statsObject["send_syscalls_per_frame"] = _numStatFrames ? (float)sendStats.syscalls / (float)_numStatFrames : 0.0f;
+
+    int threadSteals = (int)_slavePool.sampleNumSteals();
+    statsObject["thread_steals_per_frame"] = TIGHT_LOOP_STAT(threadSteals);
+
     QJsonObject singleCoreTasks;
     singleCoreTasks["processEvents"] = TIGHT_LOOP_STAT_UINT64(_processEventsElapsedTime);
     singleCoreTasks["queueIncomingPacket"] = TIGHT_LOOP_STAT_UINT64(_queueIncomingPacketElapsedTime);
@@ -824,6 +834,8 @@ void AvatarMixer::sendStatsPacket() {
     QJsonObject slavesAggregatObject;
 
     slavesAggregatObject["received_1_nodesProcessed"] = TIGHT_LOOP_STAT(aggregateStats.nodesProcessed);
+    slavesAggregatObject["received_2_packetQueueContentions"] = TIGHT_LOOP_STAT(aggregateStats.packetQueueContentions);
+    slavesAggregatObject["received_3_packetQueueOverflows"] = TIGHT_LOOP_STAT(aggregateStats.packetQueueOverflows);
 
     slavesAggregatObject["sent_1_nodesBroadcastedTo"] = TIGHT_LOOP_STAT(aggregateStats.nodesBroadcastedTo);
 
@@ -838,6 +850,7 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    slavesAggregatObject["sent_8_averageSharedEncodes"] = TIGHT_LOOP_STAT(aggregateStats.numSharedEncodes);
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -902,6 +915,7 @@ void AvatarMixer::sendStatsPacket() {
 
     _sumListeners = 0;
     _sumIdentityPackets = 0;
+    _numStatFrames = 0;
     _numTightLoopFrames = 0;
 
     _broadcastAvatarDataElapsedTime = 0;
@@ -1010,6 +1024,29 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         qCDebug(avatars) << "Avatar mixer will automatically determine number of threads to use. Using:" << _slavePool.numThreads() << "threads.";
     }
 
+    {
+        const QString PIN_THREADS = "pin_threads";
+        bool pinThreads = avatarMixerGroupObject[PIN_THREADS].toBool();
+        const QString PIN_THREADS_FIRST_CORE = "pin_threads_first_core";
+        int firstCore = avatarMixerGroupObject[PIN_THREADS_FIRST_CORE].toString().toInt();
+        _slavePool.setPinThreads(pinThreads, firstCore);
+        if (pinThreads) {
+            qCDebug(avatars) << "Avatar mixer threads will be pinned to cores, starting at core" << firstCore;
+        } else {
+            qCDebug(avatars) << "Avatar mixer threads will not be pinned to cores.";
+        }
+    }
+
+    {
+        const QString INGRESS_THREADS = "ingress_threads";
+        bool ok;
+        int ingressThreads = avatarMixerGroupObject[INGRESS_THREADS].toString().toInt(&ok);
+        if (ok) {
+            DependencyManager::get<NodeList>()->setNumIngressShards(ingressThreads);
+            qCDebug(avatars) << "Avatar mixer will process received packets on" << ingressThreads << "ingress threads.";
+        }
+    }
+
     {
         const QString CONNECTION_RATE = "connection_rate";
         auto nodeList = DependencyManager::get<NodeList>();
@@ -1020,6 +1057,24 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {
+        const QString BATCHED_RECEIVE = "batched_receive";
+        bool batchedReceive = avatarMixerGroupObject[BATCHED_RECEIVE].toBool();
+        DependencyManager::get<NodeList>()->setBatchedReceiveEnabled(batchedReceive);
+        qCDebug(avatars) << "Avatar mixer batched receive is" << (batchedReceive ? "enabled" : "disabled");
+
+        const QString BATCHED_SEND = "batched_send";
+        bool batchedSend = avatarMixerGroupObject[BATCHED_SEND].toBool();
+        DependencyManager::get<NodeList>()->setBatchedSendEnabled(batchedSend);
+        qCDebug(avatars) << "Avatar mixer batched send is" << (batchedSend ? "enabled" : "disabled");
+    }
+
+    {
+        const QString JOINT_DELTAS = "joint_deltas";
+        _slaveSharedData.jointDeltas = avatarMixerGroupObject[JOINT_DELTAS].toBool();
+        qCDebug(avatars) << "Avatar mixer joint delta coding is" << (_slaveSharedData.jointDeltas ? "enabled" : "disabled");
+    }
+
     {   // Fraction of downstream bandwidth reserved for 'hero' avatars:
         static const QString PRIORITY_FRACTION_KEY = "priority_fraction";
         if (avatarMixerGroupObject.contains(PRIORITY_FRACTION_KEY)) {
@@ -46,43 +46,99 @@ void AvatarMixerClientData::setLastOtherAvatarEncodeTime(NLPacket::LocalID other
     }
 }
 
-void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
-    if (!_packetQueue.node) {
-        _packetQueue.node = node;
+bool AvatarMixerClientData::findEncodedAvatarData(HRCTime frame, EncodedAvatarData& encoded) const {
+    std::lock_guard<std::mutex> lock(_encodedAvatarDataMutex);
+    if (frame != _encodedAvatarDataFrame) {
+        return false;
+    }
+
+    auto itr = std::find_if(_encodedAvatarData.begin(), _encodedAvatarData.end(), [&](const EncodedAvatarData& other) {
+        return other.detail == encoded.detail && other.wantedFlags == encoded.wantedFlags;
+    });
+    if (itr == _encodedAvatarData.end()) {
+        return false;
     }
-    _packetQueue.push(message);
+
+    encoded = *itr;
+    return true;
 }
 
-int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData) {
-    int packetsProcessed = 0;
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
+void AvatarMixerClientData::addEncodedAvatarData(HRCTime frame, const EncodedAvatarData& encoded) const {
+    std::lock_guard<std::mutex> lock(_encodedAvatarDataMutex);
+    if (frame != _encodedAvatarDataFrame) {
+        // the avatar may have changed since, forget what was encoded last frame
+        _encodedAvatarData.clear();
+        _encodedAvatarDataFrame = frame;
+    }
 
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    // another slave may have encoded the same thing in the meantime
+    auto itr = std::find_if(_encodedAvatarData.begin(), _encodedAvatarData.end(), [&](const EncodedAvatarData& other) {
+        return other.detail == encoded.detail && other.wantedFlags == encoded.wantedFlags;
+    });
+    if (itr == _encodedAvatarData.end()) {
+        _encodedAvatarData.push_back(encoded);
+    }
+}
+
+void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message) {
+    if (message->getType() == PacketType::AvatarData) {
+        // avatar data is sent every frame, a full queue drops it and the drop is counted in the mixer stats
+        _packetQueue.push(std::move(message));
+        return;
+    }
 
+    // traits, acks and challenges are reliable, once one overflows the ones after it wait behind it
+    if (_hasPacketOverflow || !_packetQueue.push(std::move(message))) {
+        std::lock_guard<std::mutex> lock(_packetOverflowMutex);
+        _packetOverflow.push_back(std::move(message));
+        _hasPacketOverflow = true;
+    }
+}
+
+int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData, Node& node) {
+    int packetsProcessed = 0;
+
+    auto processPacket = [&](ReceivedMessage& packet) {
         packetsProcessed++;
 
-        switch (packet->getType()) {
+        switch (packet.getType()) {
             case PacketType::AvatarData:
-                parseData(*packet, slaveSharedData);
+                parseData(packet, slaveSharedData);
                 break;
             case PacketType::SetAvatarTraits:
-                processSetTraitsMessage(*packet, slaveSharedData, *node);
+                processSetTraitsMessage(packet, slaveSharedData, node);
                 break;
             case PacketType::BulkAvatarTraitsAck:
-                processBulkAvatarTraitsAckMessage(*packet);
+                processBulkAvatarTraitsAckMessage(packet);
+                break;
+            case PacketType::BulkAvatarDataAck:
+                processBulkAvatarDataAckMessage(packet);
                 break;
             case PacketType::ChallengeOwnership:
-                _avatar->processChallengeResponse(*packet);
+                _avatar->processChallengeResponse(packet);
                 break;
             default:
                 Q_UNREACHABLE();
         }
-        _packetQueue.pop();
+    };
+
+    QSharedPointer<ReceivedMessage> packet;
+    while (_packetQueue.pop(packet)) {
+        processPacket(*packet);
+    }
+
+    // the overflow only holds messages queued after the reliable ones that were in the ring
+    if (_hasPacketOverflow) {
+        std::vector<QSharedPointer<ReceivedMessage>> overflow;
+        {
+            std::lock_guard<std::mutex> lock(_packetOverflowMutex);
+            overflow.swap(_packetOverflow);
+            _hasPacketOverflow = false;
+        }
+        for (auto& overflowPacket : overflow) {
+            processPacket(*overflowPacket);
+        }
     }
-    assert(_packetQueue.empty());
 
     if (_avatar) {
         _avatar->processCertifyEvents();
@@ -324,6 +380,24 @@ void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& m
     }
 }
 
+void AvatarMixerClientData::processBulkAvatarDataAckMessage(ReceivedMessage& message) {
+    // the joint frames in that packet can now be baselines for joint deltas, see AvatarJointDeltas.h
+    AvatarJointDeltas::PacketID packetID;
+    if (message.readPrimitive(&packetID) == sizeof(packetID)) {
+        _jointDeltasAcks.ack(packetID);
+    }
+
+    // the avatars the listener had no baseline for, dropping what was sent of them makes their next joints a keyframe
+    auto nodeList = DependencyManager::get<NodeList>();
+    while (message.getBytesLeftToRead() >= NUM_BYTES_RFC4122_UUID) {
+        QUuid avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        auto avatarNode = nodeList->nodeWithUUID(avatarID);
+        if (avatarNode) {
+            _lastOtherAvatarSentJointFrames.erase(avatarNode->getLocalID());
+        }
+    }
+}
+
 void AvatarMixerClientData::checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData,
                                                              Node& sendingNode,
                                                              AvatarTraits::TraitVersion traitVersion) {
@@ -403,6 +477,8 @@ void AvatarMixerClientData::ignoreOther(const Node* self, const Node* other) {
         setLastBroadcastTime(other->getLocalID(), 0);
 
         resetSentTraitData(other->getLocalID());
+        // the listener drops its joint frames of a killed avatar, so there's no baseline to code deltas against
+        _lastOtherAvatarSentJointFrames.erase(other->getLocalID());
 
         DependencyManager::get<NodeList>()->sendPacket(std::move(killPacket), *self);
     }
@@ -487,6 +563,7 @@ AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherA
 void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLocalID) {
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
+    _lastOtherAvatarSentJointFrames.erase(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
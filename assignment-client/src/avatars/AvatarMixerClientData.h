@@ -13,16 +13,18 @@
 #define hifi_AvatarMixerClientData_h
 
 #include <algorithm>
+#include <atomic>
 #include <cfloat>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
-#include <queue>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QUrl>
 
 #include "MixerAvatar.h"
 #include <AssociatedTraitValues.h>
+#include <MPSCRing.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
@@ -128,11 +130,34 @@ public:
 
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
-    void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
-    int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
+    // joint frames of another avatar sent to this node, and the BulkAvatarData packets it acked
+    AvatarJointDeltas::FrameHistory& getLastOtherAvatarSentJointFrames(NLPacket::LocalID otherAvatar) {
+        return _lastOtherAvatarSentJointFrames[otherAvatar];
+    }
+    const AvatarJointDeltas::AckWindow& getJointDeltasAcks() const { return _jointDeltasAcks; }
+    AvatarJointDeltas::PacketID getNextBulkPacketID() { return _nextBulkPacketID++; }
+
+    // This avatar as encoded for other nodes in the current frame. Every node that gets the same detail and items of
+    // this avatar can be sent the same bytes, so they are encoded once and shared between the slaves.
+    struct EncodedAvatarData {
+        AvatarData::AvatarDataDetail detail { AvatarData::NoData };
+        AvatarDataPacket::HasFlags wantedFlags { 0 };
+        QByteArray bytes;
+        QVector<JointData> sentJoints; // the joints a node has once it got bytes
+    };
+    // thread-safe, fills encoded if it matches the detail and wantedFlags of one encoded this frame
+    bool findEncodedAvatarData(HRCTime frame, EncodedAvatarData& encoded) const;
+    void addEncodedAvatarData(HRCTime frame, const EncodedAvatarData& encoded) const;
+
+    void queuePacket(QSharedPointer<ReceivedMessage> message); // thread-safe, drops avatar data over the queue capacity
+    int processPackets(const SlaveSharedData& slaveSharedData, Node& node); // returns number of packets processed
+
+    uint32_t samplePacketQueueContentions() { return _packetQueue.sampleNumContended(); }
+    uint32_t samplePacketQueueOverflows() { return _packetQueue.sampleNumOverflows(); }
 
     void processSetTraitsMessage(ReceivedMessage& message, const SlaveSharedData& slaveSharedData, Node& sendingNode);
     void processBulkAvatarTraitsAckMessage(ReceivedMessage& message);
+    void processBulkAvatarDataAckMessage(ReceivedMessage& message);
     void checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData, Node& sendingNode,
                                           AvatarTraits::TraitVersion traitVersion);
 
@@ -159,10 +184,13 @@ public:
     void resetSentTraitData(Node::LocalID nodeID);
 
 private:
-    struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
-        QWeakPointer<Node> node;
-    };
+    static const size_t PACKET_QUEUE_CAPACITY = 256;
+    using PacketQueue = MPSCRing<QSharedPointer<ReceivedMessage>, PACKET_QUEUE_CAPACITY>;
     PacketQueue _packetQueue;
+    // reliable messages that did not fit in the packet queue, and everything after them until processPackets drains it
+    std::mutex _packetOverflowMutex;
+    std::vector<QSharedPointer<ReceivedMessage>> _packetOverflow;
+    std::atomic<bool> _hasPacketOverflow { false };
 
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
 
@@ -174,6 +202,13 @@ private:
     // sending to "this" node
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<NLPacket::LocalID, AvatarJointDeltas::FrameHistory> _lastOtherAvatarSentJointFrames;
+    AvatarJointDeltas::AckWindow _jointDeltasAcks;
+    AvatarJointDeltas::PacketID _nextBulkPacketID { 0 };
+
+    mutable std::mutex _encodedAvatarDataMutex;
+    mutable HRCTime _encodedAvatarDataFrame;
+    mutable std::vector<EncodedAvatarData> _encodedAvatarData;
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
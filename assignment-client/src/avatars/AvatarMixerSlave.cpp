@@ -64,7 +64,9 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
     auto nodeData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
     if (nodeData) {
         _stats.nodesProcessed++;
-        _stats.packetsProcessed += nodeData->processPackets(*_sharedData);
+        _stats.packetsProcessed += nodeData->processPackets(*_sharedData, *node);
+        _stats.packetQueueContentions += nodeData->samplePacketQueueContentions();
+        _stats.packetQueueOverflows += nodeData->samplePacketQueueOverflows();
     }
     auto end = usecTimestampNow();
     _stats.processIncomingPacketsElapsedTime += (end - start);
@@ -499,12 +501,21 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     auto traitsPacketList = NLPacketList::create(PacketType::BulkAvatarTraits, QByteArray(), true, true);
 
     auto avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+    auto avatarPacketID = destinationNodeData->getNextBulkPacketID();
     const int avatarPacketCapacity = avatarPacket->getPayloadCapacity();
     int avatarSpaceAvailable = avatarPacketCapacity;
     int numPacketsSent = 0;
     int numAvatarsSent = 0;
     auto identityPacketList = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
 
+    auto sendAvatarPacket = [&] {
+        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+        ++numPacketsSent;
+        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+        avatarPacketID = destinationNodeData->getNextBulkPacketID();
+        avatarSpaceAvailable = avatarPacketCapacity;
+    };
+
     // Loop over two priorities - hero avatars then everyone else:
     for (PriorityVariants currentVariant = kHero; currentVariant <= kNonhero; ++((int&)currentVariant)) {
         const auto& sortedAvatarVector = avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
@@ -564,31 +575,88 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
             QVector<JointData>& lastSentJointsForOther = destinationNodeData->getLastOtherAvatarSentJoints(sourceNode->getLocalID());
 
+            // code the joints against what the destination acked, the occasional SendAllData is a keyframe that
+            // recovers anything the destination lost track of
+            AvatarJointDeltas::SendState jointDeltas;
+            if (_sharedData->jointDeltas) {
+                jointDeltas.acks = &destinationNodeData->getJointDeltasAcks();
+                jointDeltas.sentFrames = &destinationNodeData->getLastOtherAvatarSentJointFrames(sourceNode->getLocalID());
+                jointDeltas.keyframe = (detail == AvatarData::SendAllData);
+            }
+
             const bool distanceAdjust = true;
             const bool dropFaceTracking = false;
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
-            do {
-                auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
-                auto endSerialize = chrono::high_resolution_clock::now();
-                _stats.toByteArrayElapsedTime +=
-                    (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
-
-                avatarPacket->write(bytes);
-                avatarSpaceAvailable -= bytes.size();
-                numAvatarDataBytes += bytes.size();
-                if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
-                    // Weren't able to fit everything.
-                    nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
-                    ++numPacketsSent;
-                    avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
-                    avatarSpaceAvailable = avatarPacketCapacity;
+            // The data of these details doesn't depend on what was last sent to this node, only on which items changed
+            // since, so it is encoded once for every node that gets the same, see AvatarMixerClientData::EncodedAvatarData
+            bool isSharedDetail = detail == AvatarData::PALMinimum || detail == AvatarData::MinimumData ||
+                (detail == AvatarData::SendAllData && !_sharedData->jointDeltas);
+            bool sentSharedEncode = false;
+            if (isSharedDetail) {
+                AvatarMixerClientData::EncodedAvatarData encoded;
+                encoded.detail = detail;
+                encoded.wantedFlags = sourceAvatar->getWantedFlags(detail, lastEncodeForOther, dropFaceTracking);
+
+                if (sourceNodeData->findEncodedAvatarData(_lastFrameTimestamp, encoded)) {
+                    _stats.numSharedEncodes++;
+                } else {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    AvatarDataPacket::SendStatus encodedStatus;
+                    encodedStatus.sendUUID = true;
+                    encoded.bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, encoded.sentJoints,
+                        encodedStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &encoded.sentJoints, avatarPacketCapacity);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    // an avatar too big for a packet is split as usual, and never shared
+                    if (encodedStatus) {
+                        sourceNodeData->addEncodedAvatarData(_lastFrameTimestamp, encoded);
+                    } else {
+                        encoded.bytes.clear();
+                    }
+                }
+
+                // if it doesn't fit what's left of this packet, fill the packet with part of it as usual
+                if (!encoded.bytes.isEmpty() && encoded.bytes.size() <= avatarSpaceAvailable) {
+                    if (detail == AvatarData::SendAllData) {
+                        lastSentJointsForOther = encoded.sentJoints;
+                    }
+
+                    avatarPacket->write(encoded.bytes);
+                    avatarSpaceAvailable -= encoded.bytes.size();
+                    numAvatarDataBytes += encoded.bytes.size();
+                    if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        sendAvatarPacket();
+                    }
+                    sentSharedEncode = true;
                 }
-            } while (!sendStatus);
+            }
+
+            if (!sentSharedEncode) {
+                do {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    jointDeltas.packetID = avatarPacketID;
+                    QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable, nullptr,
+                        _sharedData->jointDeltas ? &jointDeltas : nullptr);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        // Weren't able to fit everything.
+                        sendAvatarPacket();
+                    }
+                } while (!sendStatus);
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
@@ -20,6 +20,8 @@ class AvatarMixerSlaveStats {
 public:
     int nodesProcessed { 0 };
     int packetsProcessed { 0 };
+    int packetQueueContentions { 0 };
+    int packetQueueOverflows { 0 };
     quint64 processIncomingPacketsElapsedTime { 0 };
 
     int nodesBroadcastedTo { 0 };
@@ -33,6 +35,7 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numSharedEncodes { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -44,6 +47,8 @@ public:
         // receiving job stats
         nodesProcessed = 0;
         packetsProcessed = 0;
+        packetQueueContentions = 0;
+        packetQueueOverflows = 0;
         processIncomingPacketsElapsedTime = 0;
 
         // sending job stats
@@ -59,6 +64,7 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numSharedEncodes = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -70,6 +76,8 @@ public:
     AvatarMixerSlaveStats& operator+=(const AvatarMixerSlaveStats& rhs) {
         nodesProcessed += rhs.nodesProcessed;
         packetsProcessed += rhs.packetsProcessed;
+        packetQueueContentions += rhs.packetQueueContentions;
+        packetQueueOverflows += rhs.packetQueueOverflows;
         processIncomingPacketsElapsedTime += rhs.processIncomingPacketsElapsedTime;
 
         nodesBroadcastedTo += rhs.nodesBroadcastedTo;
@@ -83,6 +91,7 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numSharedEncodes += rhs.numSharedEncodes;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -100,6 +109,7 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    bool jointDeltas { false }; // delta code joints sent to agents, see AvatarJointDeltas.h
 };
 
 class AvatarMixerSlave {
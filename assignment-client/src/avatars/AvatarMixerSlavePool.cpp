@@ -13,17 +13,31 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <limits>
+
+#include <PortableHighResolutionClock.h>
+#include <SharedUtil.h>
 
 void AvatarMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
+        // coalesce what this slave sends while it works through its nodes
+        auto nodeList = DependencyManager::get<NodeList>();
+        nodeList->beginSendBatch();
+
+        // iterate over all available nodes, timing each one to balance the next frame
+        size_t task;
         SharedNodePointer node;
-        while (try_pop(node)) {
+        while (try_pop(task, node)) {
+            auto start = p_high_resolution_clock::now();
             (this->*_function)(node);
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start);
+            setCost(task, (uint32_t)std::min<int64_t>(elapsed.count(), std::numeric_limits<uint32_t>::max()));
         }
 
+        nodeList->flushSendBatch();
+
         bool stopping = _stop;
         notify(stopping);
         if (stopping) {
@@ -33,6 +47,7 @@ void AvatarMixerSlaveThread::run() {
 }
 
 void AvatarMixerSlaveThread::wait() {
+    int core;
     {
         Lock lock(_pool._mutex);
         _pool._slaveCondition.wait(lock, [&] {
@@ -40,7 +55,17 @@ void AvatarMixerSlaveThread::wait() {
             return _pool._numStarted != _pool._numThreads;
         });
         ++_pool._numStarted;
+        int numCores = std::max(QThread::idealThreadCount(), 1);
+        core = _pool._pinThreads ? (std::max(_pool._pinFirstCore, 0) + _index) % numCores : -1;
     }
+
+    if (core != _pinnedCore) {
+        _pinnedCore = core;
+        if (!setCurrentThreadCore(core)) {
+            qWarning("%s: could not %s slave %d", __FUNCTION__, core >= 0 ? "pin" : "unpin", _index);
+        }
+    }
+
     if (_pool._configure) {
         _pool._configure(*this);
     }
@@ -59,8 +84,16 @@ void AvatarMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+bool AvatarMixerSlaveThread::try_pop(size_t& task, SharedNodePointer& node) {
+    if (_pool._scheduler.next(_index, task)) {
+        node = *(_pool._begin + task);
+        return true;
+    }
+    return false;
+}
+
+void AvatarMixerSlaveThread::setCost(size_t task, uint32_t cost) {
+    _pool._costs[task] = cost;
 }
 
 void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end) {
@@ -68,7 +101,7 @@ void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end
     _configure = [=](AvatarMixerSlave& slave) { 
         slave.configure(begin, end);
     };
-    run(begin, end);
+    run(begin, end, _processIncomingPacketsCosts);
 }
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
@@ -79,17 +112,37 @@ void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end,
         slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
             _priorityReservedFraction);
    };
-    run(begin, end);
+    run(begin, end, _broadcastAvatarDataCosts);
 }
 
-void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end, TaskCosts& taskCosts) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // estimate each node from what it cost last frame, new nodes are assumed to be average
+    size_t numNodes = std::distance(_begin, _end);
+    _costs.assign(numNodes, 0);
+
+    uint64_t knownCost = 0;
+    size_t numKnown = 0;
+    for (size_t i = 0; i < numNodes; ++i) {
+        auto cost = taskCosts.find((*(_begin + i))->getLocalID());
+        if (cost != taskCosts.end()) {
+            _costs[i] = cost->second;
+            knownCost += cost->second;
+            ++numKnown;
+        }
+    }
+
+    uint32_t averageCost = numKnown > 0 ? (uint32_t)(knownCost / numKnown) : 1;
+    for (auto& cost : _costs) {
+        if (cost == 0) {
+            cost = averageCost;
+        }
+    }
+
+    // split the nodes between the slaves
+    _scheduler.prepare(_costs);
 
     {
         Lock lock(_mutex);
@@ -107,7 +160,11 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    // keep what each node cost for the next frame, this also forgets nodes that are gone
+    taskCosts.clear();
+    for (size_t i = 0; i < numNodes; ++i) {
+        taskCosts[(*(_begin + i))->getLocalID()] = _costs[i];
+    }
 }
 
 
@@ -160,7 +217,7 @@ void AvatarMixerSlavePool::resize(int numThreads) {
     if (numThreads > _numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AvatarMixerSlaveThread(*this, _slaveSharedData);
+            auto slave = new AvatarMixerSlaveThread(*this, _slaveSharedData, (int)_slaves.size());
             slave->start();
             _slaves.emplace_back(slave);
         }
@@ -200,4 +257,7 @@ void AvatarMixerSlavePool::resize(int numThreads) {
 
     _numThreads = _numStarted = _numFinished = numThreads;
     assert(_numThreads == (int)_slaves.size());
+
+    // the slaves are all idle, so the scheduler can be resized under them
+    _scheduler.setNumWorkers(_numThreads);
 }
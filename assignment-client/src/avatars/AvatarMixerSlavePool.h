@@ -14,13 +14,14 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <QThread>
 
-#include <TBBHelpers.h>
 #include <NodeList.h>
 #include <shared/QtHelpers.h>
+#include <WorkStealingScheduler.h>
 
 #include "AvatarMixerSlave.h"
 
@@ -34,8 +35,8 @@ class AvatarMixerSlaveThread : public QThread, public AvatarMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool, SlaveSharedData* slaveSharedData) :
-        AvatarMixerSlave(slaveSharedData), _pool(pool) {};
+    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool, SlaveSharedData* slaveSharedData, int index) :
+        AvatarMixerSlave(slaveSharedData), _pool(pool), _index(index) {};
 
     void run() override final;
 
@@ -44,17 +45,20 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
+    bool try_pop(size_t& task, SharedNodePointer& node);
+    void setCost(size_t task, uint32_t cost);
 
     AvatarMixerSlavePool& _pool;
     void (AvatarMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
+    const int _index;
+    int _pinnedCore { -1 };
     bool _stop { false };
 };
 
 // Slave pool for avatar mixers
 //   AvatarMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AvatarMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
+    using TaskCosts = std::unordered_map<Node::LocalID, uint32_t>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -84,15 +88,23 @@ public:
     void setPriorityReservedFraction(float fraction) { _priorityReservedFraction = fraction; }
     float getPriorityReservedFraction() const { return  _priorityReservedFraction; }
 
+    // pin each slave thread to its own core, slave N to core firstCore + N, wrapping around
+    // off by default, when both mixers run on one machine give them first cores that keep them apart
+    void setPinThreads(bool pinThreads, int firstCore = 0) { _pinThreads = pinThreads; _pinFirstCore = firstCore; }
+
+    // number of times a slave ran out of nodes and took some from another slave, since last sampled
+    uint32_t sampleNumSteals() { return _scheduler.sampleNumSteals(); }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, TaskCosts& taskCosts);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AvatarMixerSlaveThread>> _slaves;
 
     friend void AvatarMixerSlaveThread::wait();
     friend void AvatarMixerSlaveThread::notify(bool stopping);
-    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AvatarMixerSlaveThread::try_pop(size_t& task, SharedNodePointer& node);
+    friend void AvatarMixerSlaveThread::setCost(size_t task, uint32_t cost);
 
     // synchronization state
     Mutex _mutex;
@@ -104,16 +116,23 @@ private:
     // Set from Domain Settings:
     float _priorityReservedFraction { 0.4f };
     int _numThreads { 0 };
+    bool _pinThreads { false };
+    int _pinFirstCore { 0 };
 
     int _numStarted { 0 }; // guarded by _mutex
     int _numFinished { 0 }; // guarded by _mutex
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    WorkStealingScheduler _scheduler;
+    WorkStealingScheduler::Costs _costs; // estimated from the last frame, then measured (in ns) by the slaves
     ConstIter _begin;
     ConstIter _end;
 
+    // per node cost of each job in the last frame
+    TaskCosts _processIncomingPacketsCosts;
+    TaskCosts _broadcastAvatarDataCosts;
+
     SlaveSharedData* _slaveSharedData;
 };
 
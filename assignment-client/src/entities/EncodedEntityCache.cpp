@@ -0,0 +1,68 @@
+//
+//  EncodedEntityCache.cpp
+//  assignment-client/src/entities
+//
+//  Created by High Fidelity on 2019-06-19.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EncodedEntityCache.h"
+
+#include <EntityItem.h>
+
+EncodedEntityCache::Version EncodedEntityCache::getVersion(const EntityItem& entity) {
+    Version version;
+    version.lastEdited = entity.getLastEdited();
+    version.lastUpdated = entity.getLastUpdated();
+    version.lastSimulated = entity.getLastSimulated();
+    version.lastChangedOnServer = entity.getLastChangedOnServer();
+    return version;
+}
+
+EncodedEntityCache::Shard& EncodedEntityCache::getShard(const EntityItem* entity) const {
+    // the low bits of a heap address are the same for every entity
+    const int ALIGNMENT_BITS = 4;
+    return _shards[(reinterpret_cast<uintptr_t>(entity) >> ALIGNMENT_BITS) % NUM_SHARDS];
+}
+
+QByteArray EncodedEntityCache::find(const EntityItem& entity, const Version& version, bool withPrivateUserData) const {
+    auto& shard = getShard(&entity);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto itr = shard.entries.find(&entity);
+        if (itr != shard.entries.end() && itr->second.entityID == entity.getID() && itr->second.version == version) {
+            const QByteArray& encoded = itr->second.encoded[withPrivateUserData];
+            if (!encoded.isEmpty()) {
+                _numHits.fetch_add(1, std::memory_order_relaxed);
+                return encoded;
+            }
+        }
+    }
+
+    _numMisses.fetch_add(1, std::memory_order_relaxed);
+    return QByteArray();
+}
+
+void EncodedEntityCache::insert(const EntityItem& entity, const Version& version, bool withPrivateUserData,
+                                const QByteArray& encoded) {
+    auto& shard = getShard(&entity);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    Entry& entry = shard.entries[&entity];
+    if (entry.entityID != entity.getID() || !(entry.version == version)) {
+        // an older version, or a deleted entity that was at the same address
+        entry = Entry();
+        entry.entityID = entity.getID();
+        entry.version = version;
+    }
+    entry.encoded[withPrivateUserData] = encoded;
+}
+
+void EncodedEntityCache::erase(const EntityItem* entity) {
+    auto& shard = getShard(entity);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.erase(entity);
+}
@@ -0,0 +1,80 @@
+//
+//  EncodedEntityCache.h
+//  assignment-client/src/entities
+//
+//  Created by High Fidelity on 2019-06-19.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_EncodedEntityCache_h
+#define hifi_EncodedEntityCache_h
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QUuid>
+
+class EntityItem;
+
+// Entities as encoded by EntityItem::appendEntityData, shared by the EntityTreeSendThreads of every viewer.
+//
+// Every viewer that is sent the same version of an entity is sent the same bytes, so they are encoded by the first
+// send thread that needs them and copied into the packets of the others. A version is identified by the timestamps
+// appendEntityData writes and that the send threads check for changes, and entries are dropped when the entity is
+// edited or deleted. The map is split into shards so that send threads rarely wait on each other.
+class EncodedEntityCache {
+public:
+    struct Version {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 lastChangedOnServer { 0 };
+
+        bool operator==(const Version& other) const {
+            return lastEdited == other.lastEdited && lastUpdated == other.lastUpdated &&
+                lastSimulated == other.lastSimulated && lastChangedOnServer == other.lastChangedOnServer;
+        }
+    };
+    static Version getVersion(const EntityItem& entity);
+
+    // thread-safe, returns an empty array if this version of the entity hasn't been encoded
+    QByteArray find(const EntityItem& entity, const Version& version, bool withPrivateUserData) const;
+    void insert(const EntityItem& entity, const Version& version, bool withPrivateUserData, const QByteArray& encoded);
+    // entity may already be deleted, it is only used as a key
+    void erase(const EntityItem* entity);
+
+    // number of entities found / encoded since last sampled
+    uint32_t sampleNumHits() { return _numHits.exchange(0, std::memory_order_relaxed); }
+    uint32_t sampleNumMisses() { return _numMisses.exchange(0, std::memory_order_relaxed); }
+
+private:
+    static const int NUM_SHARDS = 16;
+
+    struct Entry {
+        QUuid entityID; // in case the entity was deleted and another one allocated at the same address
+        Version version;
+        QByteArray encoded[2]; // without, and with the private user data
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<const EntityItem*, Entry> entries;
+    };
+
+    Shard& getShard(const EntityItem* entity) const;
+
+    mutable std::array<Shard, NUM_SHARDS> _shards;
+
+    mutable std::atomic<uint32_t> _numHits { 0 };
+    mutable std::atomic<uint32_t> _numMisses { 0 };
+};
+
+#endif // hifi_EncodedEntityCache_h
@@ -97,6 +97,11 @@ OctreePointer EntityServer::createTree() {
     EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
     tree->createRootElement();
     tree->addNewlyCreatedHook(this);
+    // a send thread may still be encoding an entity as it's deleted, they don't cache dead entities, and an entry left
+    // by one that died in between is only found again by an entity with the same ID
+    connect(tree.get(), &EntityTree::deletingEntityPointer, this, [this](EntityItem* entity) {
+        _encodedEntityCache.erase(entity);
+    }, Qt::DirectConnection);
     if (!_entitySimulation) {
         SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
         simpleSimulation->setEntityTree(tree);
@@ -414,6 +419,16 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    statsString += "<b>Entity Server Encoded Entity Cache</b>\r\n";
+    statsString += QString().sprintf("   Entities copied since last sampled... %u\r\n", _encodedEntityCache.sampleNumHits());
+    statsString += QString().sprintf("  Entities encoded since last sampled... %u\r\n", _encodedEntityCache.sampleNumMisses());
+    statsString += "\r\n\r\n";
+
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    statsString += "<b>Entity Server Edits</b>\r\n";
+    statsString += QString().sprintf("  Edits applied alongside sending... %d\r\n", tree->getTotalInPlaceUpdates());
+    statsString += "\r\n\r\n";
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
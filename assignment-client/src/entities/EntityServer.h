@@ -20,6 +20,7 @@
 #include <EntityTree.h>
 #include <SimpleEntitySimulation.h>
 
+#include "EncodedEntityCache.h"
 #include "EntityServerConsts.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
@@ -59,6 +60,8 @@ public:
 
     virtual void aboutToFinish() override;
 
+    EncodedEntityCache& getEncodedEntityCache() { return _encodedEntityCache; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -75,6 +78,7 @@ private slots:
 
 private:
     SimpleEntitySimulationPointer _entitySimulation;
+    EncodedEntityCache _encodedEntityCache;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
     QReadWriteLock _viewerSendingStatsLock;
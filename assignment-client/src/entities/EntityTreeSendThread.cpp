@@ -18,7 +18,8 @@
 #include "EntityServer.h"
 
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
-    OctreeSendThread(myServer, node)
+    OctreeSendThread(myServer, node),
+    _encodedEntityCache(static_cast<EntityServer*>(myServer)->getEncodedEntityCache())
 {
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
@@ -102,8 +103,7 @@ void EntityTreeSendThread::preDistributionProcessing() {
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
     if (viewFrustumChanged || _traversal.finished()) {
-        EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
-
+        _snapshot = std::static_pointer_cast<EntityTree>(_myServer->getOctree())->getSnapshot();
 
         DiffTraversal::View newView;
         newView.viewFrustums = nodeData->getCurrentViews();
@@ -111,7 +111,7 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
         int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
         newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
         
-        startNewTraversal(newView, root, isFullScene);
+        startNewTraversal(newView, isFullScene);
 
         // When the viewFrustum changed the sort order may be incorrect, so we re-sort
         // and also use the opportunity to cull anything no longer in view
@@ -225,10 +225,9 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
     return hasNewChild || hasNewDescendants;
 }
 
-void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
-                                             bool forceFirstPass) {
+void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, bool forceFirstPass) {
 
-    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root, forceFirstPass);
+    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, _snapshot, forceFirstPass);
     // there are three types of traversal:
     //
     //      (1) FirstTime = at login --> find everything in view
@@ -338,7 +337,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
         _packetData.appendValue(zeroByte); // colors
         if (params.includeExistsBits) {
             uint8_t childrenExistBits = 0;
-            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
+            const auto& root = _snapshot->getRoot();
             for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
                 if (root->getChildAtIndex(i)) {
                     childrenExistBits += (1 << i);
@@ -365,7 +364,8 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     while(!_sendQueue.empty()) {
         PrioritizedEntity queuedItem = _sendQueue.top();
         EntityItemPointer entity = queuedItem.getEntity();
-        if (entity) {
+        // entities deleted since the traversal's snapshot was made are still in it, their deletion is sent instead
+        if (entity && !entity->isDead()) {
             const QUuid& entityID = entity->getID();
             // Only send entities that match the jsonFilters, but keep track of everything we've tried to send so we don't try to send it again;
             // also send if we previously matched since this represents change to a matched item.
@@ -377,7 +377,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
-                OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
+                OctreeElement::AppendState appendEntityState = appendEntityData(*entity, params, entityNode->getCanGetAndSetPrivateUserData());
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -418,8 +418,38 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     return true;
 }
 
+OctreeElement::AppendState EntityTreeSendThread::appendEntityData(const EntityItem& entity, EncodeBitstreamParams& params,
+                                                                  bool canGetAndSetPrivateUserData) {
+    // the rest of an entity that didn't fit in the last packet is only ever sent to this viewer
+    if (_extraEncodeData->entities.contains(entity.getEntityItemID())) {
+        return entity.appendEntityData(&_packetData, params, _extraEncodeData, canGetAndSetPrivateUserData);
+    }
+
+    auto version = EncodedEntityCache::getVersion(entity);
+    QByteArray encoded = _encodedEntityCache.find(entity, version, canGetAndSetPrivateUserData);
+    if (!encoded.isEmpty()) {
+        // if it doesn't fit, fill the packet with as many of its properties as do instead
+        if (_packetData.appendRawData(encoded)) {
+            params.trackSend(entity.getID(), version.lastEdited);
+            return OctreeElement::COMPLETED;
+        }
+        return entity.appendEntityData(&_packetData, params, _extraEncodeData, canGetAndSetPrivateUserData);
+    }
+
+    int entityOffset = _packetData.getUncompressedByteOffset();
+    auto appendState = entity.appendEntityData(&_packetData, params, _extraEncodeData, canGetAndSetPrivateUserData);
+    if (appendState == OctreeElement::COMPLETED && !entity.isDead()) {
+        int entitySize = _packetData.getUncompressedByteOffset() - entityOffset;
+        encoded = QByteArray((const char*)_packetData.getUncompressedData(entityOffset), entitySize);
+        _encodedEntityCache.insert(entity, version, canGetAndSetPrivateUserData, encoded);
+    }
+    return appendState;
+}
+
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
     if (entity) {
+        _encodedEntityCache.erase(entity.get());
+
         if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
             const auto& view = _traversal.getCurrentView();
             float priority = view.computePriority(entity);
@@ -18,9 +18,11 @@
 
 #include <DiffTraversal.h>
 #include <EntityPriorityQueue.h>
+#include <EntityTreeSnapshot.h>
 #include <shared/ConicalViewFrustum.h>
 
 
+class EncodedEntityCache;
 class EntityNodeData;
 class EntityItem;
 
@@ -42,19 +44,26 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
-    void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
+    void startNewTraversal(const DiffTraversal::View& viewFrustum, bool forceFirstPass = false);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
+    // appends the entity to _packetData, copied from the shared cache when another viewer was sent the same version
+    OctreeElement::AppendState appendEntityData(const EntityItem& entity, EncodeBitstreamParams& params,
+                                                bool canGetAndSetPrivateUserData);
 
     void preDistributionProcessing() override;
     bool hasSomethingToSend(OctreeQueryNode* nodeData) override { return !_sendQueue.empty(); }
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
+    // we traverse _snapshot, and read entities under their own locks
+    bool needsTreeReadLock() const override { return false; }
 
+    EntityTreeSnapshotPointer _snapshot; // of the tree, as of the start of the current traversal
     DiffTraversal _traversal;
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
 
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
+    EncodedEntityCache& _encodedEntityCache;
     int32_t _numEntitiesOffset { 0 };
     uint16_t _numEntities { 0 };
 
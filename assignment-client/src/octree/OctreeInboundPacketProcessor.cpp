@@ -170,13 +170,11 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+            // the tree takes its own locks, so any time spent waiting on them is part of the process time
+            quint64 startProcess = usecTimestampNow();
+            quint64 startLock = startProcess;
+            int editDataBytesRead =
+                _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
@@ -337,6 +337,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
 
     _packetData.changeSettings(true, targetSize); // FIXME - eventually support only compressed packets
+    _packetData.setCompression(nodeData->getPacketCompression(), nodeData->getPacketCompressionDictionary());
 
     // If the current view frustum has changed OR we have nothing to send, then search against
     // the current view frustum for things to send.
@@ -363,9 +364,13 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     quint64 start = usecTimestampNow();
 
-    _myServer->getOctree()->withReadLock([&]{
+    if (needsTreeReadLock()) {
+        _myServer->getOctree()->withReadLock([&]{
+            traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
+        });
+    } else {
         traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
-    });
+    }
 
     // Here's where we can/should allow the server to send other data...
     // send the environment packet
@@ -469,6 +474,8 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
                 if (additionalSize > nodeData->getAvailable()) {
                     // no room --> flush what we've got
                     _packetsSentThisInterval += handlePacketSend(node, nodeData);
+                    // the new packet may be compressed differently, if the client's query changed
+                    _packetData.setCompression(nodeData->getPacketCompression(), nodeData->getPacketCompressionDictionary());
                 }
 
                 // either there is room, or we've flushed and reset nodeData's data buffer
@@ -497,6 +504,7 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
                 targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE) - COMPRESS_PADDING;
             }
             _packetData.changeSettings(true, targetSize); // will do reset - NOTE: Always compressed
+            _packetData.setCompression(nodeData->getPacketCompression(), nodeData->getPacketCompressionDictionary());
         }
         OctreeServer::trackCompressAndWriteTime(compressAndWriteElapsedUsec);
         OctreeServer::trackPacketSendingTime(packetSendingElapsedUsec);
@@ -69,6 +69,8 @@ private:
 
     virtual bool hasSomethingToSend(OctreeQueryNode* nodeData) = 0;
     virtual bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) = 0;
+    /// Whether traverseTreeAndSendContents() must hold the tree's read lock
+    virtual bool needsTreeReadLock() const { return true; }
 
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
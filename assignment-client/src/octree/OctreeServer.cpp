@@ -898,6 +898,11 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         auto nodeList = DependencyManager::get<NodeList>();
         nodeList->updateNodeWithDataFromPacket(message, senderNode);
 
+        OctreeQueryNode* nodeData = dynamic_cast<OctreeQueryNode*>(senderNode->getLinkedData());
+        if (nodeData && nodeData->shouldSendCompressionDictionary()) {
+            sendCompressionDictionary(senderNode);
+        }
+
         auto it = _sendThreads.find(senderNode->getUUID());
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
@@ -909,6 +914,12 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
     }
 }
 
+void OctreeServer::sendCompressionDictionary(const SharedNodePointer& node) {
+    auto packetList = NLPacketList::create(PacketType::OctreeDataCompressionDictionary, QByteArray(), true, true);
+    packetList->write(_compressionDictionary->getData());
+    DependencyManager::get<NodeList>()->sendPacketList(std::move(packetList), *node);
+}
+
 void OctreeServer::handleOctreeDataNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     // If we got a nack packet, then we're talking to an agent, and we
     // need to make sure we have it in our nodeList.
@@ -1048,6 +1059,11 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
         _persistAsFileType = "json.gz";
+        QString persistFileType;
+        if (readOptionString("persistFileType", settingsSectionObject, persistFileType) && persistFileType == "bin") {
+            _persistAsFileType = persistFileType;
+        }
+        qDebug() << "persistFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1058,6 +1074,15 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistInterval=" << _persistInterval.count();
 
+        readOptionBool(QString("persistJournal"), settingsSectionObject, _persistJournal);
+        _persistSnapshotInterval = OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL;
+        result = -1;
+        readOptionInt(QString("persistSnapshotInterval"), settingsSectionObject, result);
+        if (result != -1) {
+            _persistSnapshotInterval = std::chrono::milliseconds(result);
+        }
+        qDebug() << "persistJournal=" << _persistJournal << "persistSnapshotInterval=" << _persistSnapshotInterval.count();
+
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
@@ -1065,6 +1090,29 @@ void OctreeServer::readConfiguration() {
         qDebug("persistFilename= DISABLED");
     }
 
+    // zstd packets are only sent to clients that ask for them, the others get zlib packets
+    QString packetCompression;
+    _wantZstdCompression = readOptionString("packetCompression", settingsSectionObject, packetCompression)
+        && packetCompression == "zstd";
+    qDebug() << "packetCompression=" << (_wantZstdCompression ? "zstd" : "zlib");
+
+    QString compressionDictionaryPath;
+    if (_wantZstdCompression && readOptionString("packetCompressionDictionary", settingsSectionObject, compressionDictionaryPath)
+        && !compressionDictionaryPath.isEmpty()) {
+        if (QDir(compressionDictionaryPath).isRelative()) {
+            // relative to the default data directory, like the persist file
+            compressionDictionaryPath = QDir(PathUtils::getAppDataFilePath("entities/")).absoluteFilePath(compressionDictionaryPath);
+        }
+        QFile dictionaryFile(compressionDictionaryPath);
+        if (dictionaryFile.open(QIODevice::ReadOnly)) {
+            _compressionDictionary = OctreeCompressionDictionary::create(dictionaryFile.readAll());
+        } else {
+            qWarning() << "Cannot open compression dictionary" << compressionDictionaryPath;
+        }
+        qDebug() << "packetCompressionDictionary=" << compressionDictionaryPath
+                 << "id=" << (_compressionDictionary ? _compressionDictionary->getID() : 0);
+    }
+
     // Debug option to demonstrate that the server's local time does not
     // need to be in sync with any other network node. This forces clock
     // skew for the individual server node
@@ -1097,6 +1145,12 @@ void OctreeServer::readConfiguration() {
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
 
+    int ingressThreads = 0;
+    if (readOptionInt(QString("ingressThreads"), settingsSectionObject, ingressThreads)) {
+        DependencyManager::get<NodeList>()->setNumIngressShards(ingressThreads);
+    }
+    qDebug() << "ingressThreads=" << ingressThreads;
+
     readAdditionalConfiguration(settingsSectionObject);
 }
 
@@ -1187,6 +1241,9 @@ void OctreeServer::domainSettingsRequestComplete() {
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
                                                  _persistAsFileType);
+        if (_persistJournal) {
+            _persistManager->enableJournal(_persistSnapshotInterval);
+        }
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, &OctreePersistThread::start);
@@ -1213,6 +1270,7 @@ void OctreeServer::beginRunning() {
 
     nodeList->linkedDataCreateCallback = [this](Node* node) {
         auto queryNodeData = createOctreeQueryNode();
+        queryNodeData->setCompressionSettings(_wantZstdCompression, _compressionDictionary);
         queryNodeData->init();
         node->setLinkedData(std::move(queryNodeData));
     };
@@ -165,6 +165,7 @@ protected:
     void beginRunning();
     
     UniqueSendThread createSendThread(const SharedNodePointer& node);
+    void sendCompressionDictionary(const SharedNodePointer& node);
     virtual UniqueSendThread newSendThread(const SharedNodePointer& node) = 0;
 
     int _argc;
@@ -194,7 +195,12 @@ protected:
     QThread _persistThread;
 
     std::chrono::milliseconds _persistInterval;
+    bool _persistJournal { false };
+    std::chrono::milliseconds _persistSnapshotInterval;
     bool _persistFileDownload;
+
+    bool _wantZstdCompression { false };
+    OctreeCompressionDictionaryPointer _compressionDictionary;
     int _maxBackupVersions;
 
     time_t _started;
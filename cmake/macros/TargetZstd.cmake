@@ -0,0 +1,14 @@
+#
+#  Copyright 2019 High Fidelity, Inc.
+#  Created by High Fidelity on 2019/06/25
+#
+#  Distributed under the Apache License, Version 2.0.
+#  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+#
+macro(TARGET_ZSTD)
+    # using VCPKG for zstd
+    find_library(ZSTD_LIBRARY_RELEASE NAMES zstd libzstd zstd_static PATHS ${VCPKG_INSTALL_ROOT}/lib NO_DEFAULT_PATH)
+    find_library(ZSTD_LIBRARY_DEBUG NAMES zstdd libzstdd zstd_staticd zstd libzstd PATHS ${VCPKG_INSTALL_ROOT}/debug/lib NO_DEFAULT_PATH)
+    select_library_configurations(ZSTD)
+    target_link_libraries(${TARGET_NAME} ${ZSTD_LIBRARY})
+endmacro()
@@ -6919,6 +6919,11 @@ void Application::queryOctree(NodeType_t serverType, PacketType packetType) {
     if (node && node->getActiveSocket()) {
         _octreeQuery.setMaxQueryPacketsPerSecond(getMaxOctreePacketsPerSecond());
 
+        // ask for zstd packets, which are compressed with the server's dictionary once we have it
+        _octreeQuery.setWantZstdCompression(true);
+        auto renderer = getEntities();
+        _octreeQuery.setCompressionDictionaryID(renderer ? renderer->getCompressionDictionaryID() : 0);
+
         auto queryPacket = NLPacket::create(packetType);
 
         // encode the query data
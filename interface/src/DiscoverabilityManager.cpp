@@ -81,7 +81,7 @@ void DiscoverabilityManager::updateLocation() {
             }
 
             // in case the place/domain isn't in the database, we send the network address and port
-            auto& domainSockAddr = domainHandler.getSockAddr();
+            auto domainSockAddr = domainHandler.getSockAddr();
             const QString NETWORK_ADDRESS_KEY_IN_LOCATION = "network_address";
             locationObject.insert(NETWORK_ADDRESS_KEY_IN_LOCATION, domainSockAddr.getAddress().toString());
 
@@ -24,7 +24,8 @@ OctreePacketProcessor::OctreePacketProcessor():
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     const PacketReceiver::PacketTypeList octreePackets =
-        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityQueryInitialResultsComplete };
+        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityQueryInitialResultsComplete,
+          PacketType::OctreeDataCompressionDictionary };
     packetReceiver.registerDirectListenerForTypes(octreePackets, this, "handleOctreePacket");
 }
 
@@ -91,7 +92,8 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         return; // bail since piggyback version doesn't match
     }
 
-    if (packetType != PacketType::EntityQueryInitialResultsComplete) {
+    if (packetType != PacketType::EntityQueryInitialResultsComplete &&
+        packetType != PacketType::OctreeDataCompressionDictionary) {
         qApp->trackIncomingOctreePacket(*message, sendingNode, wasStatsPacket);
     }
     
@@ -133,6 +135,13 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
             }
         } break;
 
+        case PacketType::OctreeDataCompressionDictionary: {
+            auto renderer = qApp->getEntities();
+            if (renderer) {
+                renderer->processCompressionDictionaryMessage(*message);
+            }
+        } break;
+
         default: {
             // nothing to do
         } break;
@@ -12,6 +12,67 @@
 
 #include "AudioDynamics.h"
 
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// apply gain and dither, convert to 16-bit with saturation (interleaved)
+static void gaindither_2x2_SSE(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    int i = 0;
+    for (; i < numFrames - 3; i += 4) {
+
+        __m128 g = _mm_loadu_ps(&gain[i]);
+        __m128 d = _mm_loadu_ps(&dither[i]);
+
+        // same gain and dither for both channels of each frame
+        __m128 x0 = _mm_mul_ps(_mm_loadu_ps(&src[2*i+0]), _mm_unpacklo_ps(g, g));
+        __m128 x1 = _mm_mul_ps(_mm_loadu_ps(&src[2*i+4]), _mm_unpackhi_ps(g, g));
+
+        x0 = _mm_add_ps(x0, _mm_unpacklo_ps(d, d));
+        x1 = _mm_add_ps(x1, _mm_unpackhi_ps(d, d));
+
+        // round-to-nearest, same as floatToInt()
+        __m128i y = _mm_packs_epi32(_mm_cvtps_epi32(x0), _mm_cvtps_epi32(x1));
+
+        _mm_storeu_si128((__m128i*)&dst[2*i], y);
+    }
+
+    for (; i < numFrames; i++) {
+        dst[2*i+0] = (int16_t)floatToInt(src[2*i+0] * gain[i] + dither[i]);
+        dst[2*i+1] = (int16_t)floatToInt(src[2*i+1] * gain[i] + dither[i]);
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void gaindither_2x2_AVX2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames);
+
+static void gaindither_2x2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? gaindither_2x2_AVX2 : gaindither_2x2_SSE;
+    (*f)(src, gain, dither, dst, numFrames); // dispatch
+}
+
+#else   // portable reference code
+
+// apply gain and dither, convert to 16-bit (interleaved)
+static void gaindither_2x2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        dst[2*i+0] = (int16_t)floatToInt(src[2*i+0] * gain[i] + dither[i]);
+        dst[2*i+1] = (int16_t)floatToInt(src[2*i+1] * gain[i] + dither[i]);
+    }
+}
+
+#endif
+
 //
 // Limiter (common)
 //
@@ -261,41 +322,48 @@ public:
 template<int N>
 void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+    // the envelope is inherently serial, so it is computed a block at a time
+    // and the gain, dither and 16-bit conversion are applied to the whole block
+    const int BLOCK = 64;
+    float delayBlock[2*BLOCK];
+    float gainBlock[BLOCK];
+    float ditherBlock[BLOCK];
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
+    for (int n = 0; n < numFrames; n += BLOCK) {
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+        int count = MIN(numFrames - n, BLOCK);
 
-        // apply envelope
-        attn = envelope(attn);
+        for (int i = 0; i < count; i++) {
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // peak detect and convert to log2 domain
+            int32_t peak = peaklog2(&input[2*(n+i)+0], &input[2*(n+i)+1]);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // compute limiter attenuation
+            int32_t attn = MAX(_threshold - peak, 0);
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
+            // apply envelope
+            attn = envelope(attn);
 
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
+            // convert from log2 domain
+            attn = fixexp2(attn);
 
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
+            // lowpass filter
+            attn = _filter.process(attn);
+            gainBlock[i] = attn * _outGain;
 
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
+            // delay audio
+            float x0 = input[2*(n+i)+0];
+            float x1 = input[2*(n+i)+1];
+            _delay.process(x0, x1);
+
+            delayBlock[2*i+0] = x0;
+            delayBlock[2*i+1] = x1;
+
+            ditherBlock[i] = dither();
+        }
+
+        // apply gain and dither, store 16-bit output
+        gaindither_2x2(delayBlock, gainBlock, ditherBlock, &output[2*n], count);
     }
 }
 
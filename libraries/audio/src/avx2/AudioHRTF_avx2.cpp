@@ -248,4 +248,74 @@ void interpolate_AVX2(const float* src0, const float* src1, float* dst, float fr
     _mm256_zeroupper();
 }
 
+// apply gain crossfade with accumulation (interleaved)
+void gainfade_1x2_AVX2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m256 g0 = _mm256_set1_ps(gain0 * (1/32768.0f));   // int16_t to float
+    __m256 g1 = _mm256_set1_ps(gain1 * (1/32768.0f));
+    __m256 dg = _mm256_sub_ps(g0, g1);
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 frac = _mm256_loadu_ps(&win[i]);
+        __m256 gain = _mm256_fmadd_ps(frac, dg, g1);
+
+        __m256 x0 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)&src[i])));
+        x0 = _mm256_mul_ps(x0, gain);
+
+        // mono to interleaved stereo
+        __m256 t0 = _mm256_unpacklo_ps(x0, x0);
+        __m256 t1 = _mm256_unpackhi_ps(x0, x0);
+
+        __m256 y0 = _mm256_loadu_ps(&dst[2*i+0]);
+        __m256 y1 = _mm256_loadu_ps(&dst[2*i+8]);
+
+        y0 = _mm256_add_ps(y0, _mm256_permute2f128_ps(t0, t1, 0x20));
+        y1 = _mm256_add_ps(y1, _mm256_permute2f128_ps(t0, t1, 0x31));
+
+        _mm256_storeu_ps(&dst[2*i+0], y0);
+        _mm256_storeu_ps(&dst[2*i+8], y1);
+    }
+
+    _mm256_zeroupper();
+}
+
+// apply gain crossfade with accumulation (interleaved)
+void gainfade_2x2_AVX2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
+
+    __m256 g0 = _mm256_set1_ps(gain0 * (1/32768.0f));   // int16_t to float
+    __m256 g1 = _mm256_set1_ps(gain1 * (1/32768.0f));
+    __m256 dg = _mm256_sub_ps(g0, g1);
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m256 frac = _mm256_loadu_ps(&win[i]);
+        __m256 gain = _mm256_fmadd_ps(frac, dg, g1);
+
+        // same gain for both channels of each frame
+        __m256 t0 = _mm256_unpacklo_ps(gain, gain);
+        __m256 t1 = _mm256_unpackhi_ps(gain, gain);
+        __m256 f0 = _mm256_permute2f128_ps(t0, t1, 0x20);
+        __m256 f1 = _mm256_permute2f128_ps(t0, t1, 0x31);
+
+        __m256 x0 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)&src[2*i+0])));
+        __m256 x1 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i*)&src[2*i+8])));
+
+        __m256 y0 = _mm256_loadu_ps(&dst[2*i+0]);
+        __m256 y1 = _mm256_loadu_ps(&dst[2*i+8]);
+
+        y0 = _mm256_fmadd_ps(x0, f0, y0);
+        y1 = _mm256_fmadd_ps(x1, f1, y1);
+
+        _mm256_storeu_ps(&dst[2*i+0], y0);
+        _mm256_storeu_ps(&dst[2*i+8], y1);
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
@@ -0,0 +1,55 @@
+//
+//  AudioLimiter_avx2.cpp
+//  libraries/audio/src
+//
+//  Created by High Fidelity on 2019-06-12.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+// apply gain and dither, convert to 16-bit with saturation (interleaved)
+void gaindither_2x2_AVX2(const float* src, const float* gain, const float* dither, int16_t* dst, int numFrames) {
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+
+        __m256 g = _mm256_loadu_ps(&gain[i]);
+        __m256 d = _mm256_loadu_ps(&dither[i]);
+
+        // same gain and dither for both channels of each frame
+        __m256 t0 = _mm256_unpacklo_ps(g, g);
+        __m256 t1 = _mm256_unpackhi_ps(g, g);
+        __m256 g0 = _mm256_permute2f128_ps(t0, t1, 0x20);
+        __m256 g1 = _mm256_permute2f128_ps(t0, t1, 0x31);
+
+        t0 = _mm256_unpacklo_ps(d, d);
+        t1 = _mm256_unpackhi_ps(d, d);
+        __m256 d0 = _mm256_permute2f128_ps(t0, t1, 0x20);
+        __m256 d1 = _mm256_permute2f128_ps(t0, t1, 0x31);
+
+        __m256 x0 = _mm256_fmadd_ps(_mm256_loadu_ps(&src[2*i+0]), g0, d0);
+        __m256 x1 = _mm256_fmadd_ps(_mm256_loadu_ps(&src[2*i+8]), g1, d1);
+
+        // round-to-nearest, then pack (packs works per 128-bit lane, so restore the order)
+        __m256i y = _mm256_packs_epi32(_mm256_cvtps_epi32(x0), _mm256_cvtps_epi32(x1));
+        y = _mm256_permute4x64_epi64(y, _MM_SHUFFLE(3,1,2,0));
+
+        _mm256_storeu_si256((__m256i*)&dst[2*i], y);
+    }
+
+    for (; i < numFrames; i++) {
+        dst[2*i+0] = (int16_t)_mm_cvt_ss2si(_mm_set_ss(src[2*i+0] * gain[i] + dither[i]));
+        dst[2*i+1] = (int16_t)_mm_cvt_ss2si(_mm_set_ss(src[2*i+1] * gain[i] + dither[i]));
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
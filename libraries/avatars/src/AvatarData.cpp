@@ -282,16 +282,82 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dro
     return avatarByteArray;
 }
 
+AvatarDataPacket::HasFlags AvatarData::getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime,
+                                                      bool dropFaceTracking) const {
+    bool sendAll = (dataDetail == SendAllData);
+    bool sendMinimum = (dataDetail == MinimumData);
+    bool sendPALMinimum = (dataDetail == PALMinimum);
+
+    lazyInitHeadData();
+
+    bool hasAvatarGlobalPosition = true; // always include global position
+    bool hasAvatarOrientation = false;
+    bool hasAvatarBoundingBox = false;
+    bool hasAvatarScale = false;
+    bool hasLookAtPosition = false;
+    bool hasAudioLoudness = false;
+    bool hasSensorToWorldMatrix = false;
+    bool hasJointData = false;
+    bool hasJointDefaultPoseFlags = false;
+    bool hasAdditionalFlags = false;
+
+    // local position, and parent info only apply to avatars that are parented. The local position
+    // and the parent info can change independently though, so we track their "changed since"
+    // separately
+    bool hasParentInfo = false;
+    bool hasAvatarLocalPosition = false;
+    bool hasHandControllers = false;
+
+    bool hasFaceTrackerInfo = false;
+
+    if (sendPALMinimum) {
+        hasAudioLoudness = true;
+    } else {
+        hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
+        hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
+        hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
+        hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
+        hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
+        hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
+        hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
+        hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
+        hasAvatarLocalPosition = hasParent() && (sendAll ||
+            tranlationChangedSince(lastSentTime) ||
+            parentInfoChangedSince(lastSentTime));
+        hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
+        hasFaceTrackerInfo = !dropFaceTracking && getHasScriptedBlendshapes() &&
+            (sendAll || faceTrackerInfoChangedSince(lastSentTime));
+        hasJointData = !sendMinimum;
+        hasJointDefaultPoseFlags = hasJointData;
+    }
+
+    return
+        (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
+        | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
+        | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
+        | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
+        | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
+        | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
+        | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
+        | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
+        | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
+        | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
+        | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
+        | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
+        | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+}
+
 QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime,
                                    const QVector<JointData>& lastSentJointData, AvatarDataPacket::SendStatus& sendStatus,
                                    bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
                                    QVector<JointData>* sentJointDataOut,
-                                   int maxDataSize, AvatarDataRate* outboundDataRateOut) const {
+                                   int maxDataSize, AvatarDataRate* outboundDataRateOut,
+                                   AvatarJointDeltas::SendState* jointDeltas) const {
 
     bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
-    bool sendMinimum = (dataDetail == MinimumData);
-    bool sendPALMinimum = (dataDetail == PALMinimum);
 
     lazyInitHeadData();
     ASSERT(maxDataSize == 0 || (size_t)maxDataSize >= AvatarDataPacket::MIN_BULK_PACKET_SIZE);
@@ -341,67 +407,11 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     if (sendStatus.itemFlags == 0) {
         // New avatar ...
-        bool hasAvatarGlobalPosition = true; // always include global position
-        bool hasAvatarOrientation = false;
-        bool hasAvatarBoundingBox = false;
-        bool hasAvatarScale = false;
-        bool hasLookAtPosition = false;
-        bool hasAudioLoudness = false;
-        bool hasSensorToWorldMatrix = false;
-        bool hasJointData = false;
-        bool hasJointDefaultPoseFlags = false;
-        bool hasAdditionalFlags = false;
-
-        // local position, and parent info only apply to avatars that are parented. The local position
-        // and the parent info can change independently though, so we track their "changed since"
-        // separately
-        bool hasParentInfo = false;
-        bool hasAvatarLocalPosition = false;
-        bool hasHandControllers = false;
-
-        bool hasFaceTrackerInfo = false;
-
-        if (sendPALMinimum) {
-            hasAudioLoudness = true;
-        } else {
-            hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
-            hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
-            hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
-            hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
-            hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
-            hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
-            hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
-            hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
-            hasAvatarLocalPosition = hasParent() && (sendAll ||
-                tranlationChangedSince(lastSentTime) ||
-                parentInfoChangedSince(lastSentTime));
-            hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
-            hasFaceTrackerInfo = !dropFaceTracking && getHasScriptedBlendshapes() &&
-                (sendAll || faceTrackerInfoChangedSince(lastSentTime));
-            hasJointData = !sendMinimum;
-            hasJointDefaultPoseFlags = hasJointData;
-        }
-
-        wantedFlags =
-            (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
-            | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
-            | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
-            | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
-            | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
-            | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
-            | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
-            | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
-            | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
-            | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
-            | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
-            | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
-            | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
-
-            sendStatus.itemFlags = wantedFlags;
-            sendStatus.rotationsSent = 0;
-            sendStatus.translationsSent = 0;
+        wantedFlags = getWantedFlags(dataDetail, lastSentTime, dropFaceTracking);
+
+        sendStatus.itemFlags = wantedFlags;
+        sendStatus.rotationsSent = 0;
+        sendStatus.translationsSent = 0;
     } else {  // Continuing avatar ...
         wantedFlags = sendStatus.itemFlags;
         if (wantedFlags & AvatarDataPacket::PACKET_HAS_GRAB_JOINTS) {
@@ -437,6 +447,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     const size_t byteArraySize = AvatarDataPacket::MAX_CONSTANT_HEADER_SIZE + NUM_BYTES_RFC4122_UUID +
         AvatarDataPacket::maxFaceTrackerInfoSize(_headData->getBlendshapeCoefficients().size()) +
         AvatarDataPacket::maxJointDataSize(_jointData.size()) +
+        (jointDeltas ? AvatarJointDeltas::maxSectionSize(_jointData.size()) : 0) +
         AvatarDataPacket::maxJointDefaultPoseFlagsSize(_jointData.size()) +
         AvatarDataPacket::FAR_GRAB_JOINTS_SIZE;
 
@@ -695,120 +706,149 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         auto startSection = destinationBuffer;
 
-        // compute maxTranslationDimension before we send any joint data.
-        float maxTranslationDimension = 0.001f;
-        for (int i = sendStatus.translationsSent; i < numJoints; ++i) {
-            const JointData& data = jointData[i];
-            if (!data.translationIsDefaultPose) {
-                maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
-                maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
-                maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
+        float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
+        float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
+
+        // a delta coded section can't be split across packets, so if it doesn't fit we send the joints as usual
+        bool sentJointDeltas = false;
+        if (jointDeltas && sendStatus.rotationsSent == 0 && sendStatus.translationsSent == 0) {
+            int sectionSize = AvatarJointDeltas::encode(jointData, *jointDeltas, cullSmallChanges, minRotationDOT,
+                                                        minTranslation, destinationBuffer, (int)(packetEnd - destinationBuffer),
+                                                        sentJointDataOut);
+            if (sectionSize >= 0) {
+                destinationBuffer += sectionSize;
+                includedFlags |= AvatarDataPacket::PACKET_HAS_JOINT_DELTAS;
+                sendStatus.rotationsSent = numJoints;
+                sendStatus.translationsSent = numJoints;
+                sentJointDeltas = true;
             }
         }
 
-        // joint rotation data
-        *destinationBuffer++ = (uint8_t)numJoints;
+        if (!sentJointDeltas) {
+            // compute maxTranslationDimension before we send any joint data.
+            float maxTranslationDimension = 0.001f;
+            for (int i = sendStatus.translationsSent; i < numJoints; ++i) {
+                const JointData& data = jointData[i];
+                if (!data.translationIsDefaultPose) {
+                    maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
+                    maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
+                    maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
+                }
+            }
+
+            // joint rotation data
+            *destinationBuffer++ = (uint8_t)numJoints;
 
-        unsigned char* validityPosition = destinationBuffer;
-        memset(validityPosition, 0, jointBitVectorSize);
+            unsigned char* validityPosition = destinationBuffer;
+            memset(validityPosition, 0, jointBitVectorSize);
 
 #ifdef WANT_DEBUG
-        int rotationSentCount = 0;
-        unsigned char* beforeRotations = destinationBuffer;
+            int rotationSentCount = 0;
+            unsigned char* beforeRotations = destinationBuffer;
 #endif
 
-        destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
-
-        // sentJointDataOut and lastSentJointData might be the same vector
-        if (sentJointDataOut) {
-            sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
-        }
-        const JointData *const joints = jointData.data();
-        JointData *const sentJoints = sentJointDataOut ? sentJointDataOut->data() : nullptr;
-
-        float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
-
-        int i = sendStatus.rotationsSent;
-        for (; i < numJoints; ++i) {
-            const JointData& data = joints[i];
-            const JointData& last = lastSentJointData[i];
+            destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
 
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
-                if (!data.rotationIsDefaultPose) {
-                    // The dot product for larger rotations is a lower number,
-                    // so if the dot() is less than the value, then the rotation is a larger angle of rotation
-                    if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
-                        || (cullSmallChanges && fabsf(glm::dot(last.rotation, data.rotation)) < minRotationDOT)) {
-                        validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
+            // sentJointDataOut and lastSentJointData might be the same vector
+            if (sentJointDataOut) {
+                sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
+            }
+            const JointData *const joints = jointData.data();
+            JointData *const sentJoints = sentJointDataOut ? sentJointDataOut->data() : nullptr;
+
+            int i = sendStatus.rotationsSent;
+            for (; i < numJoints; ++i) {
+                const JointData& data = joints[i];
+                const JointData& last = lastSentJointData[i];
+
+                if (packetEnd - destinationBuffer >= minSizeForJoint) {
+                    if (!data.rotationIsDefaultPose) {
+                        // The dot product for larger rotations is a lower number,
+                        // so if the dot() is less than the value, then the rotation is a larger angle of rotation
+                        if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
+                            || (cullSmallChanges && fabsf(glm::dot(last.rotation, data.rotation)) < minRotationDOT)) {
+                            validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
-                        rotationSentCount++;
+                            rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                            destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
 
-                        if (sentJoints) {
-                            sentJoints[i].rotation = data.rotation;
+                            if (sentJoints) {
+                                sentJoints[i].rotation = data.rotation;
+                            }
                         }
                     }
+                } else {
+                    break;
                 }
-            } else {
-                break;
-            }
 
-            if (sentJoints) {
-                sentJoints[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
-            }
+                if (sentJoints) {
+                    sentJoints[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
+                }
 
-        }
-        sendStatus.rotationsSent = i;
+            }
+            sendStatus.rotationsSent = i;
 
-        // joint translation data
-        validityPosition = destinationBuffer;
+            // joint translation data
+            validityPosition = destinationBuffer;
 
 #ifdef WANT_DEBUG
-        int translationSentCount = 0;
-        unsigned char* beforeTranslations = destinationBuffer;
+            int translationSentCount = 0;
+            unsigned char* beforeTranslations = destinationBuffer;
 #endif
 
-        memset(destinationBuffer, 0, jointBitVectorSize);
-        destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
+            memset(destinationBuffer, 0, jointBitVectorSize);
+            destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
 
-        // write maxTranslationDimension
-        AVATAR_MEMCPY(maxTranslationDimension);
+            // write maxTranslationDimension
+            AVATAR_MEMCPY(maxTranslationDimension);
 
-        float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
-
-        i = sendStatus.translationsSent;
-        for (; i < numJoints; ++i) {
-            const JointData& data = joints[i];
-            const JointData& last = lastSentJointData[i];
+            i = sendStatus.translationsSent;
+            for (; i < numJoints; ++i) {
+                const JointData& data = joints[i];
+                const JointData& last = lastSentJointData[i];
 
-            // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
-                if (!data.translationIsDefaultPose) {
-                    if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
-                        || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
-                        validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
+                // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
+                if (packetEnd - destinationBuffer >= minSizeForJoint) {
+                    if (!data.translationIsDefaultPose) {
+                        if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
+                            || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
+                            validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
-                        translationSentCount++;
+                            translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                            destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
+                                                                                   TRANSLATION_COMPRESSION_RADIX);
 
-                        if (sentJoints) {
-                            sentJoints[i].translation = data.translation;
+                            if (sentJoints) {
+                                sentJoints[i].translation = data.translation;
+                            }
                         }
                     }
+                } else {
+                    break;
+                }
+
+                if (sentJoints) {
+                    sentJoints[i].translationIsDefaultPose = data.translationIsDefaultPose;
                 }
-            } else {
-                break;
-            }
 
-            if (sentJoints) {
-                sentJoints[i].translationIsDefaultPose = data.translationIsDefaultPose;
             }
+            sendStatus.translationsSent = i;
 
+#ifdef WANT_DEBUG
+            if (sendAll) {
+                qCDebug(avatars) << "AvatarData::toByteArray" << cullSmallChanges << sendAll
+                    << "rotations:" << rotationSentCount << "translations:" << translationSentCount
+                    << "largest:" << maxTranslationDimension
+                    << "size:"
+                    << (beforeRotations - startPosition) << "+"
+                    << (beforeTranslations - beforeRotations) << "+"
+                    << (destinationBuffer - beforeTranslations) << "="
+                    << (destinationBuffer - startPosition);
+            }
+#endif
         }
-        sendStatus.translationsSent = i;
 
         IF_AVATAR_SPACE(PACKET_HAS_GRAB_JOINTS, sizeof (AvatarDataPacket::FarGrabJoints)) {
             // the far-grab joints may range further than 3 meters, so we can't use packFloatVec3ToSignedTwoByteFixed etc
@@ -839,19 +879,6 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             }
         }
 
-#ifdef WANT_DEBUG
-        if (sendAll) {
-            qCDebug(avatars) << "AvatarData::toByteArray" << cullSmallChanges << sendAll
-                << "rotations:" << rotationSentCount << "translations:" << translationSentCount
-                << "largest:" << maxTranslationDimension
-                << "size:"
-                << (beforeRotations - startPosition) << "+"
-                << (beforeTranslations - beforeRotations) << "+"
-                << (destinationBuffer - beforeTranslations) << "="
-                << (destinationBuffer - startPosition);
-        }
-#endif
-
         if (sendStatus.rotationsSent != numJoints || sendStatus.translationsSent != numJoints) {
             extraReturnedFlags |= AvatarDataPacket::PACKET_HAS_JOINT_DATA;
         }
@@ -997,6 +1024,7 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     bool hasJointData             = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
     bool hasJointDefaultPoseFlags = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS);
     bool hasGrabJoints            = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_GRAB_JOINTS);
+    bool hasJointDeltas           = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DELTAS);
 
     quint64 now = usecTimestampNow();
 
@@ -1323,94 +1351,130 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     if (hasJointData) {
         auto startSection = sourceBuffer;
 
-        PACKET_READ_CHECK(NumJoints, sizeof(uint8_t));
-        int numJoints = *sourceBuffer++;
-        const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
-        PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
-
-        int numValidJointRotations = 0;
-        QVector<bool> validRotations;
-        validRotations.resize(numJoints);
-        { // rotation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
+        if (hasJointDeltas) {
+            AvatarJointDeltas::PacketID packetID;
+            const AvatarJointDeltas::Frame* frame;
+            int sectionSize = AvatarJointDeltas::decode(sourceBuffer, (int)(endPosition - sourceBuffer),
+                                                        _receivedJointFrames, packetID, frame);
+            if (sectionSize < 0) {
+                if (shouldLogError(now)) {
+                    qCWarning(avatars) << "AvatarData packet has malformed joint deltas, " << getSessionUUID();
                 }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointRotations;
+                return buffer.size();
+            }
+            sourceBuffer += sectionSize;
+            _jointDeltasPacketID = packetID;
+
+            // without the baseline these deltas were coded against there is nothing to apply, the ack for this
+            // packet asks the mixer to drop its baselines for this avatar and send every joint again
+            _jointDeltasBaselineMissing = !frame;
+            if (frame) {
+                QWriteLocker writeLock(&_jointDataLock);
+                _jointData.resize((int)frame->size());
+                for (int i = 0; i < _jointData.size(); i++) {
+                    JointData& data = _jointData[i];
+                    const AvatarJointDeltas::QuantizedJoint& joint = (*frame)[i];
+                    if (joint.hasRotation) {
+                        data.rotation = AvatarJointDeltas::dequantizeRotation(joint);
+                        data.rotationIsDefaultPose = false;
+                    }
+                    if (joint.hasTranslation) {
+                        data.translation = AvatarJointDeltas::dequantizeTranslation(joint);
+                        data.translationIsDefaultPose = false;
+                    }
+                }
+                _hasNewJointData = true;
+            }
+        } else {
+            PACKET_READ_CHECK(NumJoints, sizeof(uint8_t));
+            int numJoints = *sourceBuffer++;
+            const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
+            PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
+
+            int numValidJointRotations = 0;
+            QVector<bool> validRotations;
+            validRotations.resize(numJoints);
+            { // rotation validity bits
+                unsigned char validity = 0;
+                int validityBit = 0;
+                for (int i = 0; i < numJoints; i++) {
+                    if (validityBit == 0) {
+                        validity = *sourceBuffer++;
+                    }
+                    bool valid = (bool)(validity & (1 << validityBit));
+                    if (valid) {
+                        ++numValidJointRotations;
+                    }
+                    validRotations[i] = valid;
+                    validityBit = (validityBit + 1) % BITS_IN_BYTE;
                 }
-                validRotations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
             }
-        }
 
-        // each joint rotation is stored in 6 bytes.
-        QWriteLocker writeLock(&_jointDataLock);
-        _jointData.resize(numJoints);
+            // each joint rotation is stored in 6 bytes.
+            QWriteLocker writeLock(&_jointDataLock);
+            _jointData.resize(numJoints);
 
-        const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
-                _hasNewJointData = true;
-                data.rotationIsDefaultPose = false;
+            const int COMPRESSED_QUATERNION_SIZE = 6;
+            PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
+            for (int i = 0; i < numJoints; i++) {
+                JointData& data = _jointData[i];
+                if (validRotations[i]) {
+                    sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                    _hasNewJointData = true;
+                    data.rotationIsDefaultPose = false;
+                }
             }
-        }
 
-        PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
+            PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
+
+            // get translation validity bits -- these indicate which translations were packed
+            int numValidJointTranslations = 0;
+            QVector<bool> validTranslations;
+            validTranslations.resize(numJoints);
+            { // translation validity bits
+                unsigned char validity = 0;
+                int validityBit = 0;
+                for (int i = 0; i < numJoints; i++) {
+                    if (validityBit == 0) {
+                        validity = *sourceBuffer++;
+                    }
+                    bool valid = (bool)(validity & (1 << validityBit));
+                    if (valid) {
+                        ++numValidJointTranslations;
+                    }
+                    validTranslations[i] = valid;
+                    validityBit = (validityBit + 1) % BITS_IN_BYTE;
+                }
+            } // 1 + bytesOfValidity bytes
+
+            // read maxTranslationDimension
+            float maxTranslationDimension;
+            PACKET_READ_CHECK(JointMaxTranslationDimension, sizeof(float));
+            memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
+            sourceBuffer += sizeof(float);
+
+            // each joint translation component is stored in 6 bytes.
+            const int COMPRESSED_TRANSLATION_SIZE = 6;
+            PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
 
-        // get translation validity bits -- these indicate which translations were packed
-        int numValidJointTranslations = 0;
-        QVector<bool> validTranslations;
-        validTranslations.resize(numJoints);
-        { // translation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
             for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointTranslations;
+                JointData& data = _jointData[i];
+                if (validTranslations[i]) {
+                    sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+                    data.translation *= maxTranslationDimension;
+                    _hasNewJointData = true;
+                    data.translationIsDefaultPose = false;
                 }
-                validTranslations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        } // 1 + bytesOfValidity bytes
-
-        // read maxTranslationDimension
-        float maxTranslationDimension;
-        PACKET_READ_CHECK(JointMaxTranslationDimension, sizeof(float));
-        memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
-        sourceBuffer += sizeof(float);
-
-        // each joint translation component is stored in 6 bytes.
-        const int COMPRESSED_TRANSLATION_SIZE = 6;
-        PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
-
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                data.translation *= maxTranslationDimension;
-                _hasNewJointData = true;
-                data.translationIsDefaultPose = false;
             }
-        }
 
 #ifdef WANT_DEBUG
-        if (numValidJointRotations > 15) {
-            qCDebug(avatars) << "RECEIVING -- rotations:" << numValidJointRotations
-                << "translations:" << numValidJointTranslations
-                << "size:" << (int)(sourceBuffer - startPosition);
-        }
+            if (numValidJointRotations > 15) {
+                qCDebug(avatars) << "RECEIVING -- rotations:" << numValidJointRotations
+                    << "translations:" << numValidJointTranslations
+                    << "size:" << (int)(sourceBuffer - startPosition);
+            }
 #endif
+        }
         int numBytesRead = sourceBuffer - startSection;
         _jointDataRate.increment(numBytesRead);
         _jointDataUpdateRate.increment();
@@ -51,6 +51,7 @@
 #include <udt/SequenceNumber.h>
 
 #include "AABox.h"
+#include "AvatarJointDeltas.h"
 #include "AvatarTraits.h"
 #include "HeadData.h"
 #include "PathUtils.h"
@@ -205,6 +206,7 @@ namespace AvatarDataPacket {
     const HasFlags PACKET_HAS_JOINT_DATA               = 1U << 12;
     const HasFlags PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS = 1U << 13;
     const HasFlags PACKET_HAS_GRAB_JOINTS              = 1U << 14;
+    const HasFlags PACKET_HAS_JOINT_DELTAS             = 1U << 15; // joint data is an AvatarJointDeltas section
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
     using SixByteQuat = uint8_t[6];
@@ -620,9 +622,14 @@ public:
 
     virtual QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false);
 
+    // the items toByteArray includes for a new avatar, before any are left out for lack of space
+    AvatarDataPacket::HasFlags getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const;
+
+    // if jointDeltas is given, the joints are delta coded against what that listener last acked (see AvatarJointDeltas.h)
     virtual QByteArray toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
         AvatarDataPacket::SendStatus& sendStatus, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
-        QVector<JointData>* sentJointDataOut, int maxDataSize = 0, AvatarDataRate* outboundDataRateOut = nullptr) const;
+        QVector<JointData>* sentJointDataOut, int maxDataSize = 0, AvatarDataRate* outboundDataRateOut = nullptr,
+        AvatarJointDeltas::SendState* jointDeltas = nullptr) const;
 
     virtual void doneEncoding(bool cullSmallChanges);
 
@@ -634,6 +641,11 @@ public:
     /// \return number of bytes parsed
     virtual int parseDataFromBuffer(const QByteArray& buffer);
 
+    // ID of the packet the last parsed joint deltas came in, which the mixer wants acked, -1 if there were none
+    int takeJointDeltasPacketID() { int packetID = _jointDeltasPacketID; _jointDeltasPacketID = -1; return packetID; }
+    // true if the last parsed joint deltas were coded against a frame we don't have, so the mixer must send keyframes
+    bool takeJointDeltasBaselineMissing() { bool missing = _jointDeltasBaselineMissing; _jointDeltasBaselineMissing = false; return missing; }
+
     virtual void setCollisionWithOtherAvatarsFlags() {};
 
     // Body Rotation (degrees)
@@ -1710,6 +1722,10 @@ protected:
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
     mutable QReadWriteLock _jointDataLock;
 
+    AvatarJointDeltas::FrameHistory _receivedJointFrames; // baselines the mixer may code joint deltas against
+    int _jointDeltasPacketID { -1 };
+    bool _jointDeltasBaselineMissing { false };
+
     // key state
     KeyState _keyState;
 
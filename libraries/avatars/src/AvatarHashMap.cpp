@@ -246,6 +246,20 @@ void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> mess
     while (message->getBytesLeftToRead()) {
         parseAvatarData(message, sendingNode);
     }
+
+    if (_jointDeltasPacketIDToAck >= 0) {
+        // let the mixer know it can code joints against the frames in this packet, except for the avatars
+        // whose deltas had no baseline here, which it has to send every joint of again
+        auto ackPacket = NLPacket::create(PacketType::BulkAvatarDataAck, sizeof(AvatarJointDeltas::PacketID) +
+                                          _jointDeltasAvatarsToReset.size() * NUM_BYTES_RFC4122_UUID);
+        ackPacket->writePrimitive((AvatarJointDeltas::PacketID)_jointDeltasPacketIDToAck);
+        for (const auto& avatarID : _jointDeltasAvatarsToReset) {
+            ackPacket->write(avatarID.toRfc4122());
+        }
+        DependencyManager::get<NodeList>()->sendPacket(std::move(ackPacket), *sendingNode);
+        _jointDeltasPacketIDToAck = -1;
+        _jointDeltasAvatarsToReset.clear();
+    }
 }
 
 AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -276,6 +290,14 @@ AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessag
         int bytesRead = avatar->parseDataFromBuffer(byteArray);
         message->seek(positionBeforeRead + bytesRead);
         _replicas.parseDataFromBuffer(sessionUUID, byteArray);
+
+        int jointDeltasPacketID = avatar->takeJointDeltasPacketID();
+        if (jointDeltasPacketID >= 0) {
+            _jointDeltasPacketIDToAck = jointDeltasPacketID;
+            if (avatar->takeJointDeltasBaselineMissing()) {
+                _jointDeltasAvatarsToReset.push_back(sessionUUID);
+            }
+        }
         
 
         return avatar;
@@ -288,6 +310,15 @@ AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessag
         AvatarData dummyData;
         int bytesRead = dummyData.parseDataFromBuffer(byteArray);
         message->seek(positionBeforeRead + bytesRead);
+
+        // the packet still needs acking for the other avatars in it
+        int jointDeltasPacketID = dummyData.takeJointDeltasPacketID();
+        if (jointDeltasPacketID >= 0) {
+            _jointDeltasPacketIDToAck = jointDeltasPacketID;
+            if (dummyData.takeJointDeltasBaselineMissing()) {
+                _jointDeltasAvatarsToReset.push_back(sessionUUID);
+            }
+        }
         return std::make_shared<AvatarData>();
     }
 }
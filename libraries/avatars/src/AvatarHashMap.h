@@ -244,6 +244,8 @@ protected:
 
 private:
     QUuid _lastOwnerSessionUUID;
+    int _jointDeltasPacketIDToAck { -1 }; // ID of the BulkAvatarData packet being processed, if it had joint deltas
+    QVector<QUuid> _jointDeltasAvatarsToReset; // avatars in that packet whose joint deltas had no baseline here
 };
 
 #endif // hifi_AvatarHashMap_h
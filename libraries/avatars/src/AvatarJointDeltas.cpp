@@ -0,0 +1,480 @@
+//
+//  AvatarJointDeltas.cpp
+//  libraries/avatars/src
+//
+//  Created by High Fidelity on 2019-06-18.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarJointDeltas.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace AvatarJointDeltas {
+
+namespace {
+    const int MAX_ROTATION_VARINT_BYTES = 1 + 3 * 3;
+    const int MAX_TRANSLATION_VARINT_BYTES = 3 * 5;
+    const int32_t MAX_TRANSLATION_COMPONENT = 1 << 30;
+
+    // keep dropping the same component until another one is clearly larger
+    const float LARGEST_COMPONENT_HYSTERESIS = 0.9f;
+
+    // the low bit of the first varint of a rotation says whether it is absolute, in which case the rest of that
+    // varint is the dropped component and three more varints follow, otherwise the rest is the first delta
+    const uint32_t ABSOLUTE_ROTATION_BIT = 0x1;
+
+    int bitVectorSize(int numBits) {
+        return (numBits + 7) / 8;
+    }
+
+    uint32_t zigzag(int32_t value) {
+        return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    }
+
+    int32_t unzigzag(uint32_t value) {
+        return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+    }
+
+    bool writeVarint(uint32_t value, unsigned char*& cursor, const unsigned char* end) {
+        do {
+            if (cursor >= end) {
+                return false;
+            }
+            unsigned char byte = value & 0x7f;
+            value >>= 7;
+            *cursor++ = byte | (value ? 0x80 : 0);
+        } while (value);
+        return true;
+    }
+
+    bool readVarint(uint32_t& value, const unsigned char*& cursor, const unsigned char* end) {
+        value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (cursor >= end) {
+                return false;
+            }
+            unsigned char byte = *cursor++;
+            value |= (uint32_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // base is the joint as the listener has it, the rotation is absolute if base has none
+    bool writeRotation(const QuantizedJoint& joint, const QuantizedJoint& base,
+                       unsigned char*& cursor, const unsigned char* end) {
+        if (!base.hasRotation || base.largestComponent != joint.largestComponent) {
+            return writeVarint(((uint32_t)joint.largestComponent << 1) | ABSOLUTE_ROTATION_BIT, cursor, end)
+                && writeVarint(joint.rotation[0], cursor, end)
+                && writeVarint(joint.rotation[1], cursor, end)
+                && writeVarint(joint.rotation[2], cursor, end);
+        }
+
+        uint32_t values[3];
+        for (int i = 0; i < 3; ++i) {
+            values[i] = zigzag((int32_t)joint.rotation[i] - (int32_t)base.rotation[i]);
+        }
+        return writeVarint(values[0] << 1, cursor, end) && writeVarint(values[1], cursor, end)
+            && writeVarint(values[2], cursor, end);
+    }
+
+    // joint holds the baseline on the way in, it is only checked if the baseline is known
+    bool readRotation(QuantizedJoint& joint, bool knownBaseline, const unsigned char*& cursor, const unsigned char* end) {
+        uint32_t first;
+        if (!readVarint(first, cursor, end)) {
+            return false;
+        }
+
+        uint32_t values[3];
+        if (first & ABSOLUTE_ROTATION_BIT) {
+            uint32_t largestComponent = first >> 1;
+            if (largestComponent > 3 || !readVarint(values[0], cursor, end) ||
+                !readVarint(values[1], cursor, end) || !readVarint(values[2], cursor, end)) {
+                return false;
+            }
+            for (int i = 0; i < 3; ++i) {
+                if (values[i] > MAX_ROTATION_COMPONENT) {
+                    return false;
+                }
+                joint.rotation[i] = (uint16_t)values[i];
+            }
+            joint.largestComponent = (uint8_t)largestComponent;
+        } else {
+            values[0] = first >> 1;
+            if (!readVarint(values[1], cursor, end) || !readVarint(values[2], cursor, end)) {
+                return false;
+            }
+            if (knownBaseline) {
+                if (!joint.hasRotation) {
+                    return false;
+                }
+                for (int i = 0; i < 3; ++i) {
+                    int32_t component = (int32_t)joint.rotation[i] + unzigzag(values[i]);
+                    if (component < 0 || component > (int32_t)MAX_ROTATION_COMPONENT) {
+                        return false;
+                    }
+                    joint.rotation[i] = (uint16_t)component;
+                }
+            }
+        }
+
+        joint.hasRotation = true;
+        return true;
+    }
+
+    bool writeTranslation(const QuantizedJoint& joint, const QuantizedJoint& base,
+                          unsigned char*& cursor, const unsigned char* end) {
+        for (int i = 0; i < 3; ++i) {
+            int32_t baseComponent = base.hasTranslation ? base.translation[i] : 0;
+            if (!writeVarint(zigzag(joint.translation[i] - baseComponent), cursor, end)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readTranslation(QuantizedJoint& joint, bool knownBaseline, const unsigned char*& cursor, const unsigned char* end) {
+        for (int i = 0; i < 3; ++i) {
+            uint32_t value;
+            if (!readVarint(value, cursor, end)) {
+                return false;
+            }
+            int64_t baseComponent = (knownBaseline && joint.hasTranslation) ? joint.translation[i] : 0;
+            int64_t component = baseComponent + unzigzag(value);
+            if (knownBaseline && (component < -MAX_TRANSLATION_COMPONENT || component > MAX_TRANSLATION_COMPONENT)) {
+                return false;
+            }
+            joint.translation[i] = (int32_t)component;
+        }
+        joint.hasTranslation = true;
+        return true;
+    }
+
+    bool sameRotation(const QuantizedJoint& a, const QuantizedJoint& b) {
+        return a.largestComponent == b.largestComponent && a.rotation[0] == b.rotation[0]
+            && a.rotation[1] == b.rotation[1] && a.rotation[2] == b.rotation[2];
+    }
+
+    bool sameTranslation(const QuantizedJoint& a, const QuantizedJoint& b) {
+        return a.translation[0] == b.translation[0] && a.translation[1] == b.translation[1]
+            && a.translation[2] == b.translation[2];
+    }
+}
+
+size_t maxSectionSize(size_t numJoints) {
+    return HEADER_SIZE + 2 * bitVectorSize((int)numJoints) +
+        numJoints * (MAX_ROTATION_VARINT_BYTES + MAX_TRANSLATION_VARINT_BYTES);
+}
+
+void quantizeRotation(const glm::quat& rotation, int preferredLargest, QuantizedJoint& joint) {
+    int largestComponent = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (fabsf(rotation[i]) > fabsf(rotation[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+    if (preferredLargest >= 0 &&
+        fabsf(rotation[preferredLargest]) >= LARGEST_COMPONENT_HYSTERESIS * fabsf(rotation[largestComponent])) {
+        largestComponent = preferredLargest;
+    }
+
+    // as in packOrientationQuatToSixBytes() the dropped component is always negative
+    glm::quat q = rotation[largestComponent] > 0.0f ? -rotation : rotation;
+
+    for (int i = 0, j = 0; i < 4; ++i) {
+        if (i != largestComponent) {
+            float value = glm::clamp((q[i] + ROTATION_COMPONENT_RANGE) / (2.0f * ROTATION_COMPONENT_RANGE), 0.0f, 1.0f);
+            joint.rotation[j++] = (uint16_t)(value * MAX_ROTATION_COMPONENT + 0.5f);
+        }
+    }
+    joint.largestComponent = (uint8_t)largestComponent;
+}
+
+glm::quat dequantizeRotation(const QuantizedJoint& joint) {
+    float components[3];
+    float sumOfSquares = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        components[i] = ((float)joint.rotation[i] / MAX_ROTATION_COMPONENT) * (2.0f * ROTATION_COMPONENT_RANGE)
+            - ROTATION_COMPONENT_RANGE;
+        sumOfSquares += components[i] * components[i];
+    }
+
+    glm::quat rotation;
+    for (int i = 0, j = 0; i < 4; ++i) {
+        rotation[i] = (i == joint.largestComponent) ? -sqrtf(std::max(1.0f - sumOfSquares, 0.0f)) : components[j++];
+    }
+    return glm::normalize(rotation);
+}
+
+void quantizeTranslation(const glm::vec3& translation, QuantizedJoint& joint) {
+    for (int i = 0; i < 3; ++i) {
+        float value = glm::clamp(translation[i] / TRANSLATION_QUANTUM,
+                                 -(float)MAX_TRANSLATION_COMPONENT, (float)MAX_TRANSLATION_COMPONENT);
+        joint.translation[i] = (int32_t)roundf(value);
+    }
+}
+
+glm::vec3 dequantizeTranslation(const QuantizedJoint& joint) {
+    return glm::vec3(joint.translation[0], joint.translation[1], joint.translation[2]) * TRANSLATION_QUANTUM;
+}
+
+void AckWindow::ack(PacketID packetID) {
+    const int WINDOW_SIZE = 64;
+
+    if (_bits == 0) {
+        _newest = packetID;
+        _bits = 1;
+        return;
+    }
+
+    int16_t age = (int16_t)(PacketID)(_newest - packetID);
+    if (age < 0) {
+        // a newer packet, slide the window forward
+        _bits = (-age >= WINDOW_SIZE) ? 0 : (_bits << -age);
+        _bits |= 1;
+        _newest = packetID;
+    } else if (age < WINDOW_SIZE) {
+        _bits |= (uint64_t)1 << age;
+    }
+}
+
+bool AckWindow::isAcked(PacketID packetID) const {
+    int16_t age = (int16_t)(PacketID)(_newest - packetID);
+    return _bits != 0 && age >= 0 && age < 64 && (_bits & ((uint64_t)1 << age));
+}
+
+const Frame* FrameHistory::find(PacketID packetID) const {
+    for (const auto& entry : _entries) {
+        if (entry.valid && entry.packetID == packetID) {
+            return &entry.frame;
+        }
+    }
+    return nullptr;
+}
+
+const Frame* FrameHistory::findBaseline(PacketID packetID, const AckWindow& acks, PacketID& baselineID) const {
+    const Frame* baseline = nullptr;
+    int baselineAge = MAX_BASELINE_AGE + 1;
+
+    for (const auto& entry : _entries) {
+        int age = (PacketID)(packetID - entry.packetID);
+        if (entry.valid && age > 0 && age < baselineAge && acks.isAcked(entry.packetID)) {
+            baseline = &entry.frame;
+            baselineAge = age;
+            baselineID = entry.packetID;
+        }
+    }
+    return baseline;
+}
+
+const Frame& FrameHistory::commit(PacketID packetID) {
+    Entry& entry = _entries[_oldest];
+    entry.packetID = packetID;
+    entry.valid = true;
+    std::swap(entry.frame, _next);
+
+    _oldest = (_oldest + 1) % NUM_FRAMES;
+    return entry.frame;
+}
+
+void FrameHistory::clear() {
+    for (auto& entry : _entries) {
+        entry.valid = false;
+    }
+}
+
+int encode(const QVector<JointData>& joints, SendState& sendState, bool cullSmallChanges,
+           float minRotationDOT, float minTranslation, unsigned char* buffer, int capacity,
+           QVector<JointData>* sentJointsOut) {
+    assert(sendState.acks && sendState.sentFrames);
+
+    const int numJoints = joints.size();
+    assert(numJoints <= 255);
+    const int jointBitVectorSize = bitVectorSize(numJoints);
+    if (capacity < HEADER_SIZE + 2 * jointBitVectorSize) {
+        return -1;
+    }
+
+    PacketID baselineID = 0;
+    const Frame* baseline = nullptr;
+    if (!sendState.keyframe) {
+        baseline = sendState.sentFrames->findBaseline(sendState.packetID, *sendState.acks, baselineID);
+        if (baseline && (int)baseline->size() != numJoints) {
+            baseline = nullptr;
+        }
+    }
+
+    // the new frame starts as a copy of the baseline, and only the joints we write differ from it
+    Frame& frame = sendState.sentFrames->next();
+    if (baseline) {
+        frame = *baseline;
+    } else {
+        frame.assign(numJoints, QuantizedJoint());
+    }
+
+    unsigned char* cursor = buffer;
+    const unsigned char* const end = buffer + capacity;
+
+    *cursor++ = (uint8_t)numJoints;
+    memcpy(cursor, &sendState.packetID, sizeof(PacketID));
+    cursor += sizeof(PacketID);
+    *cursor++ = baseline ? (uint8_t)(PacketID)(sendState.packetID - baselineID) : 0;
+
+    unsigned char* rotationBits = cursor;
+    memset(rotationBits, 0, jointBitVectorSize);
+    cursor += jointBitVectorSize;
+
+    for (int i = 0; i < numJoints; ++i) {
+        const JointData& data = joints[i];
+        if (data.rotationIsDefaultPose) {
+            continue;
+        }
+
+        QuantizedJoint& joint = frame[i];
+        if (joint.hasRotation && cullSmallChanges &&
+            fabsf(glm::dot(dequantizeRotation(joint), data.rotation)) >= minRotationDOT) {
+            continue;
+        }
+
+        QuantizedJoint quantized = joint;
+        quantizeRotation(data.rotation, joint.hasRotation ? joint.largestComponent : -1, quantized);
+        if (joint.hasRotation && sameRotation(quantized, joint)) {
+            continue;
+        }
+
+        if (!writeRotation(quantized, joint, cursor, end)) {
+            return -1;
+        }
+        rotationBits[i / 8] |= 1 << (i % 8);
+        quantized.hasRotation = true;
+        joint = quantized;
+    }
+
+    if (end - cursor < jointBitVectorSize) {
+        return -1;
+    }
+    unsigned char* translationBits = cursor;
+    memset(translationBits, 0, jointBitVectorSize);
+    cursor += jointBitVectorSize;
+
+    for (int i = 0; i < numJoints; ++i) {
+        const JointData& data = joints[i];
+        if (data.translationIsDefaultPose) {
+            continue;
+        }
+
+        QuantizedJoint& joint = frame[i];
+        if (joint.hasTranslation && cullSmallChanges &&
+            glm::distance(dequantizeTranslation(joint), data.translation) <= minTranslation) {
+            continue;
+        }
+
+        QuantizedJoint quantized = joint;
+        quantizeTranslation(data.translation, quantized);
+        if (joint.hasTranslation && sameTranslation(quantized, joint)) {
+            continue;
+        }
+
+        if (!writeTranslation(quantized, joint, cursor, end)) {
+            return -1;
+        }
+        translationBits[i / 8] |= 1 << (i % 8);
+        quantized.hasTranslation = true;
+        joint = quantized;
+    }
+
+    sendState.sentFrames->commit(sendState.packetID);
+
+    // sentJointsOut may be the joints the caller culls against, so only touch it once we know the section fits
+    if (sentJointsOut) {
+        sentJointsOut->resize(numJoints);
+        JointData* sentJoints = sentJointsOut->data();
+        for (int i = 0; i < numJoints; ++i) {
+            if (rotationBits[i / 8] & (1 << (i % 8))) {
+                sentJoints[i].rotation = joints[i].rotation;
+            }
+            if (translationBits[i / 8] & (1 << (i % 8))) {
+                sentJoints[i].translation = joints[i].translation;
+            }
+            sentJoints[i].rotationIsDefaultPose = joints[i].rotationIsDefaultPose;
+            sentJoints[i].translationIsDefaultPose = joints[i].translationIsDefaultPose;
+        }
+    }
+
+    return (int)(cursor - buffer);
+}
+
+int decode(const unsigned char* buffer, int size, FrameHistory& receivedFrames,
+           PacketID& packetID, const Frame*& frame) {
+    frame = nullptr;
+
+    if (size < HEADER_SIZE) {
+        return -1;
+    }
+
+    const unsigned char* cursor = buffer;
+    const unsigned char* const end = buffer + size;
+
+    int numJoints = *cursor++;
+    memcpy(&packetID, cursor, sizeof(PacketID));
+    cursor += sizeof(PacketID);
+    int baselineAge = *cursor++;
+
+    const int jointBitVectorSize = bitVectorSize(numJoints);
+
+    // without the baseline the section is still read through, so the rest of the avatar data can be parsed
+    bool knownBaseline = true;
+    const Frame* baseline = nullptr;
+    if (baselineAge > 0) {
+        baseline = receivedFrames.find((PacketID)(packetID - baselineAge));
+        knownBaseline = baseline && (int)baseline->size() == numJoints;
+    }
+
+    Frame& nextFrame = receivedFrames.next();
+    if (baseline && knownBaseline) {
+        nextFrame = *baseline;
+    } else {
+        nextFrame.assign(numJoints, QuantizedJoint());
+    }
+
+    if (end - cursor < jointBitVectorSize) {
+        return -1;
+    }
+    const unsigned char* rotationBits = cursor;
+    cursor += jointBitVectorSize;
+
+    for (int i = 0; i < numJoints; ++i) {
+        if ((rotationBits[i / 8] & (1 << (i % 8))) && !readRotation(nextFrame[i], knownBaseline, cursor, end)) {
+            return -1;
+        }
+    }
+
+    if (end - cursor < jointBitVectorSize) {
+        return -1;
+    }
+    const unsigned char* translationBits = cursor;
+    cursor += jointBitVectorSize;
+
+    for (int i = 0; i < numJoints; ++i) {
+        if ((translationBits[i / 8] & (1 << (i % 8))) && !readTranslation(nextFrame[i], knownBaseline, cursor, end)) {
+            return -1;
+        }
+    }
+
+    if (knownBaseline) {
+        frame = &receivedFrames.commit(packetID);
+    }
+
+    return (int)(cursor - buffer);
+}
+
+}
@@ -0,0 +1,141 @@
+//
+//  AvatarJointDeltas.h
+//  libraries/avatars/src
+//
+//  Created by High Fidelity on 2019-06-18.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AvatarJointDeltas_h
+#define hifi_AvatarJointDeltas_h
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <JointData.h>
+
+// Delta coding of avatar joints between the avatar mixer and one listener.
+//
+// Every BulkAvatarData packet the mixer sends to a listener gets a packet ID, and the listener acks the IDs of
+// the packets it received. The joints of an avatar are then coded as the difference from the newest joint frame
+// of that avatar the listener is known to have (its baseline), so a joint that did not move costs nothing and a
+// joint that moved a little costs a byte or two per component. With no acknowledged baseline (a new listener, or
+// loss) every joint is sent absolute, which is also a new baseline. A listener that gets deltas against a frame it
+// doesn't have (it dropped the avatar, say) lists that avatar in its ack, and the mixer forgets what it sent of it.
+//
+// Rotations are smallest-three quaternions (the largest component is dropped and rebuilt from the other three),
+// translations are fixed point, and each changed component is a zigzag varint.
+namespace AvatarJointDeltas {
+    using PacketID = uint16_t;
+
+    // joint frames remembered per avatar, by the mixer for each listener and by the listener
+    const int NUM_FRAMES = 8;
+    // frames sent more than this many packets ago are never used as a baseline
+    const int MAX_BASELINE_AGE = 64;
+
+    const int ROTATION_COMPONENT_BITS = 15;
+    const uint32_t MAX_ROTATION_COMPONENT = (1 << ROTATION_COMPONENT_BITS) - 1;
+    // the smallest three components are quantized over a range a little wider than +/- 1/sqrt(2), so that the
+    // dropped component can stay the same while the two largest components are about equal
+    const float ROTATION_COMPONENT_RANGE = 0.75f;
+    const float TRANSLATION_QUANTUM = 1.0f / 16384.0f; // meters
+
+    /*
+    struct JointDeltas {
+        uint8_t numJoints;
+        uint16_t packetID;                                     // ID of the packet this is in, acked by the listener
+        uint8_t baselineAge;                                   // packetID - baseline packet ID, 0 if there is no baseline
+        uint8_t rotationChangedBits[ceil(numJoints / 8)];      // one bit per joint, if true then a rotation follows
+        varint rotations[numChangedRotations][3 or 4];         // deltas of the smallest three, or absolute, see writeRotation()
+        uint8_t translationChangedBits[ceil(numJoints / 8)];   // one bit per joint, if true then a translation follows
+        varint translations[numChangedTranslations][3];       // zigzag deltas of fixed point translations
+    };
+    */
+    const int HEADER_SIZE = 4;
+    size_t maxSectionSize(size_t numJoints);
+
+    struct QuantizedJoint {
+        uint16_t rotation[3] { 0, 0, 0 };
+        uint8_t largestComponent { 0 };
+        bool hasRotation { false };
+        bool hasTranslation { false };
+        int32_t translation[3] { 0, 0, 0 };
+    };
+    using Frame = std::vector<QuantizedJoint>;
+
+    // preferredLargest is the component to drop if it is still close enough to the largest, -1 for the largest
+    void quantizeRotation(const glm::quat& rotation, int preferredLargest, QuantizedJoint& joint);
+    glm::quat dequantizeRotation(const QuantizedJoint& joint);
+    void quantizeTranslation(const glm::vec3& translation, QuantizedJoint& joint);
+    glm::vec3 dequantizeTranslation(const QuantizedJoint& joint);
+
+    // Packets acked by a listener, the newest one plus a window of the ones before it.
+    class AckWindow {
+    public:
+        void ack(PacketID packetID);
+        bool isAcked(PacketID packetID) const;
+
+    private:
+        PacketID _newest { 0 };
+        uint64_t _bits { 0 }; // bit n is set if _newest - n was acked
+    };
+
+    // The last few joint frames of one avatar, either as sent to one listener or as received by it.
+    class FrameHistory {
+    public:
+        const Frame* find(PacketID packetID) const;
+        // newest frame the listener acked that is recent enough to code packetID against
+        const Frame* findBaseline(PacketID packetID, const AckWindow& acks, PacketID& baselineID) const;
+
+        // scratch space for the next frame, which replaces the oldest one on commit()
+        Frame& next() { return _next; }
+        const Frame& commit(PacketID packetID);
+
+        void clear();
+
+    private:
+        struct Entry {
+            PacketID packetID { 0 };
+            bool valid { false };
+            Frame frame;
+        };
+
+        std::array<Entry, NUM_FRAMES> _entries;
+        int _oldest { 0 };
+        Frame _next;
+    };
+
+    // What AvatarData::toByteArray needs to delta code joints for one listener.
+    struct SendState {
+        PacketID packetID { 0 };             // the packet the avatar data is going into
+        const AckWindow* acks { nullptr };   // packets the listener has acked
+        FrameHistory* sentFrames { nullptr }; // frames of this avatar sent to the listener
+        bool keyframe { false };             // ignore any baseline and send every joint absolute
+    };
+
+    // Writes a JointDeltas section for joints and records the frame in sendState.sentFrames.
+    // Small changes are culled against the baseline as AvatarData::toByteArray does against the last sent joints.
+    // Returns the number of bytes written, or -1 (leaving the history untouched) if it doesn't fit in capacity.
+    int encode(const QVector<JointData>& joints, SendState& sendState, bool cullSmallChanges,
+               float minRotationDOT, float minTranslation, unsigned char* buffer, int capacity,
+               QVector<JointData>* sentJointsOut = nullptr);
+
+    // Reads a JointDeltas section. If the baseline it was coded against is in receivedFrames the rebuilt frame is
+    // recorded there and returned in frame, otherwise frame is null.
+    // Returns the number of bytes read, or -1 if the section is malformed.
+    int decode(const unsigned char* buffer, int size, FrameHistory& receivedFrames,
+               PacketID& packetID, const Frame*& frame);
+}
+
+#endif // hifi_AvatarJointDeltas_h
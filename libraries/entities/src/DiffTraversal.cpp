@@ -15,9 +15,8 @@
 
 #include "EntityPriorityQueue.h"
 
-DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
+DiffTraversal::Waypoint::Waypoint(const EntityTreeSnapshot::ElementPointer& element) : _element(element), _nextIndex(0) {
     assert(element);
-    _weakElement = element;
 }
 
 void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::VisibleElement& next,
@@ -29,18 +28,15 @@ void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::Visi
         // we never bother checking for LOD culling, and
         // we can skip it if the content hasn't changed
         ++_nextIndex;
-        next.element = _weakElement.lock();
+        next.element = _element;
         return;
     } else if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::ElementPointer& nextElement = _element->getChildAtIndex(_nextIndex);
+            ++_nextIndex;
+            if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                next.element = nextElement;
+                return;
             }
         }
     }
@@ -52,25 +48,21 @@ void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
     if (_nextIndex == -1) {
         // root case is special
         ++_nextIndex;
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element->getLastChangedContent() > lastTime) {
-            next.element = element;
+        if (_element->getLastChangedContent() > lastTime) {
+            next.element = _element;
             return;
         }
     }
     if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement &&
-                    nextElement->getLastChanged() > lastTime &&
-                    view.shouldTraverseElement(*nextElement)) {
-
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::ElementPointer& nextElement = _element->getChildAtIndex(_nextIndex);
+            ++_nextIndex;
+            if (nextElement &&
+                nextElement->getLastChanged() > lastTime &&
+                view.shouldTraverseElement(*nextElement)) {
+
+                next.element = nextElement;
+                return;
             }
         }
     }
@@ -82,19 +74,15 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
     if (_nextIndex == -1) {
         // root case is special
         ++_nextIndex;
-        EntityTreeElementPointer element = _weakElement.lock();
-        next.element = element;
+        next.element = _element;
         return;
     } else if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::ElementPointer& nextElement = _element->getChildAtIndex(_nextIndex);
+            ++_nextIndex;
+            if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                next.element = nextElement;
+                return;
             }
         }
     }
@@ -162,7 +150,7 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
     return priority;
 }
 
-bool DiffTraversal::View::shouldTraverseElement(const EntityTreeElement& element) const {
+bool DiffTraversal::View::shouldTraverseElement(const EntityTreeSnapshot::Element& element) const {
     if (!usesViewFrustums()) {
         return true;
     }
@@ -193,9 +181,9 @@ DiffTraversal::DiffTraversal() {
     _path.reserve(MIN_PATH_DEPTH);
 }
 
-DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
-                                                       bool forceFirstPass) {
-    assert(root);
+DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view,
+                                                       const EntityTreeSnapshotPointer& snapshot, bool forceFirstPass) {
+    assert(snapshot && snapshot->getRoot());
     // there are three types of traversal:
     //
     //   (1) First = fresh view --> find all elements in view
@@ -235,11 +223,11 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     }
 
     _path.clear();
-    _path.push_back(DiffTraversal::Waypoint(root));
+    _path.push_back(DiffTraversal::Waypoint(snapshot->getRoot()));
     // set root fork's index such that root element returned at getNextElement()
     _path.back().initRootNextIndex();
 
-    _currentView.startTime = usecTimestampNow();
+    _currentView.startTime = snapshot->getTimestamp();
 
     return type;
 }
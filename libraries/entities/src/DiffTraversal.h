@@ -14,16 +14,16 @@
 
 #include <shared/ConicalViewFrustum.h>
 
-#include "EntityTreeElement.h"
+#include "EntityTreeSnapshot.h"
 
-// DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
+// DiffTraversal traverses a snapshot of the tree and applies _scanElementCallback on elements it finds
 class DiffTraversal {
 public:
     // VisibleElement is a struct identifying an element and how it intersected the view.
     // The intersection is used to optimize culling entities from the sendQueue.
     class VisibleElement {
     public:
-        EntityTreeElementPointer element;
+        EntityTreeSnapshot::ElementPointer element;
     };
 
     // View is a struct with a ViewFrustum and LOD parameters
@@ -32,7 +32,7 @@ public:
         bool usesViewFrustums() const;
         bool isVerySimilar(const View& view) const;
 
-        bool shouldTraverseElement(const EntityTreeElement& element) const;
+        bool shouldTraverseElement(const EntityTreeSnapshot::Element& element) const;
         float computePriority(const EntityItemPointer& entity) const;
 
         ConicalViewFrustums viewFrustums;
@@ -43,7 +43,7 @@ public:
     // Waypoint is an bookmark in a "path" of waypoints during a traversal.
     class Waypoint {
     public:
-        Waypoint(EntityTreeElementPointer& element);
+        Waypoint(const EntityTreeSnapshot::ElementPointer& element);
 
         void getNextVisibleElementFirstTime(VisibleElement& next, const View& view);
         void getNextVisibleElementRepeat(VisibleElement& next, const View& view, uint64_t lastTime);
@@ -53,7 +53,7 @@ public:
         void initRootNextIndex() { _nextIndex = -1; }
 
     protected:
-        EntityTreeElementWeakPointer _weakElement;
+        EntityTreeSnapshot::ElementPointer _element;
         int8_t _nextIndex;
     };
 
@@ -61,7 +61,9 @@ public:
 
     DiffTraversal();
 
-    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root, bool forceFirstPass = false);
+    // the snapshot's timestamp is the start time of the traversal, so the next Repeat finds what changed after it
+    Type prepareNewTraversal(const DiffTraversal::View& view, const EntityTreeSnapshotPointer& snapshot,
+                             bool forceFirstPass = false);
 
     const View& getCurrentView() const { return _currentView; }
 
@@ -173,6 +173,11 @@ void EntityEditFilters::removeFilter(EntityItemID entityID) {
     _filterDataMap.remove(entityID);
 }
 
+bool EntityEditFilters::hasFilters() {
+    QReadLocker readLock(&_lock);
+    return !_filterDataMap.isEmpty();
+}
+
 void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
 
     QUrl scriptURL(filterURL);
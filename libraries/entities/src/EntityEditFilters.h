@@ -53,6 +53,8 @@ public:
 
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
+    // whether any zone, or the domain, has a filter that edits may need to go through
+    bool hasFilters();
 
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, EntityItemPointer& existingEntity);
@@ -1005,6 +1005,67 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
     return bytesRead;
 }
 
+bool EntityItem::canReadEditFromBuffer(const EntityPropertyFlags& propertyFlags) {
+    // the properties that don't move the entity or need the checks that EntityTree::updateEntity() makes of the rest
+    static const EntityPropertyFlags STREAMED_EDIT_PROPERTIES = [] {
+        EntityPropertyFlags flags;
+        flags += PROP_VISIBLE;
+        flags += PROP_NAME;
+        flags += PROP_USER_DATA;
+        flags += PROP_PRIVATE_USER_DATA;
+        flags += PROP_HREF;
+        flags += PROP_DESCRIPTION;
+        flags += PROP_LAST_EDITED_BY;
+        flags += PROP_CAN_CAST_SHADOW;
+        flags += PROP_RENDER_LAYER;
+        flags += PROP_PRIMITIVE_MODE;
+        flags += PROP_IGNORE_PICK_INTERSECTION;
+        return flags;
+    }();
+
+    if (propertyFlags.isEmpty()) {
+        return false;
+    }
+    for (int flag = (int)propertyFlags.firstFlag(); flag <= (int)propertyFlags.lastFlag(); flag++) {
+        if (propertyFlags.getHasProperty((EntityPropertyList)flag) &&
+            !STREAMED_EDIT_PROPERTIES.getHasProperty((EntityPropertyList)flag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int EntityItem::readEditFromBuffer(const unsigned char* data, int bytesLeftToRead, const EntityPropertyFlags& propertyFlags) {
+    const unsigned char* dataAt = data;
+    int bytesRead = 0;
+    bool overwriteLocalData = true;
+    bool somethingChanged = false;
+
+    // in the order EntityItemProperties::decodeEntityEditPacket() reads them
+    READ_ENTITY_PROPERTY(PROP_VISIBLE, bool, setVisible);
+    READ_ENTITY_PROPERTY(PROP_NAME, QString, setName);
+    READ_ENTITY_PROPERTY(PROP_USER_DATA, QString, setUserData);
+    READ_ENTITY_PROPERTY(PROP_PRIVATE_USER_DATA, QString, setPrivateUserData);
+    READ_ENTITY_PROPERTY(PROP_HREF, QString, setHref);
+    READ_ENTITY_PROPERTY(PROP_DESCRIPTION, QString, setDescription);
+    READ_ENTITY_PROPERTY(PROP_LAST_EDITED_BY, QUuid, setLastEditedBy);
+    READ_ENTITY_PROPERTY(PROP_CAN_CAST_SHADOW, bool, setCanCastShadow);
+    READ_ENTITY_PROPERTY(PROP_RENDER_LAYER, RenderLayer, setRenderLayer);
+    READ_ENTITY_PROPERTY(PROP_PRIMITIVE_MODE, PrimitiveMode, setPrimitiveMode);
+    READ_ENTITY_PROPERTY(PROP_IGNORE_PICK_INTERSECTION, bool, setIgnorePickIntersection);
+
+    if (bytesRead > bytesLeftToRead) {
+        qCWarning(entities) << "EntityItem::readEditFromBuffer() read past the end of the edit for" << getEntityItemID();
+    }
+
+    // what setProperties() does once the properties are set
+    if (somethingChanged) {
+        setLastEdited(usecTimestampNow());
+        somethingChangedNotification();
+    }
+    return bytesRead;
+}
+
 void EntityItem::debugDump() const {
     auto position = getWorldPosition();
     qCDebug(entities) << "EntityItem id:" << getEntityItemID();
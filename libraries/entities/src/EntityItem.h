@@ -150,6 +150,12 @@ public:
 
     int readEntityDataFromBuffer(const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args);
 
+    // whether an edit packet with only these properties can be read straight into the entity by readEditFromBuffer()
+    static bool canReadEditFromBuffer(const EntityPropertyFlags& propertyFlags);
+    // reads the properties of an edit packet, after its header, straight into the entity without decoding them to
+    // EntityItemProperties first, returns the number of bytes read
+    int readEditFromBuffer(const unsigned char* data, int bytesLeftToRead, const EntityPropertyFlags& propertyFlags);
+
     virtual int readEntitySubclassDataFromBuffer(const unsigned char* data, int bytesLeftToRead,
                                                 ReadBitstreamToTreeParams& args,
                                                 EntityPropertyFlags& propertyFlags, bool overwriteLocalData,
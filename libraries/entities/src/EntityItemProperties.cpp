@@ -24,6 +24,7 @@
 #include <QtNetwork/QNetworkRequest>
 
 #include <NetworkAccessManager.h>
+#include <BufferParser.h>
 #include <ByteCountCoding.h>
 #include <GLMHelpers.h>
 #include <RegisteredMetaTypes.h>
@@ -3475,68 +3476,67 @@ QByteArray EntityItemProperties::packStrokeColors(const QVector<vec3>& strokeCol
 //
 // TODO: Implement support for script and visible properties.
 //
-bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
-                                                  EntityItemID& entityID, EntityItemProperties& properties) {
-    bool valid = false;
-
-    const unsigned char* dataAt = data;
+bool EntityItemProperties::decodeEntityEditPacketHeader(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                                        EntityItemID& entityID, EntityTypes::EntityType& type,
+                                                        quint64& lastEdited, EntityPropertyFlags& propertyFlags) {
     processedBytes = 0;
+    if (bytesToRead <= 0) {
+        return false;
+    }
 
     // the first part of the data is an octcode, this is a required element of the edit packet format, but we don't
     // actually use it, we do need to skip it and read to the actual data we care about.
-    int octets = numberOfThreeBitSectionsInCode(data);
+    int octets = numberOfThreeBitSectionsInCode(data, bytesToRead);
+    if (octets < 0) {
+        return false;
+    }
     int bytesToReadOfOctcode = (int)bytesRequiredForCodeLength(octets);
+    const int MINIMUM_HEADER_BYTES = (int)(sizeof(lastEdited) + NUM_BYTES_RFC4122_UUID);
+    if (bytesToRead < bytesToReadOfOctcode + MINIMUM_HEADER_BYTES) {
+        return false;
+    }
 
-    // we don't actually do anything with this octcode...
-    dataAt += bytesToReadOfOctcode;
-    processedBytes += bytesToReadOfOctcode;
+    // the rest of the header is read in place, without copying the packet
+    BufferParser parser(data, bytesToRead, bytesToReadOfOctcode);
 
     // Edit packets have a last edited time stamp immediately following the octcode.
     // NOTE: the edit times have been set by the editor to match out clock, so we don't need to adjust
     // these times for clock skew at this point.
-    quint64 lastEdited;
-    memcpy(&lastEdited, dataAt, sizeof(lastEdited));
-    dataAt += sizeof(lastEdited);
-    processedBytes += sizeof(lastEdited);
-    properties.setLastEdited(lastEdited);
+    parser.readValue(lastEdited);
 
     // encoded id
-    QUuid editID = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(dataAt), NUM_BYTES_RFC4122_UUID));
-    dataAt += NUM_BYTES_RFC4122_UUID;
-    processedBytes += NUM_BYTES_RFC4122_UUID;
-
-    entityID = editID;
-    valid = true;
+    parser.readUuid(entityID);
 
     // Entity Type...
-    QByteArray encodedType((const char*)dataAt, (bytesToRead - processedBytes));
-    ByteCountCoded<quint32> typeCoder = encodedType;
-    quint32 entityTypeCode = typeCoder;
-    properties.setType((EntityTypes::EntityType)entityTypeCode);
-    encodedType = typeCoder; // determine true bytesToRead
-    dataAt += encodedType.size();
-    processedBytes += encodedType.size();
+    quint32 entityTypeCode;
+    parser.readCompressedCount(entityTypeCode);
+    type = (EntityTypes::EntityType)entityTypeCode;
 
     // Update Delta - when was this item updated relative to last edit... this really should be 0
     // TODO: Should we get rid of this in this in edit packets, since this has to always be 0?
     // TODO: do properties need to handle lastupdated???
+    quint64 updateDelta;
+    parser.readCompressedCount(updateDelta);
 
-    // last updated is stored as ByteCountCoded delta from lastEdited
-    QByteArray encodedUpdateDelta((const char*)dataAt, (bytesToRead - processedBytes));
-    ByteCountCoded<quint64> updateDeltaCoder = encodedUpdateDelta;
-    encodedUpdateDelta = updateDeltaCoder; // determine true bytesToRead
-    dataAt += encodedUpdateDelta.size();
-    processedBytes += encodedUpdateDelta.size();
+    // Property Flags...
+    parser.readFlags(propertyFlags);
 
-    // TODO: Do we need this lastUpdated?? We don't seem to use it.
-    //quint64 updateDelta = updateDeltaCoder;
-    //quint64 lastUpdated = lastEdited + updateDelta; // don't adjust for clock skew since we already did that for lastEdited
+    processedBytes = (int)parser.offset();
+    return true;
+}
 
-    // Property Flags...
-    QByteArray encodedPropertyFlags((const char*)dataAt, (bytesToRead - processedBytes));
-    EntityPropertyFlags propertyFlags = encodedPropertyFlags;
-    dataAt += propertyFlags.getEncodedLength();
-    processedBytes += propertyFlags.getEncodedLength();
+bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                                  EntityItemID& entityID, EntityItemProperties& properties) {
+    quint64 lastEdited;
+    EntityTypes::EntityType type;
+    EntityPropertyFlags propertyFlags;
+    if (!decodeEntityEditPacketHeader(data, bytesToRead, processedBytes, entityID, type, lastEdited, propertyFlags)) {
+        return false;
+    }
+    bool valid = true;
+    properties.setLastEdited(lastEdited);
+    properties.setType(type);
+    const unsigned char* dataAt = data + processedBytes;
 
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_SIMULATION_OWNER, QByteArray, setSimulationOwner);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_PARENT_ID, QUuid, setParentID);
@@ -417,6 +417,10 @@ public:
     static bool encodeCloneEntityMessage(const EntityItemID& entityIDToClone, const EntityItemID& newEntityID, QByteArray& buffer);
     static bool decodeCloneEntityMessage(const QByteArray& buffer, int& processedBytes, EntityItemID& entityIDToClone, EntityItemID& newEntityID);
 
+    // reads the header of an edit packet, up to the properties, without copying the packet
+    static bool decodeEntityEditPacketHeader(const unsigned char* data, int bytesToRead, int& processedBytes,
+                                             EntityItemID& entityID, EntityTypes::EntityType& type, quint64& lastEdited,
+                                             EntityPropertyFlags& propertyFlags);
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                        EntityItemID& entityID, EntityItemProperties& properties);
 
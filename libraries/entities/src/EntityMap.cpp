@@ -0,0 +1,82 @@
+//
+//  EntityMap.cpp
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 2019-06-20.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityMap.h"
+
+EntityItemPointer EntityMap::value(const EntityItemID& id) const {
+    const Shard& shard = getShard(id);
+    QReadLocker locker(&shard.lock);
+    return shard.entities.value(id);
+}
+
+bool EntityMap::insert(const EntityItemID& id, const EntityItemPointer& entity) {
+    Shard& shard = getShard(id);
+    QWriteLocker locker(&shard.lock);
+    if (shard.entities.contains(id)) {
+        return false;
+    }
+    shard.entities.insert(id, entity);
+    return true;
+}
+
+void EntityMap::remove(const EntityItemID& id) {
+    Shard& shard = getShard(id);
+    QWriteLocker locker(&shard.lock);
+    shard.entities.remove(id);
+}
+
+void EntityMap::removeIf(const std::function<bool(const EntityItemPointer&)>& shouldRemove) {
+    for (auto& shard : _shards) {
+        QWriteLocker locker(&shard.lock);
+        auto itr = shard.entities.begin();
+        while (itr != shard.entities.end()) {
+            if (shouldRemove(itr.value())) {
+                itr = shard.entities.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+    }
+}
+
+QHash<EntityItemID, EntityItemPointer> EntityMap::takeAll() {
+    QHash<EntityItemID, EntityItemPointer> taken;
+    for (auto& shard : _shards) {
+        QHash<EntityItemID, EntityItemPointer> entities;
+        {
+            QWriteLocker locker(&shard.lock);
+            entities.swap(shard.entities);
+        }
+        taken.unite(entities);
+    }
+    return taken;
+}
+
+QVector<EntityItemPointer> EntityMap::values() const {
+    QVector<EntityItemPointer> entities;
+    for (const auto& shard : _shards) {
+        QReadLocker locker(&shard.lock);
+        entities.reserve(entities.size() + shard.entities.size());
+        for (const auto& entity : shard.entities) {
+            entities.push_back(entity);
+        }
+    }
+    return entities;
+}
+
+int EntityMap::size() const {
+    int size = 0;
+    for (const auto& shard : _shards) {
+        QReadLocker locker(&shard.lock);
+        size += shard.entities.size();
+    }
+    return size;
+}
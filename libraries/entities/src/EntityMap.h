@@ -0,0 +1,62 @@
+//
+//  EntityMap.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 2019-06-20.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_EntityMap_h
+#define hifi_EntityMap_h
+
+#include <array>
+#include <functional>
+
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QVector>
+
+#include "EntityItemID.h"
+#include "EntityTypes.h"
+
+// The entities of an EntityTree by ID.
+//
+// Every edit, send thread and script looks entities up by ID, so the map is split into shards that each have
+// their own lock, and a lookup only ever waits on writers to the same shard. It doesn't need the tree lock,
+// but code that holds the tree lock may lock the map, never the other way around.
+class EntityMap {
+public:
+    EntityItemPointer value(const EntityItemID& id) const;
+
+    // returns false, and leaves the map unchanged, if there was already an entity with this ID
+    bool insert(const EntityItemID& id, const EntityItemPointer& entity);
+    void remove(const EntityItemID& id);
+
+    // removes the entities for which shouldRemove returns true, one shard at a time
+    void removeIf(const std::function<bool(const EntityItemPointer&)>& shouldRemove);
+    // empties the map and returns what was in it
+    QHash<EntityItemID, EntityItemPointer> takeAll();
+
+    QVector<EntityItemPointer> values() const;
+    int size() const;
+
+private:
+    static const int NUM_SHARDS = 16;
+
+    struct Shard {
+        mutable QReadWriteLock lock;
+        QHash<EntityItemID, EntityItemPointer> entities;
+    };
+
+    Shard& getShard(const EntityItemID& id) { return _shards[qHash(id) % NUM_SHARDS]; }
+    const Shard& getShard(const EntityItemID& id) const { return _shards[qHash(id) % NUM_SHARDS]; }
+
+    std::array<Shard, NUM_SHARDS> _shards;
+};
+
+#endif // hifi_EntityMap_h
@@ -0,0 +1,230 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 2019-06-22.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <queue>
+
+#include "EntityItem.h"
+#include "EntityTreeElement.h"
+
+EntitySpatialIndex::Node::Node(int32_t parent, const glm::vec3& corner, float scale) :
+    parent(parent),
+    cell(corner, scale),
+    looseBounds(corner - glm::vec3(0.5f * scale), 2.0f * scale)
+{
+    children.fill(-1);
+}
+
+EntitySpatialIndex::EntitySpatialIndex() {
+    clear();
+}
+
+void EntitySpatialIndex::update(const EntityItemPointer& entity) {
+    std::lock_guard<std::mutex> lock(_updatedMutex);
+    _updated[entity.get()] = entity;
+}
+
+void EntitySpatialIndex::remove(const EntityItem* entity) {
+    {
+        std::lock_guard<std::mutex> lock(_updatedMutex);
+        _updated.erase(entity);
+    }
+    QWriteLocker locker(&_lock);
+    auto itr = _locations.find(entity);
+    if (itr != _locations.end()) {
+        erase(itr->second);
+        _locations.erase(itr);
+    }
+}
+
+void EntitySpatialIndex::clear() {
+    {
+        std::lock_guard<std::mutex> lock(_updatedMutex);
+        _updated.clear();
+    }
+    QWriteLocker locker(&_lock);
+    _locations.clear();
+    _nodes.clear();
+    _nodes.emplace_back(-1, glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE);
+}
+
+int EntitySpatialIndex::size() {
+    refit();
+    QReadLocker locker(&_lock);
+    return (int)_locations.size();
+}
+
+void EntitySpatialIndex::refit() {
+    std::vector<EntityItemPointer> updated;
+    {
+        std::lock_guard<std::mutex> lock(_updatedMutex);
+        if (_updated.empty()) {
+            return;
+        }
+        updated.reserve(_updated.size());
+        for (const auto& entry : _updated) {
+            updated.push_back(entry.second);
+        }
+        _updated.clear();
+    }
+
+    QWriteLocker locker(&_lock);
+    for (const auto& entity : updated) {
+        auto itr = _locations.find(entity.get());
+        if (itr != _locations.end()) {
+            erase(itr->second);
+            _locations.erase(itr);
+        }
+
+        // it may have been removed from the tree since it was updated
+        EntityTreeElementPointer element = entity->getElement();
+        if (!element) {
+            continue;
+        }
+        bool success;
+        AACube queryCube = entity->getQueryAACube(success);
+        // without a query cube, it's found where the tree would find it
+        insert(entity, success ? AABox(queryCube) : AABox(element->getAACube()));
+    }
+}
+
+int32_t EntitySpatialIndex::findNode(const AABox& bounds) {
+    glm::vec3 center = bounds.calcCenter();
+    const glm::vec3& dimensions = bounds.getScale();
+    float size = glm::max(dimensions.x, glm::max(dimensions.y, dimensions.z));
+
+    int32_t index = ROOT;
+    if (!_nodes[ROOT].cell.contains(center)) {
+        return index;
+    }
+    for (int depth = 0; depth < MAX_DEPTH; ++depth) {
+        glm::vec3 corner = _nodes[index].cell.getCorner();
+        float childScale = 0.5f * _nodes[index].cell.getScale().x;
+        if (size > childScale) {
+            // it would stick out of the loose bounds of the child
+            break;
+        }
+        glm::ivec3 octant = glm::ivec3(glm::greaterThanEqual(center, corner + glm::vec3(childScale)));
+        int childIndex = octant.x | (octant.y << 1) | (octant.z << 2);
+        int32_t child = _nodes[index].children[childIndex];
+        if (child < 0) {
+            child = (int32_t)_nodes.size();
+            _nodes.emplace_back(index, corner + childScale * glm::vec3(octant), childScale);
+            _nodes[index].children[childIndex] = child;
+        }
+        index = child;
+    }
+    return index;
+}
+
+void EntitySpatialIndex::insert(const EntityItemPointer& entity, const AABox& bounds) {
+    int32_t index = findNode(bounds);
+    Node& node = _nodes[index];
+    _locations[entity.get()] = { index, (int32_t)node.items.size() };
+    node.items.push_back({ entity, bounds });
+    for (; index >= 0; index = _nodes[index].parent) {
+        ++_nodes[index].numEntities;
+    }
+}
+
+void EntitySpatialIndex::erase(const Location& location) {
+    std::vector<Item>& items = _nodes[location.node].items;
+    if (location.item != (int32_t)items.size() - 1) {
+        items[location.item] = std::move(items.back());
+        _locations[items[location.item].entity.get()].item = location.item;
+    }
+    items.pop_back();
+    // nodes are kept when they're emptied, they're skipped by searches and reused when something moves back in
+    for (int32_t index = location.node; index >= 0; index = _nodes[index].parent) {
+        --_nodes[index].numEntities;
+    }
+}
+
+template <typename F>
+void EntitySpatialIndex::forEachEntityWhere(const F& touches, const EntityFunctor& f) {
+    refit();
+    QReadLocker locker(&_lock);
+    std::vector<int32_t> toVisit;
+    toVisit.push_back(ROOT);
+    while (!toVisit.empty()) {
+        const Node& node = _nodes[toVisit.back()];
+        toVisit.pop_back();
+        for (const Item& item : node.items) {
+            if (touches(item.bounds)) {
+                f(item.entity);
+            }
+        }
+        for (int32_t child : node.children) {
+            if (child >= 0 && _nodes[child].numEntities > 0 && touches(_nodes[child].looseBounds)) {
+                toVisit.push_back(child);
+            }
+        }
+    }
+}
+
+void EntitySpatialIndex::forEachEntityTouching(const AABox& box, const EntityFunctor& f) {
+    forEachEntityWhere([&](const AABox& bounds) {
+        return bounds.touches(box);
+    }, f);
+}
+
+void EntitySpatialIndex::forEachEntityTouchingSphere(const glm::vec3& center, float radius, const EntityFunctor& f) {
+    forEachEntityWhere([&](const AABox& bounds) {
+        return bounds.touchesSphere(center, radius);
+    }, f);
+}
+
+void EntitySpatialIndex::forEachEntityInFrustum(const ViewFrustum& frustum, const EntityFunctor& f) {
+    forEachEntityWhere([&](const AABox& bounds) {
+        return frustum.boxIntersectsFrustum(bounds) || frustum.boxIntersectsKeyhole(bounds);
+    }, f);
+}
+
+void EntitySpatialIndex::forEachEntityAlongRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                               const RayFunctor& f) {
+    // calculate dirReciprocal like this rather than with glm's scalar / vec3 template to avoid NaNs.
+    glm::vec3 invDirection = glm::vec3(direction.x == 0.0f ? 0.0f : 1.0f / direction.x,
+                                       direction.y == 0.0f ? 0.0f : 1.0f / direction.y,
+                                       direction.z == 0.0f ? 0.0f : 1.0f / direction.z);
+    auto findDistance = [&](const AABox& bounds, float& distance) {
+        if (bounds.contains(origin)) {
+            distance = 0.0f;
+            return true;
+        }
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        return bounds.findRayIntersection(origin, direction, invDirection, distance, face, surfaceNormal);
+    };
+
+    refit();
+    QReadLocker locker(&_lock);
+    using Entry = std::pair<float, int32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> toVisit;
+    toVisit.emplace(0.0f, ROOT);
+    while (!toVisit.empty() && toVisit.top().first < maxDistance) {
+        const Node& node = _nodes[toVisit.top().second];
+        toVisit.pop();
+        for (const Item& item : node.items) {
+            float distance;
+            if (findDistance(item.bounds, distance) && distance < maxDistance) {
+                maxDistance = glm::min(maxDistance, f(item.entity));
+            }
+        }
+        for (int32_t child : node.children) {
+            float distance;
+            if (child >= 0 && _nodes[child].numEntities > 0 && findDistance(_nodes[child].looseBounds, distance) &&
+                distance < maxDistance) {
+                toVisit.emplace(distance, child);
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 2019-06-22.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QReadWriteLock>
+
+#include <AABox.h>
+#include <OctreeConstants.h>
+#include <ViewFrustum.h>
+
+#include "EntityTypes.h"
+
+// A loose octree of the entities of an EntityTree, by their query cubes, that EntityTree searches instead of its elements.
+//
+// The tree keeps each entity in the smallest element that contains it, so entities that are large or that cross the
+// boundary between two big elements pile up near the root, and are tested by every search. Here an entity is kept in the
+// cell that contains its center at the depth where the cells are at least as big as it is, and each cell's bounds are
+// grown by half its size on every side so that they contain its entities. Entities whose center is outside the tree
+// stay in the root, which is always searched.
+//
+// The tree tells the index when an entity is added, moved or removed, and the moved entities are placed again by the
+// next search, after their new properties have been set.
+class EntitySpatialIndex {
+public:
+    using EntityFunctor = std::function<void(const EntityItemPointer& entity)>;
+    // returns the distance to the closest hit found so far
+    using RayFunctor = std::function<float(const EntityItemPointer& entity)>;
+
+    EntitySpatialIndex();
+
+    // call when the entity is added to the tree, or when its query cube may have changed
+    void update(const EntityItemPointer& entity);
+    // call when the entity is removed from the tree, it may already be deleted
+    void remove(const EntityItem* entity);
+    void clear();
+
+    int size();
+
+    // call f on each entity whose query cube may touch the box, sphere or frustum; f makes the exact test
+    void forEachEntityTouching(const AABox& box, const EntityFunctor& f);
+    void forEachEntityTouchingSphere(const glm::vec3& center, float radius, const EntityFunctor& f);
+    void forEachEntityInFrustum(const ViewFrustum& frustum, const EntityFunctor& f);
+    // calls f on the entities whose query cube the ray hits, nearest cells first, until the rest are all farther than
+    // the distance f returned last
+    void forEachEntityAlongRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, const RayFunctor& f);
+
+private:
+    static const int32_t ROOT = 0;
+    static const int MAX_DEPTH = 16; // cells of half a meter
+
+    struct Item {
+        EntityItemPointer entity;
+        AABox bounds;
+    };
+
+    struct Node {
+        Node(int32_t parent, const glm::vec3& corner, float scale);
+
+        int32_t parent;
+        AABox cell;
+        AABox looseBounds; // the cell, grown by half its size on every side
+        std::array<int32_t, NUMBER_OF_CHILDREN> children;
+        std::vector<Item> items;
+        int32_t numEntities { 0 }; // in this node and the ones below it
+    };
+
+    struct Location {
+        int32_t node;
+        int32_t item;
+    };
+
+    // places the entities that were updated since the last search
+    void refit();
+    int32_t findNode(const AABox& bounds);
+    void insert(const EntityItemPointer& entity, const AABox& bounds);
+    void erase(const Location& location);
+
+    template <typename F>
+    void forEachEntityWhere(const F& touches, const EntityFunctor& f);
+
+    mutable QReadWriteLock _lock;
+    std::vector<Node> _nodes;
+    std::unordered_map<const EntityItem*, Location> _locations;
+
+    std::mutex _updatedMutex;
+    std::unordered_map<const EntityItem*, EntityItemPointer> _updated;
+};
+
+#endif // hifi_EntitySpatialIndex_h
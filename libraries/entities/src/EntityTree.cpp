@@ -21,9 +21,11 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
+#include <OctreeBinaryFile.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
@@ -89,27 +91,24 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
     }
 
     this->withWriteLock([&] {
-        QHash<EntityItemID, EntityItemPointer> savedEntities;
         // NOTE: lock the Tree first, then lock the _entityMap.
         // It should never be done the other way around.
-        QReadLocker locker(&_entityMapLock);
-        foreach(EntityItemPointer entity, _entityMap) {
+        _entityMap.removeIf([&](const EntityItemPointer& entity) {
             EntityTreeElementPointer element = entity->getElement();
             if (element) {
                 element->cleanupDomainAndNonOwnedEntities();
             }
 
             if (entity->isLocalEntity() || (entity->isAvatarEntity() && entity->getOwningAvatarID() == getMyAvatarSessionUUID())) {
-                savedEntities[entity->getEntityItemID()] = entity;
-            } else {
-                int32_t spaceIndex = entity->getSpaceIndex();
-                if (spaceIndex != -1) {
-                    // stale spaceIndices will be freed later
-                    _staleProxies.push_back(spaceIndex);
-                }
+                return false;
             }
-        }
-        _entityMap.swap(savedEntities);
+            int32_t spaceIndex = entity->getSpaceIndex();
+            if (spaceIndex != -1) {
+                // stale spaceIndices will be freed later
+                _staleProxies.push_back(spaceIndex);
+            }
+            return true;
+        });
     });
 
     resetClientEditStats();
@@ -136,14 +135,17 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     if (_simulation) {
         _simulation->clearEntities();
     }
-    QHash<EntityItemID, EntityItemPointer> localMap;
-    localMap.swap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.takeAll();
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
             if (element) {
                 element->cleanupEntities();
             }
+            if (getIsServer()) {
+                // so send threads still traversing an older snapshot don't send it
+                entity->die();
+            }
             int32_t spaceIndex = entity->getSpaceIndex();
             if (spaceIndex != -1) {
                 // assume stale spaceIndices will be freed later
@@ -152,6 +154,8 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         }
     });
     localMap.clear();
+    _spatialIndex.clear();
+    std::atomic_store(&_snapshot, EntityTreeSnapshotPointer());
     Octree::eraseAllOctreeElements(createNewRoot);
 
     resetClientEditStats();
@@ -300,20 +304,20 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    markChangedForJournal(entity->getEntityItemID(), true);
 
-    // find and hook up any entities with this entity as a (previously) missing parent
-    fixupNeedsParentFixups();
+    // find and hook up any entities with this entity as a (previously) missing parent, unless a file is being loaded,
+    // whose entities are all hooked up after they've been added
+    if (!_deferParentFixups) {
+        fixupNeedsParentFixups();
+    }
 
     emit addingEntity(entity->getEntityItemID());
     emit addingEntityPointer(entity.get());
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityID);
     if (!entity) {
         return false;
     }
@@ -366,6 +370,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                markChangedForJournal(entity->getEntityItemID(), true);
             }
         }
     } else {
@@ -501,6 +506,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        markChangedForJournal(entity->getEntityItemID(), true);
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -533,6 +539,192 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
     return true;
 }
 
+bool EntityTree::canUpdateEntityInPlace(const EntityItemProperties& properties) {
+    static const EntityPropertyFlags IN_PLACE_PROPERTIES = [] {
+        EntityPropertyFlags flags;
+        flags += PROP_VISIBLE;
+        flags += PROP_NAME;
+        flags += PROP_USER_DATA;
+        flags += PROP_PRIVATE_USER_DATA;
+        flags += PROP_HREF;
+        flags += PROP_DESCRIPTION;
+        flags += PROP_LAST_EDITED_BY;
+        flags += PROP_CAN_CAST_SHADOW;
+        flags += PROP_RENDER_LAYER;
+        flags += PROP_PRIMITIVE_MODE;
+        flags += PROP_IGNORE_PICK_INTERSECTION;
+        flags += PROP_COLOR;
+        flags += PROP_ALPHA;
+        flags += PROP_BILLBOARD_MODE;
+        return flags;
+    }();
+
+    EntityPropertyFlags changedProperties = properties.getChangedProperties();
+    if (changedProperties.isEmpty()) {
+        return false;
+    }
+    for (int flag = (int)changedProperties.firstFlag(); flag <= (int)changedProperties.lastFlag(); flag++) {
+        if (changedProperties.getHasProperty((EntityPropertyList)flag) &&
+            !IN_PLACE_PROPERTIES.getHasProperty((EntityPropertyList)flag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EntityTree::updateEntityInPlace(EntityItemPointer entity, const EntityItemProperties& properties) {
+    EntityTreeElementPointer containingElement = entity->getElement();
+    if (!canEditInPlace(entity, containingElement)) {
+        return false;
+    }
+
+    uint32_t preFlags = entity->getDirtyFlags();
+    if (entity->setProperties(properties)) {
+        emit editingEntityPointer(entity);
+    }
+    markEditedInPlace(entity, containingElement, preFlags);
+    return true;
+}
+
+int EntityTree::readEditInPlace(const unsigned char* editData, int maxLength, const SharedNodePointer& senderNode) {
+    // logged and filtered edits need their properties
+    if (wantEditLogging() || wantTerseEditLogging()) {
+        return 0;
+    }
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    if (entityEditFilters && entityEditFilters->hasFilters() && !senderNode->isAllowedEditor()) {
+        return 0;
+    }
+
+    quint64 startDecode = usecTimestampNow();
+    int processedBytes = 0;
+    EntityItemID entityItemID;
+    EntityTypes::EntityType type;
+    quint64 lastEdited;
+    EntityPropertyFlags propertyFlags;
+    if (!EntityItemProperties::decodeEntityEditPacketHeader(editData, maxLength, processedBytes, entityItemID, type,
+            lastEdited, propertyFlags) || !EntityItem::canReadEditFromBuffer(propertyFlags)) {
+        return 0;
+    }
+    // updateEntity() keeps the private user data of senders who aren't allowed to set it
+    if (propertyFlags.getHasProperty(PROP_PRIVATE_USER_DATA) && !senderNode->getCanGetAndSetPrivateUserData()) {
+        return 0;
+    }
+    quint64 endDecode = usecTimestampNow();
+
+    quint64 startLookup = usecTimestampNow();
+    EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
+    quint64 endLookup = usecTimestampNow();
+    if (!existingEntity) {
+        return 0;
+    }
+
+    quint64 startUpdate = usecTimestampNow();
+    bool updatedInPlace = false;
+    withReadLock([&] {
+        EntityTreeElementPointer containingElement = existingEntity->getElement();
+        if (!canEditInPlace(existingEntity, containingElement)) {
+            return;
+        }
+        uint32_t preFlags = existingEntity->getDirtyFlags();
+        processedBytes += existingEntity->readEditFromBuffer(editData + processedBytes, maxLength - processedBytes,
+            propertyFlags);
+        existingEntity->setLastEditedBy(senderNode->getUUID());
+        emit editingEntityPointer(existingEntity);
+        markEditedInPlace(existingEntity, containingElement, preFlags);
+        updatedInPlace = true;
+    });
+    if (!updatedInPlace) {
+        return 0;
+    }
+    existingEntity->markAsChangedOnServer();
+    quint64 endUpdate = usecTimestampNow();
+
+    _totalEditMessages++;
+    _totalInPlaceUpdates++;
+    _totalUpdates++;
+    _totalDecodeTime += endDecode - startDecode;
+    _totalLookupTime += endLookup - startLookup;
+    _totalUpdateTime += endUpdate - startUpdate;
+    return processedBytes;
+}
+
+bool EntityTree::canEditInPlace(const EntityItemPointer& entity, const EntityTreeElementPointer& containingElement) const {
+    // locked entities only allow unlocking, which updateEntity() takes care of
+    if (!containingElement || entity->getLocked()) {
+        return false;
+    }
+
+    // the entity may have moved since it was last put in the tree, in which case it is still correct to leave it
+    // where it is until updateEntity() moves it
+    bool success;
+    AACube queryCube = entity->getQueryAACube(success);
+    return success && containingElement->bestFitBounds(queryCube);
+}
+
+void EntityTree::markEditedInPlace(const EntityItemPointer& entity, const EntityTreeElementPointer& containingElement,
+        uint32_t preFlags) {
+    markPathToElementChanged(containingElement);
+    _isDirty = true;
+    markChangedForJournal(entity->getEntityItemID(), true);
+
+    uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
+    if (newFlags) {
+        if (entity->isSimulated()) {
+            if (newFlags & DIRTY_SIMULATION_FLAGS) {
+                _simulation->changeEntity(entity);
+            }
+        } else {
+            entity->clearDirtyFlags();
+        }
+    }
+}
+
+void EntityTree::markPathToElementChanged(const EntityTreeElementPointer& element) {
+    // what UpdateEntityOperator does when the entity stays in its element, without the recursion or the write lock
+    const AACube& cube = element->getAACube();
+    OctreeElementPointer ancestor = _rootElement;
+    while (ancestor && ancestor != element) {
+        ancestor->markWithChangedTime();
+        int childIndex = ancestor->getMyChildContaining(cube);
+        ancestor = childIndex == OctreeElement::CHILD_UNKNOWN ? nullptr : ancestor->getChildAtIndex(childIndex);
+    }
+    element->bumpChangedContent();
+    element->markWithChangedTime();
+}
+
+EntityTreeSnapshotPointer EntityTree::getSnapshot() {
+    EntityTreeSnapshotPointer snapshot = std::atomic_load(&_snapshot);
+    bool isCurrent = false;
+    withReadLock([&] {
+        auto root = std::static_pointer_cast<EntityTreeElement>(_rootElement);
+        isCurrent = !root || (snapshot && !snapshot->isOlderThan(root));
+    });
+    if (isCurrent) {
+        return snapshot;
+    }
+
+    std::unique_lock<std::mutex> lock(_snapshotMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        if (snapshot) {
+            // another send thread is making the next one, this one was current a moment ago
+            return snapshot;
+        }
+        lock.lock();
+    }
+
+    // it may have been made while we waited
+    snapshot = std::atomic_load(&_snapshot);
+    withReadLock([&] {
+        auto root = std::static_pointer_cast<EntityTreeElement>(_rootElement);
+        if (root && (!snapshot || snapshot->isOlderThan(root))) {
+            snapshot = std::make_shared<EntityTreeSnapshot>(root, snapshot);
+            std::atomic_store(&_snapshot, snapshot);
+        }
+    });
+    return snapshot;
+}
+
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone) {
     EntityItemProperties props = properties;
 
@@ -743,6 +935,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
         }
 
         theEntity->die();
+        markChangedForJournal(theEntity->getEntityItemID(), false);
 
         if (getIsServer()) {
             removeCertifiedEntityOnServer(theEntity);
@@ -838,7 +1031,17 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        if (_useSpatialIndex) {
+            _spatialIndex.forEachEntityAlongRay(origin, direction, distance, [&](const EntityItemPointer& entity) {
+                if (EntityTreeElement::evalEntityRayIntersection(entity, origin, direction, element, distance, face,
+                        surfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                    args.entityID = entity->getEntityItemID();
+                }
+                return distance;
+            });
+        } else {
+            recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        }
     }, requireLock);
 
     if (accurateResult) {
@@ -1015,7 +1218,16 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
+    if (_useSpatialIndex) {
+        _spatialIndex.forEachEntityTouchingSphere(center, radius, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+                EntityTreeElement::entityIntersectsSphere(entity, center, radius)) {
+                args.entities.push_back(entity->getID());
+            }
+        });
+    } else {
+        recurseTreeWithOperation(evalInSphereOperation, &args);
+    }
     foundEntities.swap(args.entities);
 }
 
@@ -1050,7 +1262,16 @@ bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* ex
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
+    if (_useSpatialIndex) {
+        _spatialIndex.forEachEntityTouchingSphere(center, radius, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::checkFilterSettings(entity, searchFilter) && type == entity->getType() &&
+                EntityTreeElement::entityIntersectsSphere(entity, center, radius)) {
+                args.entities.push_back(entity->getID());
+            }
+        });
+    } else {
+        recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
+    }
     foundEntities.swap(args.entities);
 }
 
@@ -1086,7 +1307,18 @@ bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* ex
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
+    if (_useSpatialIndex) {
+        Qt::CaseSensitivity sensitivity = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        _spatialIndex.forEachEntityTouchingSphere(center, radius, [&](const EntityItemPointer& entity) {
+            if (EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+                name.compare(entity->getName(), sensitivity) == 0 &&
+                EntityTreeElement::entityIntersectsSphere(entity, center, radius)) {
+                args.entities.push_back(entity->getID());
+            }
+        });
+    } else {
+        recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
+    }
     foundEntities.swap(args.entities);
 }
 
@@ -1113,7 +1345,17 @@ bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
+    if (_useSpatialIndex) {
+        _spatialIndex.forEachEntityTouching(AABox(cube), [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (success && EntityTreeElement::checkFilterSettings(entity, searchFilter) && entityBox.touches(cube)) {
+                args.entities.push_back(entity->getID());
+            }
+        });
+    } else {
+        recurseTreeWithOperation(findInCubeOperation, &args);
+    }
     foundEntities.swap(args.entities);
 }
 
@@ -1140,8 +1382,18 @@ bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
+    if (_useSpatialIndex) {
+        _spatialIndex.forEachEntityTouching(box, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (success && EntityTreeElement::checkFilterSettings(entity, searchFilter) && entityBox.touches(box)) {
+                args.entities.push_back(entity->getID());
+            }
+        });
+    } else {
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInBoxOperation, &args);
+    }
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -1169,8 +1421,19 @@ bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
+    if (_useSpatialIndex) {
+        _spatialIndex.forEachEntityInFrustum(frustum, [&](const EntityItemPointer& entity) {
+            bool success;
+            AABox entityBox = entity->getAABox(success);
+            if (success && EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+                (frustum.boxIntersectsFrustum(entityBox) || frustum.boxIntersectsKeyhole(entityBox))) {
+                args.entities.push_back(entity->getID());
+            }
+        });
+    } else {
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInFrustumOperation, &args);
+    }
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -1181,11 +1444,7 @@ EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
 }
 
 EntityItemPointer EntityTree::findEntityByEntityItemID(const EntityItemID& entityID) const {
-    EntityItemPointer foundEntity = nullptr;
-    {
-        QReadLocker locker(&_entityMapLock);
-        foundEntity = _entityMap.value(entityID);
-    }
+    EntityItemPointer foundEntity = _entityMap.value(entityID);
     if (foundEntity && !foundEntity->getElement()) {
         // special case to maintain legacy behavior:
         // if the entity is in the map but not in the tree
@@ -1764,7 +2023,9 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     switch (message.getType()) {
         case PacketType::EntityErase: {
             QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-            processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            withWriteLock([&] {
+                processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            });
             break;
         }
 
@@ -1776,6 +2037,16 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             // FALLTHRU
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
+            if (message.getType() == PacketType::EntityEdit) {
+                int bytesReadInPlace = readEditInPlace(editData, maxLength, senderNode);
+                if (bytesReadInPlace > 0) {
+                    processedBytes = bytesReadInPlace;
+                    break;
+                }
+            }
+
+            // everything up to applying the edit is done without the tree lock, so that the send threads can
+            // traverse the tree while edits are decoded and filtered
             quint64 startDecode = 0, endDecode = 0;
             quint64 startLookup = 0, endLookup = 0;
             quint64 startUpdate = 0, endUpdate = 0;
@@ -1967,7 +2238,19 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                     if (!isPhysics) {
                         properties.setLastEditedBy(senderNode->getUUID());
                     }
-                    updateEntity(existingEntity, properties, senderNode);
+                    bool updatedInPlace = false;
+                    if (!isPhysics && canUpdateEntityInPlace(properties)) {
+                        withReadLock([&] {
+                            updatedInPlace = updateEntityInPlace(existingEntity, properties);
+                        });
+                    }
+                    if (updatedInPlace) {
+                        _totalInPlaceUpdates++;
+                    } else {
+                        withWriteLock([&] {
+                            updateEntity(existingEntity, properties, senderNode);
+                        });
+                    }
                     existingEntity->markAsChangedOnServer();
                     endUpdate = usecTimestampNow();
                     _totalUpdates++;
@@ -2003,26 +2286,29 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                         // this is a new entity... assign a new entityID
                         properties.setLastEditedBy(senderNode->getUUID());
                         startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
+                        EntityItemPointer newEntity;
+                        withWriteLock([&] {
+                            newEntity = addEntity(entityItemID, properties);
+                            endCreate = usecTimestampNow();
+
+                            if (newEntity && isCertified && getIsServer()) {
+                                if (!properties.verifyStaticCertificateProperties()) {
+                                    qCDebug(entities) << "User" << senderNode->getUUID()
+                                        << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                                        << "static certificate verification.";
+                                    // Delete the entity we just added if it doesn't pass static certificate verification
+                                    deleteEntity(entityItemID, true);
+                                } else {
+                                    validatePop(properties.getCertificateID(), entityItemID, senderNode);
+                                }
                             }
-                        }
 
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
+                            if (newEntity && isClone) {
+                                entityToClone->addCloneID(newEntity->getEntityItemID());
+                                newEntity->setCloneOriginID(entityIDToClone);
+                            }
+                        });
+                        _totalCreates++;
 
                         if (newEntity) {
                             newEntity->markAsChangedOnServer();
@@ -2444,11 +2730,7 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
 }
 
 EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& entityItemID)  /*const*/ {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityItemID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityItemID);
     if (entity) {
         return entity->getElement();
     }
@@ -2457,30 +2739,20 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 
 void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
     EntityItemID id = entity->getEntityItemID();
-    QWriteLocker locker(&_entityMapLock);
-    EntityItemPointer otherEntity = _entityMap.value(id);
-    if (otherEntity) {
+    if (!_entityMap.insert(id, entity)) {
         qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
         assert(false);
-        return;
     }
-    _entityMap.insert(id, entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
-    QWriteLocker locker(&_entityMapLock);
     _entityMap.remove(id);
 }
 
 void EntityTree::debugDumpMap() {
-    // QHash's are implicitly shared, so we make a shared copy and use that instead.
-    // This way we might be able to avoid both a lock and a true copy.
-    QHash<EntityItemID, EntityItemPointer> localMap(_entityMap);
     qCDebug(entities) << "EntityTree::debugDumpMap() --------------------------";
-    QHashIterator<EntityItemID, EntityItemPointer> i(localMap);
-    while (i.hasNext()) {
-        i.next();
-        qCDebug(entities) << i.key() << ": " << i.value()->getElement().get();
+    foreach (EntityItemPointer entity, _entityMap.values()) {
+        qCDebug(entities) << entity->getEntityItemID() << ": " << entity->getElement().get();
     }
     qCDebug(entities) << "-----------------------------------------------------";
 }
@@ -2860,6 +3132,144 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
 }
 
 
+namespace {
+    // entities read from JSON are converted to properties on worker threads in batches of this many
+    const int ENTITIES_PER_CONVERSION_BATCH = 512;
+
+    using DecodedEntity = std::pair<EntityItemID, EntityItemProperties>;
+}
+
+void EntityTree::entityPropertiesFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                         EntityItemID& entityItemID, EntityItemProperties& properties) {
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
+
+    // QVariantMap --> QScriptValue --> EntityItemProperties
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        properties.setOwningAvatarID(myNodeID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
+
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
+
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
+        }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
+        }
+    }
+}
+
 bool EntityTree::readFromMap(QVariantMap& map) {
     // These are needed to deal with older content (before adding inheritance modes)
     int contentVersion = map["Version"].toInt();
@@ -2887,162 +3297,218 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
     // to add the new entity to the EntityTree.
     QVariantList entitiesQList = map["Entities"].toList();
-    QScriptEngine scriptEngine;
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
         return false;
     }
 
-    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    // each batch of entities is converted with its own script engine, since they can't be shared between threads
+    auto convertEntities = [this, &entitiesQList, contentVersion](int start, int end) {
+        QScriptEngine scriptEngine;
+        std::vector<DecodedEntity> converted(end - start);
+        for (int i = start; i < end; ++i) {
+            QVariantMap entityMap = entitiesQList[i].toMap();
+            DecodedEntity& entity = converted[i - start];
+            entityPropertiesFromMap(entityMap, contentVersion, scriptEngine, entity.first, entity.second);
+        }
+        return converted;
+    };
 
-    bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
+    std::vector<DecodedEntity> loadedEntities;
+    if (_myAvatar) {
+        // wearables are hooked up to the joints of my avatar, which is only looked at from this thread
+        loadedEntities = convertEntities(0, entitiesQList.length());
+    } else {
+        QVector<QFuture<std::vector<DecodedEntity>>> batches;
+        for (int start = 0; start < entitiesQList.length(); start += ENTITIES_PER_CONVERSION_BATCH) {
+            int end = std::min(start + ENTITIES_PER_CONVERSION_BATCH, entitiesQList.length());
+            batches.push_back(QtConcurrent::run([&convertEntities, start, end] {
+                return convertEntities(start, end);
+            }));
+        }
+        loadedEntities.reserve(entitiesQList.length());
+        for (auto& batch : batches) {
+            std::vector<DecodedEntity> converted = batch.result();
+            std::move(converted.begin(), converted.end(), std::back_inserter(loadedEntities));
+        }
+    }
 
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+    return addLoadedEntities(loadedEntities);
+}
 
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+    withReadLock([&] {
+        recurseTreeWithOperator(&theOperator);
+    });
 
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
-        }
+    jsonString = theOperator.getJson();
+    return true;
+}
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+namespace {
+    // entities are encoded to and decoded from the binary persist file in sections of this many, in parallel
+    const int ENTITIES_PER_BINARY_SECTION = 4096;
+    // the buffer an entity is encoded to grows until all of its properties fit in one add packet
+    const int MIN_BINARY_ENTITY_SIZE = 16 * 1024;
+    const int MAX_BINARY_ENTITY_SIZE = 64 * 1024 * 1024;
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
-        }
+    bool encodeEntityForBinaryFile(const EntityItemPointer& entity, QByteArray& section) {
+        EntityItemProperties properties = entity->getProperties();
+        properties.markAllChanged();
+        EntityPropertyFlags requestedProperties = properties.getChangedProperties();
+        // the simulation owner would be a session that's gone by the time the file is loaded
+        requestedProperties -= PROP_SIMULATION_OWNER;
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        for (int size = MIN_BINARY_ENTITY_SIZE; size <= MAX_BINARY_ENTITY_SIZE; size *= 2) {
+            QByteArray buffer(size, 0);
+            EntityPropertyFlags didntFitProperties;
+            OctreeElement::AppendState state = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd,
+                entity->getEntityItemID(), properties, buffer, requestedProperties, didntFitProperties);
+            if (state == OctreeElement::COMPLETED) {
+                OctreeBinaryFile::appendItem(section, buffer);
+                return true;
             }
         }
+        qCWarning(entities) << "Entity" << entity->getEntityItemID() << "is too big for the binary persist file";
+        return false;
+    }
+}
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
-        }
-
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
-
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+bool EntityTree::writeToBinary(OctreeBinaryFile& file) {
+    // the entities are collected from the map, so the tree isn't locked while they're encoded
+    QVector<EntityItemPointer> entities = _entityMap.values();
+    file.setInfo(_persistID, _persistDataVersion, expectedVersion());
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+    QVector<QFuture<QByteArray>> sections;
+    for (int start = 0; start < entities.size(); start += ENTITIES_PER_BINARY_SECTION) {
+        int end = std::min(start + ENTITIES_PER_BINARY_SECTION, entities.size());
+        sections.push_back(QtConcurrent::run([&entities, start, end] {
+            QByteArray section;
+            for (int i = start; i < end; ++i) {
+                if (!encodeEntityForBinaryFile(entities[i], section)) {
+                    return QByteArray();
                 }
             }
+            return section;
+        }));
+    }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
+    bool success = true;
+    for (int i = 0; i < sections.size(); ++i) {
+        QByteArray section = sections[i].result();
+        if (section.isEmpty()) {
+            success = false;
+            continue;
         }
+        int start = i * ENTITIES_PER_BINARY_SECTION;
+        file.addSection(section, (uint32_t)(std::min(start + ENTITIES_PER_BINARY_SECTION, entities.size()) - start));
+    }
+    return success;
+}
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+bool EntityTree::readFromBinary(const OctreeBinaryFile& file) {
+    if (!file.getID().isNull()) {
+        _persistID = file.getID();
+    }
+    _persistDataVersion = file.getDataVersion();
+    _namedPaths.clear();
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
+    // decode the sections in parallel, then add all of the entities to the tree
+    QVector<QFuture<std::vector<DecodedEntity>>> sections;
+    for (const OctreeBinaryFile::Section& section : file.getSections()) {
+        sections.push_back(QtConcurrent::run([&file, section] {
+            std::vector<DecodedEntity> decoded;
+            decoded.reserve(section.numItems);
+            bool complete = file.forEachItem(section, [&](const unsigned char* data, int size) {
+                DecodedEntity entity;
+                int processedBytes;
+                if (!EntityItemProperties::decodeEntityEditPacket(data, size, processedBytes, entity.first, entity.second)) {
+                    return false;
                 }
-
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
+                decoded.push_back(std::move(entity));
+                return true;
+            });
+            if (!complete || decoded.size() != section.numItems) {
+                qCWarning(entities) << "Binary persist file section has" << (int)decoded.size() << "of its"
+                                    << section.numItems << "entities";
             }
+            return decoded;
+        }));
+    }
+
+    bool success = true;
+    std::vector<DecodedEntity> loadedEntities;
+    for (int i = 0; i < sections.size(); ++i) {
+        std::vector<DecodedEntity> decoded = sections[i].result();
+        if (decoded.size() != file.getSections()[i].numItems) {
+            success = false;
         }
+        std::move(decoded.begin(), decoded.end(), std::back_inserter(loadedEntities));
+    }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+    return addLoadedEntities(loadedEntities) && success;
+}
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
-            }
+bool EntityTree::addLoadedEntities(const std::vector<DecodedEntity>& loadedEntities) {
+    // order the entities so that the parent of each one, if it's also being added, comes before it
+    const int numEntities = (int)loadedEntities.size();
+    QHash<QUuid, int> entityIndices;
+    entityIndices.reserve(numEntities);
+    for (int i = 0; i < numEntities; ++i) {
+        entityIndices[loadedEntities[i].first] = i;
+    }
+    std::vector<std::vector<int>> children(numEntities);
+    std::vector<int> order;
+    order.reserve(numEntities);
+    for (int i = 0; i < numEntities; ++i) {
+        const QUuid& parentID = loadedEntities[i].second.getParentID();
+        auto parent = parentID.isNull() ? entityIndices.end() : entityIndices.find(parentID);
+        if (parent != entityIndices.end() && parent.value() != i) {
+            children[parent.value()].push_back(i);
+        } else {
+            order.push_back(i);
         }
-
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+    }
+    for (size_t next = 0; next < order.size(); ++next) {
+        for (int child : children[order[next]]) {
+            order.push_back(child);
         }
-
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+    }
+    if ((int)order.size() < numEntities) {
+        // entities whose parents are each other's descendants are never reached, add them as they were given
+        std::vector<bool> ordered(numEntities, false);
+        for (int i : order) {
+            ordered[i] = true;
         }
-
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
+        for (int i = 0; i < numEntities; ++i) {
+            if (!ordered[i]) {
+                order.push_back(i);
             }
         }
+    }
 
-        EntityItemPointer entity = addEntity(entityItemID, properties);
+    // the children aren't hooked up to their parents as each entity is added, but all at once after they've been added
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = true;
+    _deferParentFixups = true;
+    for (int i : order) {
+        const DecodedEntity& entry = loadedEntities[i];
+        EntityItemPointer entity = addEntity(entry.first, entry.second);
         if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+            qCDebug(entities) << "adding Entity failed:" << entry.first << entry.second.getType();
             success = false;
+            continue;
         }
-
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
-            }
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
         }
     }
+    _deferParentFixups = false;
+    fixupNeedsParentFixups();
 
     for (const auto& entityID : cloneIDs.keys()) {
         auto entity = findEntityByID(entityID);
@@ -3054,17 +3520,125 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return success;
 }
 
-bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
-    QScriptEngine scriptEngine;
-    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
-    withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
-    });
+void EntityTree::markChangedForJournal(const EntityItemID& entityID, bool exists) {
+    if (_wantJournal) {
+        std::lock_guard<std::mutex> lock(_journalChangesMutex);
+        _journalChanges[entityID] = exists;
+    }
+}
 
-    jsonString = theOperator.getJson();
+bool EntityTree::takeJournalChanges(QByteArray& changes) {
+    QHash<EntityItemID, bool> journalChanges;
+    {
+        std::lock_guard<std::mutex> lock(_journalChangesMutex);
+        journalChanges.swap(_journalChanges);
+    }
+    if (journalChanges.isEmpty()) {
+        return false;
+    }
+
+    // the entities that were added or edited, with all of their properties, then the IDs of the ones that were deleted
+    QByteArray changed;
+    uint32_t numChanged = 0;
+    QByteArray deleted;
+    uint32_t numDeleted = 0;
+    for (auto itr = journalChanges.constBegin(); itr != journalChanges.constEnd(); ++itr) {
+        // an entity that's been deleted since it was changed is marked again, and deleted by the next entry too
+        EntityItemPointer entity = itr.value() ? findEntityByEntityItemID(itr.key()) : EntityItemPointer();
+        if (entity) {
+            if (encodeEntityForBinaryFile(entity, changed)) {
+                ++numChanged;
+            }
+        } else {
+            deleted.append(itr.key().toRfc4122());
+            ++numDeleted;
+        }
+    }
+
+    changes.append(reinterpret_cast<const char*>(&numChanged), sizeof(numChanged));
+    changes.append(changed);
+    changes.append(reinterpret_cast<const char*>(&numDeleted), sizeof(numDeleted));
+    changes.append(deleted);
+    return true;
+}
+
+bool EntityTree::replayJournalChanges(const QByteArray& changes) {
+    const char* dataAt = changes.constData();
+    const char* end = dataAt + changes.size();
+    auto readCount = [&](uint32_t& count) {
+        if ((size_t)(end - dataAt) < sizeof(count)) {
+            return false;
+        }
+        memcpy(&count, dataAt, sizeof(count));
+        dataAt += sizeof(count);
+        return true;
+    };
+
+    uint32_t numChanged;
+    if (!readCount(numChanged)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < numChanged; ++i) {
+        uint32_t size;
+        if (!readCount(size) || (uint32_t)(end - dataAt) < size) {
+            return false;
+        }
+        EntityItemID entityID;
+        EntityItemProperties properties;
+        int processedBytes;
+        if (!EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(dataAt), size,
+                                                          processedBytes, entityID, properties)) {
+            return false;
+        }
+        dataAt += size;
+        replayJournaledEntity(entityID, properties);
+    }
+
+    uint32_t numDeleted;
+    if (!readCount(numDeleted) || (uint32_t)(end - dataAt) < numDeleted * NUM_BYTES_RFC4122_UUID) {
+        return false;
+    }
+    for (uint32_t i = 0; i < numDeleted; ++i) {
+        EntityItemID entityID(QUuid::fromRfc4122(QByteArray::fromRawData(dataAt, NUM_BYTES_RFC4122_UUID)));
+        dataAt += NUM_BYTES_RFC4122_UUID;
+        deleteEntity(entityID, true, true);
+    }
+
+    fixupNeedsParentFixups();
     return true;
 }
 
+void EntityTree::replayJournaledEntity(const EntityItemID& entityID, const EntityItemProperties& properties) {
+    EntityItemPointer entity = findEntityByEntityItemID(entityID);
+    if (!entity) {
+        if (!addEntity(entityID, properties)) {
+            qCDebug(entities) << "replaying added Entity failed:" << entityID << properties.getType();
+        }
+        return;
+    }
+
+    EntityTreeElementPointer containingElement = entity->getElement();
+    if (!containingElement) {
+        return;
+    }
+
+    // the tree accepted these properties before they were journaled, so they aren't checked against the locked
+    // property or the simulation owner the way updateEntity() checks edits
+    AACube newQueryAACube = properties.queryAACubeChanged() ? properties.getQueryAACube() : entity->getQueryAACube();
+    UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
+    recurseTreeWithOperator(&theOperator);
+    entity->setProperties(properties);
+    if (!entity->getParentID().isNull()) {
+        addToNeedsParentFixupList(entity);
+    }
+    if (!entity->isSimulated()) {
+        entity->clearDirtyFlags();
+    } else if (entity->getDirtyFlags() & DIRTY_SIMULATION_FLAGS) {
+        _simulation->changeEntity(entity);
+    }
+    _isDirty = true;
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
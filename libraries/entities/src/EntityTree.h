@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <mutex>
+
 #include <QSet>
 #include <QVector>
 
@@ -19,7 +21,10 @@
 #include <SpatialParentFinder.h>
 
 #include "AddEntityOperator.h"
+#include "EntityMap.h"
+#include "EntitySpatialIndex.h"
 #include "EntityTreeElement.h"
+#include "EntityTreeSnapshot.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
 
@@ -122,6 +127,26 @@ public:
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
 
+    // Edits that only change properties which don't move the entity in the tree or change how it is simulated
+    // (name, user data, color...) are applied under the read lock, alongside the send threads, instead of the
+    // write lock. The entity's own lock protects its properties.
+    static bool canUpdateEntityInPlace(const EntityItemProperties& properties);
+    // call with the read lock, returns false if the edit still needs updateEntity(), which is safe to apply twice
+    bool updateEntityInPlace(EntityItemPointer entity, const EntityItemProperties& properties);
+    // reads an edit packet straight into its entity, in place, when it only has properties that
+    // EntityItem::readEditFromBuffer() reads and doesn't need to be filtered or logged, returns the number of bytes
+    // read or 0 if the edit needs to be decoded and applied with updateEntity()
+    int readEditInPlace(const unsigned char* editData, int maxLength, const SharedNodePointer& senderNode);
+
+    // A read-only view of the tree for the entity server send threads. A new one is made, sharing what hasn't changed
+    // with the last one, by the first caller after the tree changes; callers racing it get the last one meanwhile.
+    EntityTreeSnapshotPointer getSnapshot();
+
+    EntitySpatialIndex& getSpatialIndex() { return _spatialIndex; }
+    // whether the eval...() searches use the spatial index, or recurse through the elements
+    void setUseSpatialIndex(bool value) { _useSpatialIndex = value; }
+    bool getUseSpatialIndex() const { return _useSpatialIndex; }
+
     // check if the avatar is a child of this entity, If so set the avatar parentID to null
     void unhookChildAvatar(const EntityItemID entityID);
     void cleanupCloneIDs(const EntityItemID& entityID);
@@ -195,6 +220,13 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    // the binary persist file has each entity encoded like an add packet, it's decoded with decodeEntityEditPacket
+    virtual bool writeToBinary(OctreeBinaryFile& file) override;
+    virtual bool readFromBinary(const OctreeBinaryFile& file) override;
+    // journal entries have the entities that were added or edited encoded like they are in the binary persist file, and
+    // the IDs of the ones that were deleted
+    virtual bool takeJournalChanges(QByteArray& changes) override;
+    virtual bool replayJournalChanges(const QByteArray& changes) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -203,6 +235,7 @@ public:
     virtual void resetEditStats() override {
         _totalEditMessages = 0;
         _totalUpdates = 0;
+        _totalInPlaceUpdates = 0;
         _totalCreates = 0;
         _totalDecodeTime = 0;
         _totalLookupTime = 0;
@@ -217,6 +250,7 @@ public:
     virtual quint64 getAverageCreateTime() const override { return _totalCreates == 0 ? 0 : _totalCreateTime / _totalCreates; }
     virtual quint64 getAverageLoggingTime() const override { return _totalEditMessages == 0 ? 0 : _totalLoggingTime / _totalEditMessages; }
     virtual quint64 getAverageFilterTime() const override { return _totalEditMessages == 0 ? 0 : _totalFilterTime / _totalEditMessages; }
+    int getTotalInPlaceUpdates() const { return _totalInPlaceUpdates; }
 
     void trackIncomingEntityLastEdited(quint64 lastEditedTime, int bytesRead);
     quint64 getAverageEditDeltas() const
@@ -294,6 +328,10 @@ protected:
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
             const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
+    void markPathToElementChanged(const EntityTreeElementPointer& element);
+    bool canEditInPlace(const EntityItemPointer& entity, const EntityTreeElementPointer& containingElement) const;
+    void markEditedInPlace(const EntityItemPointer& entity, const EntityTreeElementPointer& containingElement,
+            uint32_t preFlags);
     static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
     static void bumpTimestamp(EntityItemProperties& properties);
 
@@ -320,8 +358,13 @@ protected:
         _deletedEntityItemIDs << id;
     }
 
-    mutable QReadWriteLock _entityMapLock;
-    QHash<EntityItemID, EntityItemPointer> _entityMap;
+    EntityMap _entityMap;
+
+    EntitySpatialIndex _spatialIndex;
+    bool _useSpatialIndex { true };
+
+    EntityTreeSnapshotPointer _snapshot; // use std::atomic_load/atomic_store
+    std::mutex _snapshotMutex;
 
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
@@ -338,6 +381,7 @@ protected:
     // some performance tracking properties - only used in server trees
     int _totalEditMessages = 0;
     int _totalUpdates = 0;
+    int _totalInPlaceUpdates = 0;
     int _totalCreates = 0;
     quint64 _totalDecodeTime = 0;
     quint64 _totalLookupTime = 0;
@@ -357,6 +401,7 @@ protected:
     void fixupNeedsParentFixups(); // try to hook members of _needsParentFixup to parent instances
     QVector<EntityItemWeakPointer> _needsParentFixup; // entites with a parentID but no (yet) known parent instance
     mutable QReadWriteLock _needsParentFixupLock;
+    bool _deferParentFixups { false }; // entities of a file being loaded are hooked up after they've all been added
 
     // we maintain a list of avatarIDs to notice when an entity is a child of one.
     QSet<QUuid> _avatarIDs; // IDs of avatars connected to entity server
@@ -393,6 +438,18 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    // converts an entity read from a JSON file to properties, fixing up content from older versions
+    void entityPropertiesFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                 EntityItemID& entityItemID, EntityItemProperties& properties);
+    // adds the entities read from a file with their parents before them, then hooks the children up in one pass
+    bool addLoadedEntities(const std::vector<std::pair<EntityItemID, EntityItemProperties>>& loadedEntities);
+
+    // the entities that were added or edited (true) or deleted (false) since the journal changes were last taken
+    void markChangedForJournal(const EntityItemID& entityID, bool exists);
+    void replayJournaledEntity(const EntityItemID& entityID, const EntityItemProperties& properties);
+    std::mutex _journalChangesMutex;
+    QHash<EntityItemID, bool> _journalChanges;
+
     void updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                        MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
 };
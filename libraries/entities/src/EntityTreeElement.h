@@ -135,6 +135,13 @@ public:
     virtual bool deleteApproved() const override { return !hasEntities(); }
 
     static bool checkFilterSettings(const EntityItemPointer& entity, PickFilter searchFilter);
+    // the tests evalDetailedRayIntersection() and evalEntitiesInSphere() make on each entity, also used by EntityTree
+    // when it queries its EntitySpatialIndex
+    static bool evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction,
+        OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, QVariantMap& extraInfo);
+    static bool entityIntersectsSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
     virtual bool canPickIntersect() const override { return hasEntities(); }
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
@@ -165,6 +172,9 @@ public:
         });
     }
 
+    // an implicitly shared copy, that later changes to this element don't affect
+    EntityItems getEntitiesCopy() const { return resultWithReadLock<EntityItems>([&] { return _entityItems; }); }
+
     virtual uint16_t size() const;
     bool hasEntities() const { return size() > 0; }
 
@@ -0,0 +1,55 @@
+//
+//  EntityTreeSnapshot.cpp
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 2019-06-21.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshot.h"
+
+#include <SharedUtil.h>
+
+EntityTreeSnapshot::EntityTreeSnapshot(const EntityTreeElementPointer& root,
+                                       const std::shared_ptr<const EntityTreeSnapshot>& previous) {
+    // adds, deletes and moves take the write lock and can't run while this copies, but in-place edits
+    // (EntityTree::updateEntityInPlace and readEditInPlace) run under the read lock alongside it. Those change the
+    // entity first and only then mark the path to its element changed, so an edit marked at or before this time was
+    // made before the copy started and is in it, and one marked later makes the next snapshot copy that path again
+    _timestamp = usecTimestampNow() - 1;
+    if (previous) {
+        _root = copyElement(root, previous->_root, previous->_timestamp);
+    } else {
+        _root = copyElement(root, ElementPointer(), 0);
+    }
+}
+
+EntityTreeSnapshot::ElementPointer EntityTreeSnapshot::copyElement(const EntityTreeElementPointer& element,
+                                                                   const ElementPointer& previous,
+                                                                   uint64_t previousTimestamp) {
+    bool hadCopy = previous && previous->isCopyOf(element);
+    uint64_t lastChanged = element->getLastChanged();
+    uint64_t lastChangedContent = element->getLastChangedContent();
+    if (hadCopy && lastChanged <= previousTimestamp && lastChangedContent <= previousTimestamp) {
+        // nothing in this subtree changed
+        return previous;
+    }
+
+    auto copy = std::make_shared<Element>();
+    copy->_source = element;
+    copy->_cube = element->getAACube();
+    copy->_lastChanged = lastChanged;
+    copy->_lastChangedContent = lastChangedContent;
+    copy->_entities = (hadCopy && lastChangedContent <= previousTimestamp) ? previous->_entities : element->getEntitiesCopy();
+
+    for (int i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+        EntityTreeElementPointer child = element->getChildAtIndex(i);
+        if (child) {
+            copy->_children[i] = copyElement(child, hadCopy ? previous->_children[i] : ElementPointer(), previousTimestamp);
+        }
+    }
+    return copy;
+}
@@ -0,0 +1,88 @@
+//
+//  EntityTreeSnapshot.h
+//  libraries/entities/src
+//
+//  Created by High Fidelity on 2019-06-21.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_EntityTreeSnapshot_h
+#define hifi_EntityTreeSnapshot_h
+
+#include <array>
+#include <memory>
+
+#include <AACube.h>
+#include <OctreeConstants.h>
+
+#include "EntityTreeElement.h"
+
+// An immutable copy of the elements of an EntityTree, and of which entities are in each of them, that the entity
+// server send threads traverse without holding the tree lock.
+//
+// A new snapshot is made when the tree has changed since the last one, and shares with it every element that
+// hasn't changed. This relies on every change to an element also marking its ancestors as changed, which is what
+// repeat traversals rely on to skip unchanged subtrees. Entities aren't copied, their properties are read under
+// their own locks.
+class EntityTreeSnapshot {
+public:
+    class Element;
+    using ElementPointer = std::shared_ptr<const Element>;
+
+    class Element {
+    public:
+        const AACube& getAACube() const { return _cube; }
+        const ElementPointer& getChildAtIndex(int childIndex) const { return _children[childIndex]; }
+        uint64_t getLastChanged() const { return _lastChanged; }
+        uint64_t getLastChangedContent() const { return _lastChangedContent; }
+
+        bool hasContent() const { return !_entities.isEmpty(); }
+        template <typename F>
+        void forEachEntity(F f) const {
+            for (const EntityItemPointer& entity : _entities) {
+                f(entity);
+            }
+        }
+
+    private:
+        friend class EntityTreeSnapshot;
+
+        bool isCopyOf(const EntityTreeElementPointer& element) const {
+            // compares ownership, so an element allocated where a deleted one was is never mistaken for it
+            return !_source.owner_before(element) && !element.owner_before(_source);
+        }
+
+        EntityTreeElementWeakPointer _source;
+        AACube _cube;
+        uint64_t _lastChanged { 0 };
+        uint64_t _lastChangedContent { 0 };
+        EntityItems _entities;
+        std::array<ElementPointer, NUMBER_OF_CHILDREN> _children;
+    };
+
+    // call with the tree lock, previous may be null
+    EntityTreeSnapshot(const EntityTreeElementPointer& root, const std::shared_ptr<const EntityTreeSnapshot>& previous);
+
+    const ElementPointer& getRoot() const { return _root; }
+    // elements that changed after this time are as they were before the change
+    uint64_t getTimestamp() const { return _timestamp; }
+    bool isOlderThan(const EntityTreeElementPointer& root) const {
+        return !_root->isCopyOf(root) || root->getLastChanged() > _timestamp;
+    }
+
+private:
+    static ElementPointer copyElement(const EntityTreeElementPointer& element, const ElementPointer& previous,
+                                      uint64_t previousTimestamp);
+
+    ElementPointer _root;
+    uint64_t _timestamp { 0 };
+};
+
+using EntityTreeSnapshotPointer = std::shared_ptr<const EntityTreeSnapshot>;
+
+#endif // hifi_EntityTreeSnapshot_h
@@ -13,7 +13,7 @@
 
 #include <QtCore/QObject>
 
-#include <ByteCountCoding.h>
+#include <BufferParser.h>
 #include <Octree.h>
 
 #include "EntityItem.h"
@@ -113,6 +113,22 @@ EntityItemPointer EntityTypes::constructEntityItem(EntityType entityType, const
     return newEntityItem;
 }
 
+EntityItemPointer EntityTypes::constructEntityItemWithDefaults(EntityType entityType, const EntityItemID& entityID) {
+    // the defaults with all their properties marked changed, which every entity read from a packet starts with
+    static const EntityItemProperties DEFAULT_PROPERTIES = [] {
+        EntityItemProperties properties;
+        properties.markAllChanged();
+        return properties;
+    }();
+
+    EntityItemPointer newEntityItem = NULL;
+    if (entityType >= 0 && entityType < NUM_TYPES && _factories[entityType]) {
+        newEntityItem = _factories[entityType](entityID, DEFAULT_PROPERTIES);
+        newEntityItem->moveToThread(qApp->thread());
+    }
+    return newEntityItem;
+}
+
 void EntityTypes::extractEntityTypeAndID(const unsigned char* data, int dataLength, EntityTypes::EntityType& typeOut, QUuid& idOut) {
 
     // Header bytes
@@ -125,19 +141,10 @@ void EntityTypes::extractEntityTypeAndID(const unsigned char* data, int dataLeng
     const int MINIMUM_HEADER_BYTES = 27;
 
     if (dataLength >= MINIMUM_HEADER_BYTES) {
-        int bytesRead = 0;
-        QByteArray originalDataBuffer = QByteArray::fromRawData((const char*)data, dataLength);
-
-        // id
-        QByteArray encodedID = originalDataBuffer.mid(bytesRead, NUM_BYTES_RFC4122_UUID); // maximum possible size
-        idOut = QUuid::fromRfc4122(encodedID);
-        bytesRead += encodedID.size();
-
-        // type
-        QByteArray encodedType = originalDataBuffer.mid(bytesRead); // maximum possible size
-        ByteCountCoded<quint32> typeCoder = encodedType;
-        encodedType = typeCoder; // determine true length
-        quint32 type = typeCoder;
+        BufferParser parser(data, dataLength);
+        parser.readUuid(idOut);
+        quint32 type;
+        parser.readCompressedCount(type);
         typeOut = (EntityTypes::EntityType)type;
     }
 }
@@ -147,9 +154,7 @@ EntityItemPointer EntityTypes::constructEntityItem(const unsigned char* data, in
     EntityTypes::EntityType type = EntityTypes::Unknown;
     extractEntityTypeAndID(data, bytesToRead, type, id);
     if (type > EntityTypes::Unknown && type <= EntityTypes::NUM_TYPES) {
-        EntityItemID tempEntityID(id);
-        EntityItemProperties tempProperties;
-        return constructEntityItem(type, tempEntityID, tempProperties);
+        return constructEntityItemWithDefaults(type, EntityItemID(id));
     }
     return nullptr;
 }
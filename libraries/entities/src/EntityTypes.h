@@ -121,6 +121,8 @@ public:
     static EntityItemPointer constructEntityItem(const QUuid& id, const EntityItemProperties& properties);
 
 private:
+    static EntityItemPointer constructEntityItemWithDefaults(EntityType entityType, const EntityItemID& entityID);
+
     static QMap<EntityType, QString> _typeToNameMap;
     static QMap<QString, EntityTypes::EntityType> _nameToTypeMap;
     static EntityTypeFactory _factories[NUM_TYPES];
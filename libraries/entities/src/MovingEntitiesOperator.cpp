@@ -62,6 +62,8 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
     if (!oldContainingElement) {
         return; // bail without adding.
     }
+    // even if it stays in its element, it may move in the spatial index
+    oldContainingElement->getTree()->getSpatialIndex().update(entity);
 
     // If the original containing element is the best fit for the requested newCube locations then
     // we don't actually need to add the entity for moving and we can short circuit all this work
@@ -31,6 +31,9 @@ UpdateEntityOperator::UpdateEntityOperator(EntityTreePointer tree,
     // caller must have verified existence of containingElement and oldEntity
     assert(_containingElement && _existingEntity);
 
+    // the entity's query cube is set after this, it is placed in the spatial index again when it is next searched
+    _tree->getSpatialIndex().update(_existingEntity);
+
     if (_wantDebug) {
         qCDebug(entities) << "UpdateEntityOperator::UpdateEntityOperator() -----------------------------";
     }
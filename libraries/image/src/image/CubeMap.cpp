@@ -16,6 +16,7 @@
 #include "RandomAndNoise.h"
 #include "BRDF.h"
 #include "ImageLogging.h"
+#include "TextureProcessing.h"
 
 #ifndef M_PI
 #define M_PI    3.14159265359
@@ -611,28 +612,30 @@ void CubeMap::convolveMipFaceForGGX(const GGXSamples& samples, CubeMap& output,
     const auto outputLineStride = output.getMipLineStride(mipLevel);
     auto outputFacePixels = output.editFace(mipLevel, face);
 
-    tbb::parallel_for(tbb::blocked_range2d<int, int>(0, mipDimensions.y, 32, 0, mipDimensions.x, 32), [&](const tbb::blocked_range2d<int, int>& range) {
-        auto rowRange = range.rows();
-        auto colRange = range.cols();
+    image::runWithinProcessingThreads([&] {
+        tbb::parallel_for(tbb::blocked_range2d<int, int>(0, mipDimensions.y, 32, 0, mipDimensions.x, 32), [&](const tbb::blocked_range2d<int, int>& range) {
+            auto rowRange = range.rows();
+            auto colRange = range.cols();
 
-        for (auto y = rowRange.begin(); y < rowRange.end(); y++) {
-            if (abortProcessing.load()) {
-                break;
-            }
+            for (auto y = rowRange.begin(); y < rowRange.end(); y++) {
+                if (abortProcessing.load()) {
+                    break;
+                }
 
-            const float yAlpha = (y + 0.5f) / mipDimensions.y;
-            const glm::vec3 normalXLo = faceNormals[0] + deltaYNormalLo * yAlpha;
-            const glm::vec3 normalXHi = faceNormals[1] + deltaYNormalHi * yAlpha;
-            const glm::vec3 deltaXNormal = normalXHi - normalXLo;
+                const float yAlpha = (y + 0.5f) / mipDimensions.y;
+                const glm::vec3 normalXLo = faceNormals[0] + deltaYNormalLo * yAlpha;
+                const glm::vec3 normalXHi = faceNormals[1] + deltaYNormalHi * yAlpha;
+                const glm::vec3 deltaXNormal = normalXHi - normalXLo;
 
-            for (auto x = colRange.begin(); x < colRange.end(); x++) {
-                const float xAlpha = (x + 0.5f) / mipDimensions.x;
-                // Interpolate normal for this pixel
-                const glm::vec3 normal = glm::normalize(normalXLo + deltaXNormal * xAlpha);
+                for (auto x = colRange.begin(); x < colRange.end(); x++) {
+                    const float xAlpha = (x + 0.5f) / mipDimensions.x;
+                    // Interpolate normal for this pixel
+                    const glm::vec3 normal = glm::normalize(normalXLo + deltaXNormal * xAlpha);
 
-                outputFacePixels[x + y * outputLineStride] = computeConvolution(normal, samples);
+                    outputFacePixels[x + y * outputLineStride] = computeConvolution(normal, samples);
+                }
             }
-        }
+        });
     });
 }
 
@@ -73,18 +73,7 @@ Image Image::getScaled(glm::uvec2 dstSize, AspectRatioMode ratioMode, Transforma
         } else {
             // Start by converting to full float
             glm::vec4* floatPixels = new glm::vec4[getWidth()*getHeight()];
-            auto unpackFunc = getHDRUnpackingFunction();
-            auto floatDataIt = floatPixels;
-            for (glm::uint32 lineNb = 0; lineNb < getHeight(); lineNb++) {
-                const glm::uint32* srcPixelIt = reinterpret_cast<const glm::uint32*>(getScanLine((int)lineNb));
-                const glm::uint32* srcPixelEnd = srcPixelIt + getWidth();
-
-                while (srcPixelIt < srcPixelEnd) {
-                    *floatDataIt = glm::vec4(unpackFunc(*srcPixelIt), 1.0f);
-                    ++srcPixelIt;
-                    ++floatDataIt;
-                }
-            }
+            convertToFloatFromPacked(getBits(), _dims.x, _dims.y, getBytesPerLineCount(), gpu::Element::COLOR_R11G11B10, floatPixels, _dims.x);
 
             // Perform filtered resize with NVTT
             static_assert(sizeof(glm::vec4) == 4 * sizeof(float), "Assuming glm::vec4 holds 4 floats");
@@ -122,20 +111,8 @@ Image Image::getScaled(glm::uvec2 dstSize, AspectRatioMode ratioMode, Transforma
         } else {
             // And convert back to original format
             QImage resizedImage((int)dstSize.x, (int)dstSize.y, (QImage::Format)Image::Format_PACKED_FLOAT);
-
-            auto packFunc = getHDRPackingFunction();
-            for (glm::uint32 lineNb = 0; lineNb < dstSize.y; lineNb++) {
-                glm::uint32* dstPixelIt = reinterpret_cast<glm::uint32*>(resizedImage.scanLine((int)lineNb));
-                glm::uint32* dstPixelEnd = dstPixelIt + dstSize.x;
-
-                while (dstPixelIt < dstPixelEnd) {
-                    *dstPixelIt = packFunc(glm::vec3(*srcRedIt, *srcGreenIt, *srcBlueIt));
-                    ++srcRedIt;
-                    ++srcGreenIt;
-                    ++srcBlueIt;
-                    ++dstPixelIt;
-                }
-            }
+            convertToPackedFromFloatChannels(resizedImage.bits(), (int)dstSize.x, (int)dstSize.y, resizedImage.bytesPerLine(),
+                                             gpu::Element::COLOR_R11G11B10, srcRedIt, srcGreenIt, srcBlueIt);
             return resizedImage;
         }
     } else {
@@ -160,16 +137,10 @@ Image Image::getConvertedToFormat(Format newFormat) const {
 
             default:
             {
-                auto unpackFunc = getHDRUnpackingFunction();
-                const glm::uint32* srcIt = reinterpret_cast<const glm::uint32*>(getBits());
-
-                for (int y = 0; y < _dims.y; y++) {
-                    for (int x = 0; x < _dims.x; x++) {
-                        auto color = glm::clamp(unpackFunc(*srcIt) * MAX_COLOR_VALUE, 0.0f, 255.0f);
-                        newImage.setPackedPixel(x, y, qRgb(color.r, color.g, color.b));
-                        srcIt++;
-                    }
-                }
+                Image colorImage(_dims.x, _dims.y, Format_ARGB32);
+                convertToColorFromPacked(getBits(), _dims.x, _dims.y, getBytesPerLineCount(), gpu::Element::COLOR_R11G11B10,
+                                         colorImage.editBits(), colorImage.getBytesPerLineCount());
+                newImage = colorImage.getConvertedToFormat(newFormat);
                 break;
             }
         }
@@ -213,17 +184,8 @@ Image Image::getConvertedToFormat(Format newFormat) const {
                 }
             }
         } else {
-            auto packFunc = getHDRPackingFunction();
-            glm::uint32* dstIt = reinterpret_cast<glm::uint32*>( newImage.editBits() );
-
-            for (int y = 0; y < _dims.y; y++) {
-                auto line = (const QRgb*)getScanLine(y);
-                for (int x = 0; x < _dims.x; x++) {
-                    QRgb pixel = line[x];
-                    *dstIt = packFunc(glm::vec3(qRed(pixel), qGreen(pixel), qBlue(pixel)) / MAX_COLOR_VALUE);
-                    dstIt++;
-                }
-            }
+            convertToPackedFromColor(newImage.editBits(), _dims.x, _dims.y, newImage.getBytesPerLineCount(), gpu::Element::COLOR_R11G11B10,
+                                     getBits(), getBytesPerLineCount());
         }
         return newImage;
     }
@@ -75,20 +75,10 @@ image::Image image::readOpenEXR(QIODevice& content, const std::string& filename)
         file.readPixels(viewport.min.y, viewport.max.y);
 
         Image image{ width, height, Image::Format_PACKED_FLOAT };
-        auto packHDRPixel = getHDRPackingFunction();
-        
-        for (int y = 0; y < height; y++) {
-            const auto srcScanline = pixels[y];
-            gpu::uint32* dstScanline = (gpu::uint32*) image.editScanLine(y);
-
-            for (int x = 0; x < width; x++) {
-                const auto& srcPixel = srcScanline[x];
-                auto& dstPixel = dstScanline[x];
-                glm::vec3 floatPixel{ srcPixel.r, srcPixel.g, srcPixel.b };
-
-                dstPixel = packHDRPixel(floatPixel);
-            }
-        }
+        // a half is its IEEE 754 bits, an Rgba pixel is four of them
+        static_assert(sizeof(Imf::Rgba) == 4 * sizeof(uint16_t), "Imf::Rgba is expected to be 4 halves");
+        convertToHDRFromHalfFloat(image.editBits(), width, height, image.getBytesPerLineCount(),
+                                  reinterpret_cast<const uint16_t*>(&pixels[0][0]), width);
         return image;
     } else {
         qWarning(imagelogging) << "OpenEXR - File " << filename.c_str() << " doesn't have the proper format";
@@ -19,6 +19,10 @@
 #include <QBuffer>
 #include <QImageReader>
 
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
+
 #include <Finally.h>
 #include <Profile.h>
 #include <StatTracker.h>
@@ -42,6 +46,8 @@ using namespace gpu;
 static const glm::uvec2 SPARSE_PAGE_SIZE(128);
 static const glm::uvec2 MAX_TEXTURE_SIZE_GLES(2048);
 static const glm::uvec2 MAX_TEXTURE_SIZE_GL(4096);
+// Images are processed in parallel over their rows, this many at a time
+static const int ROWS_PER_TASK = 16;
 bool DEV_DECIMATE_TEXTURES = false;
 std::atomic<size_t> DECIMATED_TEXTURE_COUNT{ 0 };
 std::atomic<size_t> RECTIFIED_TEXTURE_COUNT{ 0 };
@@ -53,6 +59,33 @@ static const auto& GPU_CUBEMAP_HDR_FORMAT = gpu::Element::COLOR_R11G11B10;
 
 namespace image {
 
+static int maxProcessingThreads { 0 };
+static std::unique_ptr<tbb::task_arena> processingArena;
+
+void setMaxProcessingThreads(int maxThreads) {
+    maxProcessingThreads = std::max(maxThreads, 0);
+    processingArena.reset(maxProcessingThreads > 0 ? new tbb::task_arena(maxProcessingThreads) : nullptr);
+}
+
+int getMaxProcessingThreads() {
+    return maxProcessingThreads;
+}
+
+void runWithinProcessingThreads(const std::function<void()>& task) {
+    if (processingArena) {
+        processingArena->execute(task);
+    } else {
+        task();
+    }
+}
+
+template <typename Body>
+static void parallelForRows(int height, const Body& body) {
+    runWithinProcessingThreads([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(0, height, ROWS_PER_TASK), body);
+    });
+}
+
 uint rectifyDimension(const uint& dimension) {
     if (dimension == 0) {
         return 0;
@@ -217,12 +250,23 @@ static uint32 packUnorm4x8(const glm::vec3& color) {
     return glm::packUnorm4x8(glm::vec4(color, 1.0f));
 }
 
-static std::function<uint32(const glm::vec3&)> getHDRPackingFunction(const gpu::Element& format) {
+static glm::vec3 unpackUnorm4x8(uint32 packed) {
+    return glm::vec3(glm::unpackUnorm4x8(packed));
+}
+
+using PackFunction = uint32(*)(const glm::vec3&);
+using UnpackFunction = glm::vec3(*)(uint32);
+
+static bool isUnorm4x8Format(const gpu::Element& format) {
+    return format == gpu::Element::COLOR_RGBA_32 || format == gpu::Element::COLOR_SRGBA_32 || format == gpu::Element::COLOR_BGRA_32 || format == gpu::Element::COLOR_SBGRA_32;
+}
+
+static PackFunction getHDRPackingFunction(const gpu::Element& format) {
     if (format == gpu::Element::COLOR_RGB9E5) {
         return glm::packF3x9_E1x5;
     } else if (format == gpu::Element::COLOR_R11G11B10) {
         return packR11G11B10F;
-    } else if (format == gpu::Element::COLOR_RGBA_32 || format == gpu::Element::COLOR_SRGBA_32 || format == gpu::Element::COLOR_BGRA_32 || format == gpu::Element::COLOR_SBGRA_32) {
+    } else if (isUnorm4x8Format(format)) {
         return packUnorm4x8;
     } else {
         qCWarning(imagelogging) << "Unknown handler format";
@@ -235,13 +279,13 @@ std::function<uint32(const glm::vec3&)> getHDRPackingFunction() {
     return getHDRPackingFunction(GPU_CUBEMAP_HDR_FORMAT);
 }
 
-std::function<glm::vec3(gpu::uint32)> getHDRUnpackingFunction(const gpu::Element& format) {
+static UnpackFunction getHDRUnpackingFunction(const gpu::Element& format) {
     if (format == gpu::Element::COLOR_RGB9E5) {
         return glm::unpackF3x9_E1x5;
     } else if (format == gpu::Element::COLOR_R11G11B10) {
         return glm::unpackF2x11_1x10;
-    } else if (format == gpu::Element::COLOR_RGBA_32 || format == gpu::Element::COLOR_SRGBA_32 || format == gpu::Element::COLOR_BGRA_32 || format == gpu::Element::COLOR_SBGRA_32) {
-        return glm::unpackUnorm4x8;
+    } else if (isUnorm4x8Format(format)) {
+        return unpackUnorm4x8;
     } else {
         qCWarning(imagelogging) << "Unknown handler format";
         Q_UNREACHABLE();
@@ -306,36 +350,38 @@ void mapToRedChannel(Image& image, ColorChannel sourceChannel) {
         image = image.getConvertedToFormat(Image::Format_ARGB32);
     }
 
-    for (glm::uint32 i = 0; i < image.getHeight(); i++) {
-        QRgb* pixel = reinterpret_cast<QRgb*>(image.editScanLine(i));
-        // Past end pointer
-        QRgb* lineEnd = pixel + image.getWidth();
-
-        // Transfer channel data from source to target
-        for (; pixel < lineEnd; pixel++) {
-            int colorValue;
-            switch (sourceChannel) {
-            case ColorChannel::RED:
-                colorValue = qRed(*pixel);
-                break;
-            case ColorChannel::GREEN:
-                colorValue = qGreen(*pixel);
-                break;
-            case ColorChannel::BLUE:
-                colorValue = qBlue(*pixel);
-                break;
-            case ColorChannel::ALPHA:
-                colorValue = qAlpha(*pixel);
-                break;
-            default:
-                colorValue = qRed(*pixel);
-                break;
-            }
+    // Pick the source channel once, so that every pixel is the same shift and mask
+    int sourceShift;
+    switch (sourceChannel) {
+    case ColorChannel::GREEN:
+        sourceShift = 8;
+        break;
+    case ColorChannel::BLUE:
+        sourceShift = 0;
+        break;
+    case ColorChannel::ALPHA:
+        sourceShift = 24;
+        break;
+    case ColorChannel::RED:
+    default:
+        sourceShift = 16;
+        break;
+    }
+
+    const int width = image.getWidth();
+    const size_t bytesPerLine = image.getBytesPerLineCount();
+    unsigned char* bits = image.editBits();
+
+    parallelForRows((int)image.getHeight(), [&](const tbb::blocked_range<int>& rows) {
+        for (auto lineNb = rows.begin(); lineNb != rows.end(); lineNb++) {
+            QRgb* line = reinterpret_cast<QRgb*>(bits + lineNb * bytesPerLine);
 
             // Dump the color in the red channel, ignore the rest
-            *pixel = qRgba(colorValue, 0, 0, 255);
+            for (int x = 0; x < width; x++) {
+                line[x] = qRgba((line[x] >> sourceShift) & 0xFF, 0, 0, 255);
+            }
         }
-    }
+    });
 }
 
 gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::string& filename, ColorChannel sourceChannel,
@@ -381,6 +427,57 @@ gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::
     return texture;
 }
 
+// Whether an image is brought down to the target size by halving it some number of times
+static bool isHalvingOf(glm::uvec2 size, const glm::uvec2& targetSize) {
+    while (glm::all(glm::greaterThan(size, targetSize)) && size.x % 2 == 0 && size.y % 2 == 0) {
+        size /= 2u;
+    }
+    return size == targetSize;
+}
+
+// Halves an ARGB32 or RGB32 image with a 2x2 box filter, in parallel over the rows of the result. The color is
+// weighted by alpha, as the smooth scaling of QImage does by premultiplying it.
+static Image getHalved(const Image& image) {
+    const int width = image.getWidth() / 2;
+    const int height = image.getHeight() / 2;
+    Image halved(width, height, image.getFormat());
+
+    const unsigned char* srcBits = image.getBits();
+    const size_t srcBytesPerLine = image.getBytesPerLineCount();
+    unsigned char* dstBits = halved.editBits();
+    const size_t dstBytesPerLine = halved.getBytesPerLineCount();
+
+    parallelForRows(height, [&](const tbb::blocked_range<int>& rows) {
+        for (auto lineNb = rows.begin(); lineNb != rows.end(); lineNb++) {
+            const QRgb* top = reinterpret_cast<const QRgb*>(srcBits + (2 * lineNb) * srcBytesPerLine);
+            const QRgb* bottom = reinterpret_cast<const QRgb*>(srcBits + (2 * lineNb + 1) * srcBytesPerLine);
+            QRgb* dst = reinterpret_cast<QRgb*>(dstBits + lineNb * dstBytesPerLine);
+
+            for (int x = 0; x < width; x++) {
+                const QRgb pixels[4] = { top[2 * x], top[2 * x + 1], bottom[2 * x], bottom[2 * x + 1] };
+                int alpha = 0;
+                int red = 0;
+                int green = 0;
+                int blue = 0;
+                for (const QRgb pixel : pixels) {
+                    const int pixelAlpha = qAlpha(pixel);
+                    alpha += pixelAlpha;
+                    red += qRed(pixel) * pixelAlpha;
+                    green += qGreen(pixel) * pixelAlpha;
+                    blue += qBlue(pixel) * pixelAlpha;
+                }
+                if (alpha == 0) {
+                    dst[x] = qRgba(0, 0, 0, 0);
+                } else {
+                    dst[x] = qRgba((red + alpha / 2) / alpha, (green + alpha / 2) / alpha, (blue + alpha / 2) / alpha, (alpha + 2) / 4);
+                }
+            }
+        }
+    });
+
+    return halved;
+}
+
 Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
     PROFILE_RANGE(resource_parse, "processSourceImage");
 
@@ -414,6 +511,14 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
     if (targetSize != srcImageSize) {
         PROFILE_RANGE(resource_parse, "processSourceImage Rectify");
         qCDebug(imagelogging) << "Resizing texture from " << srcImageSize.x << "x" << srcImageSize.y << " to " << targetSize.x << "x" << targetSize.y;
+        // Textures over the size limit are usually brought down by halving them, which doesn't need a general filter
+        const auto format = localCopy.getFormat();
+        if ((format == Image::Format_ARGB32 || format == Image::Format_RGB32) && isHalvingOf(srcImageSize, targetSize)) {
+            while (localCopy.getSize() != targetSize) {
+                localCopy = getHalved(localCopy);
+            }
+            return localCopy;
+        }
         return localCopy.getScaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
     }
 
@@ -457,10 +562,10 @@ struct OutputHandler : public nvtt::OutputHandler {
     int _face = -1;
 };
 
+// Packs the floats written by nvtt to an HDR format, with the packing inlined in the loop for each format
+template <PackFunction pack>
 struct PackedFloatOutputHandler : public OutputHandler {
-    PackedFloatOutputHandler(gpu::Texture* texture, int face, gpu::Element format) : OutputHandler(texture, face) {
-        _packFunc = getHDRPackingFunction(format);
-    }
+    PackedFloatOutputHandler(gpu::Texture* texture, int face) : OutputHandler(texture, face) {}
 
     virtual void beginImage(int size, int width, int height, int depth, int face, int miplevel) override {
         // Divide by 3 because we will compress from 3*floats to 1 uint32
@@ -468,28 +573,47 @@ struct PackedFloatOutputHandler : public OutputHandler {
     }
     virtual bool writeData(const void* data, int size) override {
         // Expecting to write multiple of floats
-        if (_packFunc) {
-            assert((size % sizeof(float)) == 0);
-            auto floatCount = size / sizeof(float);
-            const float* floatBegin = (const float*)data;
-            const float* floatEnd = floatBegin + floatCount;
-
-            while (floatBegin < floatEnd) {
-                _pixel[_coordIndex] = *floatBegin;
-                floatBegin++;
-                _coordIndex++;
-                if (_coordIndex == 3) {
-                    uint32 packedRGB = _packFunc(_pixel);
-                    _coordIndex = 0;
-                    OutputHandler::writeData(&packedRGB, sizeof(packedRGB));
-                }
+        assert((size % sizeof(float)) == 0);
+        auto floatCount = size / sizeof(float);
+        const float* floatBegin = (const float*)data;
+        const float* floatEnd = floatBegin + floatCount;
+
+        // Finish the pixel split from the previous write
+        while (_coordIndex != 0 && floatBegin < floatEnd) {
+            writeCoord(*floatBegin);
+            floatBegin++;
+        }
+
+        // Pack the whole pixels and write them at once
+        auto pixelCount = (floatEnd - floatBegin) / 3;
+        if (pixelCount > 0) {
+            _packedPixels.resize(pixelCount);
+            for (auto i = 0; i < pixelCount; i++) {
+                _packedPixels[i] = pack(glm::vec3(floatBegin[3 * i], floatBegin[3 * i + 1], floatBegin[3 * i + 2]));
             }
-            return true;
+            OutputHandler::writeData(_packedPixels.data(), (int)(pixelCount * sizeof(uint32)));
+            floatBegin += 3 * pixelCount;
+        }
+
+        // Keep the start of a pixel split with the next write
+        while (floatBegin < floatEnd) {
+            writeCoord(*floatBegin);
+            floatBegin++;
+        }
+        return true;
+    }
+
+    void writeCoord(float coord) {
+        _pixel[_coordIndex] = coord;
+        _coordIndex++;
+        if (_coordIndex == 3) {
+            uint32 packedRGB = pack(_pixel);
+            _coordIndex = 0;
+            OutputHandler::writeData(&packedRGB, sizeof(packedRGB));
         }
-        return false;
     }
 
-    std::function<uint32(const glm::vec3&)> _packFunc;
+    std::vector<uint32> _packedPixels;
     glm::vec3 _pixel;
     int _coordIndex{ 0 };
 };
@@ -520,46 +644,113 @@ public:
 };
 #endif
 
-void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
-                              glm::vec4* output, size_t outputLinePixelStride) {
-    glm::vec4* outputIt;
-    auto unpackFunc = getHDRUnpackingFunction(sourceFormat);
-
-    outputLinePixelStride -= width;
-    outputIt = output;
-    for (auto lineNb = 0; lineNb < height; lineNb++) {
-        const uint32* srcPixelIt = reinterpret_cast<const uint32*>(source + lineNb * srcLineByteStride);
-        const uint32* srcPixelEnd = srcPixelIt + width;
-
-        while (srcPixelIt < srcPixelEnd) {
-            *outputIt = glm::vec4(unpackFunc(*srcPixelIt), 1.0f);
-            ++srcPixelIt;
-            ++outputIt;
+// The conversions are instanced per format on its packing function, so that the packing is inlined in the loop rather
+// than called through a std::function for every pixel. The other side of a conversion is a functor of the pixel coordinates.
+template <UnpackFunction unpack, typename Store>
+static void unpackRows(const unsigned char* source, int width, int height, size_t srcLineByteStride, const Store& store) {
+    parallelForRows(height, [&](const tbb::blocked_range<int>& rows) {
+        for (auto lineNb = rows.begin(); lineNb != rows.end(); lineNb++) {
+            const uint32* srcPixelIt = reinterpret_cast<const uint32*>(source + lineNb * srcLineByteStride);
+
+            for (int x = 0; x < width; x++) {
+                store(x, lineNb, unpack(srcPixelIt[x]));
+            }
         }
-        outputIt += outputLinePixelStride;
+    });
+}
+
+template <typename Store>
+static void unpackRows(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
+                       const Store& store) {
+    if (sourceFormat == gpu::Element::COLOR_RGB9E5) {
+        unpackRows<glm::unpackF3x9_E1x5>(source, width, height, srcLineByteStride, store);
+    } else if (sourceFormat == gpu::Element::COLOR_R11G11B10) {
+        unpackRows<glm::unpackF2x11_1x10>(source, width, height, srcLineByteStride, store);
+    } else if (isUnorm4x8Format(sourceFormat)) {
+        unpackRows<unpackUnorm4x8>(source, width, height, srcLineByteStride, store);
+    } else {
+        qCWarning(imagelogging) << "Unknown handler format";
+        Q_UNREACHABLE();
     }
 }
 
-void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
-                              const glm::vec4* source, size_t srcLinePixelStride) {
-    const glm::vec4* sourceIt;
-    auto packFunc = getHDRPackingFunction(outputFormat);
-
-    srcLinePixelStride -= width;
-    sourceIt = source;
-    for (auto lineNb = 0; lineNb < height; lineNb++) {
-        uint32* outPixelIt = reinterpret_cast<uint32*>(output + lineNb * outputLineByteStride);
-        uint32* outPixelEnd = outPixelIt + width;
-
-        while (outPixelIt < outPixelEnd) {
-            *outPixelIt = packFunc(*sourceIt);
-            ++outPixelIt;
-            ++sourceIt;
+template <PackFunction pack, typename Load>
+static void packRows(unsigned char* output, int width, int height, size_t outputLineByteStride, const Load& load) {
+    parallelForRows(height, [&](const tbb::blocked_range<int>& rows) {
+        for (auto lineNb = rows.begin(); lineNb != rows.end(); lineNb++) {
+            uint32* outPixelIt = reinterpret_cast<uint32*>(output + lineNb * outputLineByteStride);
+
+            for (int x = 0; x < width; x++) {
+                outPixelIt[x] = pack(load(x, lineNb));
+            }
         }
-        sourceIt += srcLinePixelStride;
+    });
+}
+
+template <typename Load>
+static void packRows(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
+                     const Load& load) {
+    if (outputFormat == gpu::Element::COLOR_RGB9E5) {
+        packRows<glm::packF3x9_E1x5>(output, width, height, outputLineByteStride, load);
+    } else if (outputFormat == gpu::Element::COLOR_R11G11B10) {
+        packRows<packR11G11B10F>(output, width, height, outputLineByteStride, load);
+    } else if (isUnorm4x8Format(outputFormat)) {
+        packRows<packUnorm4x8>(output, width, height, outputLineByteStride, load);
+    } else {
+        qCWarning(imagelogging) << "Unknown handler format";
+        Q_UNREACHABLE();
     }
 }
 
+void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
+                              glm::vec4* output, size_t outputLinePixelStride) {
+    unpackRows(source, width, height, srcLineByteStride, sourceFormat, [&](int x, int y, const glm::vec3& color) {
+        output[y * outputLinePixelStride + x] = glm::vec4(color, 1.0f);
+    });
+}
+
+void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
+                              const glm::vec4* source, size_t srcLinePixelStride) {
+    packRows(output, width, height, outputLineByteStride, outputFormat, [&](int x, int y) {
+        return glm::vec3(source[y * srcLinePixelStride + x]);
+    });
+}
+
+void convertToPackedFromFloatChannels(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
+                                      const float* red, const float* green, const float* blue) {
+    packRows(output, width, height, outputLineByteStride, outputFormat, [&](int x, int y) {
+        const int index = y * width + x;
+        return glm::vec3(red[index], green[index], blue[index]);
+    });
+}
+
+void convertToColorFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
+                              unsigned char* output, size_t outputLineByteStride) {
+    const float MAX_COLOR_VALUE = 255.0f;
+    unpackRows(source, width, height, srcLineByteStride, sourceFormat, [&](int x, int y, const glm::vec3& color) {
+        auto clampedColor = glm::clamp(color * MAX_COLOR_VALUE, 0.0f, MAX_COLOR_VALUE);
+        reinterpret_cast<QRgb*>(output + y * outputLineByteStride)[x] = qRgb((int)clampedColor.r, (int)clampedColor.g, (int)clampedColor.b);
+    });
+}
+
+void convertToPackedFromColor(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
+                              const unsigned char* source, size_t srcLineByteStride) {
+    const float MAX_COLOR_VALUE = 255.0f;
+    packRows(output, width, height, outputLineByteStride, outputFormat, [&](int x, int y) {
+        QRgb pixel = reinterpret_cast<const QRgb*>(source + y * srcLineByteStride)[x];
+        return glm::vec3(qRed(pixel), qGreen(pixel), qBlue(pixel)) / MAX_COLOR_VALUE;
+    });
+}
+
+void convertToHDRFromHalfFloat(unsigned char* output, int width, int height, size_t outputLineByteStride,
+                               const uint16_t* source, size_t srcLinePixelStride) {
+    const int NUM_CHANNELS = 4;
+    packRows(output, width, height, outputLineByteStride, GPU_CUBEMAP_HDR_FORMAT, [&](int x, int y) {
+        const uint16_t* pixel = source + (y * srcLinePixelStride + x) * NUM_CHANNELS;
+        return glm::vec3(glm::unpackHalf1x16(pixel[0]), glm::unpackHalf1x16(pixel[1]), glm::unpackHalf1x16(pixel[2]));
+    });
+}
+
 nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture, int face, nvtt::CompressionOptions& compressionOptions) {
     auto outputFormat = outputTexture->getStoredMipFormat();
     bool useNVTT = false;
@@ -590,7 +781,11 @@ nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture
 
     if (!useNVTT) {
         // Don't use NVTT (at least version 2.1) as it outputs wrong RGB9E5 and R11G11B10F values from floats
-        return new PackedFloatOutputHandler(outputTexture, face, outputFormat);
+        if (outputFormat == gpu::Element::COLOR_RGB9E5) {
+            return new PackedFloatOutputHandler<glm::packF3x9_E1x5>(outputTexture, face);
+        } else {
+            return new PackedFloatOutputHandler<packR11G11B10F>(outputTexture, face);
+        }
     } else {
         return new OutputHandler(outputTexture, face);
     }
@@ -807,7 +1002,8 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
+        const int DEFAULT_NUM_ENCODE_THREADS = 4;
+        const int numEncodeThreads = maxProcessingThreads > 0 ? std::min(DEFAULT_NUM_ENCODE_THREADS, maxProcessingThreads) : DEFAULT_NUM_ENCODE_THREADS;
         int encodingTime;
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
@@ -1381,29 +1577,22 @@ Image convertToLDRFormat(Image&& srcImage, Image::Format format) {
     Image localCopy = std::move(srcImage);
 
     Image ldrImage(localCopy.getWidth(), localCopy.getHeight(), format);
-    auto unpackFunc = getHDRUnpackingFunction();
-
-    for (glm::uint32 y = 0; y < localCopy.getHeight(); y++) {
-        const QRgb* srcLineIt = reinterpret_cast<const QRgb*>(localCopy.getScanLine(y));
-        const QRgb* srcLineEnd = srcLineIt + localCopy.getWidth();
-        uint32* ldrLineIt = reinterpret_cast<uint32*>(ldrImage.editScanLine(y));
-        glm::vec3 color;
-
-        while (srcLineIt < srcLineEnd) {
-            color = unpackFunc(*srcLineIt);
-            // Apply reverse gamma and clamp
-            color.r = std::pow(color.r, 1.0f / 2.2f);
-            color.g = std::pow(color.g, 1.0f / 2.2f);
-            color.b = std::pow(color.b, 1.0f / 2.2f);
-            color.r = std::min(1.0f, color.r) * 255.0f;
-            color.g = std::min(1.0f, color.g) * 255.0f;
-            color.b = std::min(1.0f, color.b) * 255.0f;
-            *ldrLineIt = qRgb((int)color.r, (int)color.g, (int)color.b);
-
-            ++srcLineIt;
-            ++ldrLineIt;
-        }
-    }
+    const unsigned char* source = localCopy.getBits();
+    const size_t srcLineByteStride = localCopy.getBytesPerLineCount();
+    unsigned char* output = ldrImage.editBits();
+    const size_t ldrLineByteStride = ldrImage.getBytesPerLineCount();
+
+    unpackRows(source, localCopy.getWidth(), localCopy.getHeight(), srcLineByteStride, GPU_CUBEMAP_HDR_FORMAT,
+               [&](int x, int y, glm::vec3 color) {
+        // Apply reverse gamma and clamp
+        color.r = std::pow(color.r, 1.0f / 2.2f);
+        color.g = std::pow(color.g, 1.0f / 2.2f);
+        color.b = std::pow(color.b, 1.0f / 2.2f);
+        color.r = std::min(1.0f, color.r) * 255.0f;
+        color.g = std::min(1.0f, color.g) * 255.0f;
+        color.b = std::min(1.0f, color.b) * 255.0f;
+        reinterpret_cast<QRgb*>(output + y * ldrLineByteStride)[x] = qRgb((int)color.r, (int)color.g, (int)color.b);
+    });
     return ldrImage;
 }
 
@@ -1412,24 +1601,9 @@ Image convertToHDRFormat(Image&& srcImage, gpu::Element format) {
     // https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#f18-for-consume-parameters-pass-by-x-and-stdmove-the-parameter
     Image localCopy = std::move(srcImage);
 
-    Image hdrImage(localCopy.getWidth(), localCopy.getHeight(), Image::Format_PACKED_FLOAT);
-    std::function<uint32(const glm::vec3&)> packFunc;
-#ifdef DEBUG_COLOR_PACKING
-    std::function<glm::vec3(uint32)> unpackFunc;
-#endif
-
     switch (format.getSemantic()) {
         case gpu::R11G11B10:
-            packFunc = packR11G11B10F;
-#ifdef DEBUG_COLOR_PACKING
-            unpackFunc = glm::unpackF2x11_1x10;
-#endif
-            break;
         case gpu::RGB9E5:
-            packFunc = glm::packF3x9_E1x5;
-#ifdef DEBUG_COLOR_PACKING
-            unpackFunc = glm::unpackF3x9_E1x5;
-#endif
             break;
         default:
             qCWarning(imagelogging) << "Unsupported HDR format";
@@ -1437,31 +1611,31 @@ Image convertToHDRFormat(Image&& srcImage, gpu::Element format) {
             return localCopy;
     }
 
+    Image hdrImage(localCopy.getWidth(), localCopy.getHeight(), Image::Format_PACKED_FLOAT);
     localCopy = localCopy.getConvertedToFormat(Image::Format_ARGB32);
-    for (glm::uint32 y = 0; y < localCopy.getHeight(); y++) {
-        const QRgb* srcLineIt = reinterpret_cast<const QRgb*>( localCopy.getScanLine(y) );
-        const QRgb* srcLineEnd = srcLineIt + localCopy.getWidth();
-        uint32* hdrLineIt = reinterpret_cast<uint32*>( hdrImage.editScanLine(y) );
-        glm::vec3 color;
-
-        while (srcLineIt < srcLineEnd) {
-            color.r = qRed(*srcLineIt);
-            color.g = qGreen(*srcLineIt);
-            color.b = qBlue(*srcLineIt);
-            // Normalize and apply gamma
-            color /= 255.0f;
-            color.r = std::pow(color.r, 2.2f);
-            color.g = std::pow(color.g, 2.2f);
-            color.b = std::pow(color.b, 2.2f);
-            *hdrLineIt = packFunc(color);
+    const unsigned char* source = localCopy.getBits();
+    const size_t srcLineByteStride = localCopy.getBytesPerLineCount();
+    unsigned char* output = hdrImage.editBits();
+    const size_t hdrLineByteStride = hdrImage.getBytesPerLineCount();
+
+    auto toLinearColor = [&](int x, int y) {
+        QRgb pixel = reinterpret_cast<const QRgb*>(source + y * srcLineByteStride)[x];
+        glm::vec3 color(qRed(pixel), qGreen(pixel), qBlue(pixel));
+        // Normalize and apply gamma
+        color /= 255.0f;
+        color.r = std::pow(color.r, 2.2f);
+        color.g = std::pow(color.g, 2.2f);
+        color.b = std::pow(color.b, 2.2f);
+        return color;
+    };
+    packRows(output, localCopy.getWidth(), localCopy.getHeight(), hdrLineByteStride, format, toLinearColor);
+
 #ifdef DEBUG_COLOR_PACKING
-            glm::vec3 ucolor = unpackFunc(*hdrLineIt);
-            assert(glm::distance(color, ucolor) <= 5e-2);
+    unpackRows(output, localCopy.getWidth(), localCopy.getHeight(), hdrLineByteStride, format,
+               [&](int x, int y, const glm::vec3& ucolor) {
+        assert(glm::distance(toLinearColor(x, y), ucolor) <= 5e-2);
+    });
 #endif
-            ++srcLineIt;
-            ++hdrLineIt;
-        }
-    }
     return hdrImage;
 }
 
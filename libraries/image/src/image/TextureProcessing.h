@@ -27,6 +27,29 @@ namespace image {
                         glm::vec4* output, size_t outputLinePixelStride);
     void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
                           const glm::vec4* source, size_t srcLinePixelStride);
+    // from red, green and blue planes of floats, as nvtt::Surface has them
+    void convertToPackedFromFloatChannels(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
+                                          const float* red, const float* green, const float* blue);
+    // between packed HDR lines and 8 bit per channel (QRgb) ones, which are opaque
+    void convertToColorFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
+                                  unsigned char* output, size_t outputLineByteStride);
+    void convertToPackedFromColor(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
+                                  const unsigned char* source, size_t srcLineByteStride);
+    // from RGBA lines of half floats, as OpenEXR reads them, to the packed format of getHDRPackingFunction
+    void convertToHDRFromHalfFloat(unsigned char* output, int width, int height, size_t outputLineByteStride,
+                                   const uint16_t* source, size_t srcLinePixelStride);
+    // between gamma corrected 8 bit per channel images and linear packed HDR ones
+    Image convertToHDRFormat(Image&& srcImage, gpu::Element format);
+    Image convertToLDRFormat(Image&& srcImage, Image::Format format);
+    // Caps the threads texture processing runs on, 0 (the default) for every core. It's meant for processes that
+    // share the machine, like the ovens of an asset server, and is set before any texture is processed.
+    void setMaxProcessingThreads(int maxThreads);
+    int getMaxProcessingThreads();
+    // Runs a task whose parallel loops stay within that cap
+    void runWithinProcessingThreads(const std::function<void()>& task);
+
+    void mapToRedChannel(Image& image, ColorChannel sourceChannel);
+    Image processSourceImage(Image&& srcImage, bool cubemap, gpu::BackendTarget target);
 
 namespace TextureUsage {
 
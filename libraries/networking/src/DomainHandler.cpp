@@ -78,7 +78,7 @@ void DomainHandler::disconnect(QString reason) {
 
     if (requiresICE()) {
         // if we connected to this domain with ICE, re-set the socket so we reconnect through the ice-server
-        _sockAddr.clear();
+        _sockAddrLock.withWriteLock([&] { _sockAddr.clear(); });
     }
 
     qCDebug(networking_ice) << "Disconnecting from domain server.";
@@ -130,7 +130,7 @@ void DomainHandler::hardReset(QString reason) {
     qCDebug(networking) << "Hard reset in NodeList DomainHandler.";
     _pendingDomainID = QUuid();
     _iceServerSockAddr = HifiSockAddr();
-    _sockAddr.clear();
+    _sockAddrLock.withWriteLock([&] { _sockAddr.clear(); });
     _domainURL = QUrl();
 
     _domainConnectionRefusals.clear();
@@ -170,7 +170,7 @@ void DomainHandler::setSockAddr(const HifiSockAddr& sockAddr, const QString& hos
         // we should reset on a sockAddr change
         hardReset("Changing domain sockAddr");
         // change the sockAddr
-        _sockAddr = sockAddr;
+        _sockAddrLock.withWriteLock([&] { _sockAddr = sockAddr; });
     }
 
     if (!_sockAddr.isNull()) {
@@ -195,7 +195,7 @@ void DomainHandler::setURLAndID(QUrl domainURL, QUuid domainID) {
     _pendingDomainID = domainID;
 
     if (domainURL.scheme() != URL_SCHEME_HIFI) {
-        _sockAddr.clear();
+        _sockAddrLock.withWriteLock([&] { _sockAddr.clear(); });
 
         // if this is a file URL we need to see if it has a ~ for us to expand
         if (domainURL.scheme() == HIFI_URL_SCHEME_FILE) {
@@ -237,7 +237,7 @@ void DomainHandler::setURLAndID(QUrl domainURL, QUuid domainID) {
 
         if (_sockAddr.getPort() != domainPort) {
             qCDebug(networking) << "Updated domain port to" << domainPort;
-            _sockAddr.setPort(domainPort);
+            _sockAddrLock.withWriteLock([&] { _sockAddr.setPort(domainPort); });
         }
     }
 }
@@ -290,7 +290,7 @@ void DomainHandler::setIceServerHostnameAndID(const QString& iceServerHostname,
 
 void DomainHandler::activateICELocalSocket() {
     DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
-    _sockAddr = _icePeer.getLocalSocket();
+    _sockAddrLock.withWriteLock([&] { _sockAddr = _icePeer.getLocalSocket(); });
     _domainURL.setScheme(URL_SCHEME_HIFI);
     _domainURL.setHost(_sockAddr.getAddress().toString());
     emit domainURLChanged(_domainURL);
@@ -299,7 +299,7 @@ void DomainHandler::activateICELocalSocket() {
 
 void DomainHandler::activateICEPublicSocket() {
     DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
-    _sockAddr = _icePeer.getPublicSocket();
+    _sockAddrLock.withWriteLock([&] { _sockAddr = _icePeer.getPublicSocket(); });
     _domainURL.setScheme(URL_SCHEME_HIFI);
     _domainURL.setHost(_sockAddr.getAddress().toString());
     emit domainURLChanged(_domainURL);
@@ -320,7 +320,7 @@ QString DomainHandler::getViewPointFromNamedPath(QString namedPath) {
 void DomainHandler::completedHostnameLookup(const QHostInfo& hostInfo) {
     for (int i = 0; i < hostInfo.addresses().size(); i++) {
         if (hostInfo.addresses()[i].protocol() == QAbstractSocket::IPv4Protocol) {
-            _sockAddr.setAddress(hostInfo.addresses()[i]);
+            _sockAddrLock.withWriteLock([&] { _sockAddr.setAddress(hostInfo.addresses()[i]); });
 
             DependencyManager::get<NodeList>()->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SetDomainSocket);
 
@@ -451,7 +451,7 @@ void DomainHandler::processDTLSRequirementPacket(QSharedPointer<ReceivedMessage>
 
     qCDebug(networking) << "domain-server DTLS port changed to" << dtlsPort << "- Enabling DTLS.";
 
-    _sockAddr.setPort(dtlsPort);
+    _sockAddrLock.withWriteLock([&] { _sockAddr.setPort(dtlsPort); });
 
 //    initializeDTLSSession();
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_DomainHandler_h
 #define hifi_DomainHandler_h
 
+#include <atomic>
+
 #include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
@@ -48,6 +50,7 @@ public:
     const QUuid& getUUID() const { return _uuid; }
     void setUUID(const QUuid& uuid);
 
+    // the local ID and socket of the domain-server are also read when packets are verified on the ingress shard threads
     Node::LocalID getLocalID() const { return _localID; }
     void setLocalID(Node::LocalID localID) { _localID = localID; }
 
@@ -59,13 +62,13 @@ public:
     int getLastDomainConnectionError() { return _lastDomainConnectionError; }
 
     const QHostAddress& getIP() const { return _sockAddr.getAddress(); }
-    void setIPToLocalhost() { _sockAddr.setAddress(QHostAddress(QHostAddress::LocalHost)); }
+    void setIPToLocalhost() { _sockAddrLock.withWriteLock([&] { _sockAddr.setAddress(QHostAddress(QHostAddress::LocalHost)); }); }
 
-    const HifiSockAddr& getSockAddr() const { return _sockAddr; }
+    HifiSockAddr getSockAddr() const { return _sockAddrLock.resultWithReadLock<HifiSockAddr>([&] { return _sockAddr; }); }
     void setSockAddr(const HifiSockAddr& sockAddr, const QString& hostname);
 
     unsigned short getPort() const { return _sockAddr.getPort(); }
-    void setPort(quint16 port) { _sockAddr.setPort(port); }
+    void setPort(quint16 port) { _sockAddrLock.withWriteLock([&] { _sockAddr.setPort(port); }); }
 
     const QUuid& getConnectionToken() const { return _connectionToken; }
     void setConnectionToken(const QUuid& connectionToken) { _connectionToken = connectionToken; }
@@ -215,10 +218,12 @@ private:
     bool isHardRefusal(int reasonCode);
 
     QUuid _uuid;
-    Node::LocalID _localID;
+    std::atomic<Node::LocalID> _localID { Node::NULL_LOCAL_ID };
     QUrl _domainURL;
     QUrl _errorDomainURL;
     HifiSockAddr _sockAddr;
+    // written only on the thread of the DomainHandler, which can read _sockAddr without it
+    mutable ReadWriteLockable _sockAddrLock;
     QUuid _assignmentUUID;
     QUuid _connectionToken;
     QUuid _pendingDomainID; // ID of domain being connected to, via ICE or direct connection
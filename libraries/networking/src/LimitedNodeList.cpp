@@ -246,6 +246,10 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
         static QMultiHash<QUuid, PacketType> sourcedVersionDebugSuppressMap;
         static QMultiHash<HifiSockAddr, PacketType> versionDebugSuppressMap;
 
+        // packets can be verified on several ingress shard threads at once
+        static QMutex versionDebugSuppressMutex;
+        QMutexLocker versionDebugSuppressLocker(&versionDebugSuppressMutex);
+
         bool hasBeenOutput = false;
         QString senderString;
         const HifiSockAddr& senderSockAddr = packet.getSenderSockAddr();
@@ -358,6 +362,10 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
                 if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
 
+                    // packets can be verified on several ingress shard threads at once
+                    static QMutex hashDebugSuppressMutex;
+                    QMutexLocker hashDebugSuppressLocker(&hashDebugSuppressMutex);
+
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
                         qCDebug(networking) << "Packet hash mismatch on" << headerType << "- Sender" << sourceID;
                         qCDebug(networking) << "Packet len:" << packet.getDataSize() << "Expected hash:" <<
@@ -614,6 +622,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         handleNodeKill(killedNode);
     }
 
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsLock);
     _delayedNodeAdds.clear();
 }
 
@@ -780,10 +789,12 @@ void LimitedNodeList::addNewNode(NewNodeInfo info) {
 }
 
 void LimitedNodeList::delayNodeAdd(NewNodeInfo info) {
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsLock);
     _delayedNodeAdds.push_back(info);
 }
 
 void LimitedNodeList::removeDelayedAdd(QUuid nodeUUID) {
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsLock);
     auto it = std::find_if(_delayedNodeAdds.begin(), _delayedNodeAdds.end(), [&](const auto& info) {
         return info.uuid == nodeUUID;
     });
@@ -793,6 +804,7 @@ void LimitedNodeList::removeDelayedAdd(QUuid nodeUUID) {
 }
 
 bool LimitedNodeList::isDelayedNode(QUuid nodeUUID) {
+    QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsLock);
     auto it = std::find_if(_delayedNodeAdds.begin(), _delayedNodeAdds.end(), [&](const auto& info) {
         return info.uuid == nodeUUID;
     });
@@ -802,14 +814,19 @@ bool LimitedNodeList::isDelayedNode(QUuid nodeUUID) {
 void LimitedNodeList::processDelayedAdds() {
     _nodesAddedInCurrentTimeSlice = 0;
 
-    auto nodesToAdd = glm::min(_delayedNodeAdds.size(), _maxConnectionRate);
-    auto firstNodeToAdd = _delayedNodeAdds.begin();
-    auto lastNodeToAdd = firstNodeToAdd + nodesToAdd;
+    std::vector<NewNodeInfo> nodesToAdd;
+    {
+        QMutexLocker delayedNodeAddsLocker(&_delayedNodeAddsLock);
+        auto firstNodeToAdd = _delayedNodeAdds.begin();
+        auto lastNodeToAdd = firstNodeToAdd + glm::min(_delayedNodeAdds.size(), _maxConnectionRate);
+        nodesToAdd.assign(firstNodeToAdd, lastNodeToAdd);
+        _delayedNodeAdds.erase(firstNodeToAdd, lastNodeToAdd);
+    }
 
-    for (auto it = firstNodeToAdd; it != lastNodeToAdd; ++it) {
-        addNewNode(*it);
+    // added without the lock, a node add can call back into delayNodeAdd
+    for (const auto& info : nodesToAdd) {
+        addNewNode(info);
     }
-    _delayedNodeAdds.erase(firstNodeToAdd, lastNodeToAdd);
 }
 
 std::unique_ptr<NLPacket> LimitedNodeList::constructPingPacket(const QUuid& nodeId, PingType_t pingType) {
@@ -1296,10 +1313,9 @@ SharedNodePointer LimitedNodeList::findNodeWithAddr(const HifiSockAddr& addr) {
 
 bool LimitedNodeList::sockAddrBelongsToNode(const HifiSockAddr& sockAddr) {
     QReadLocker locker(&_nodeMutex);
+    // this is the connection creation filter, called on the ingress shard threads
     auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&sockAddr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == sockAddr
-            || pair.second->getLocalSocket() == sockAddr
-            || pair.second->getSymmetricSocket() == sockAddr;
+        return pair.second->hasSockAddr(sockAddr);
     });
     return it != std::end(_nodeHash);
 }
@@ -25,6 +25,7 @@
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QPointer>
+#include <QtCore/QMutex>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QSet>
 #include <QtCore/QSharedMemory>
@@ -310,6 +311,18 @@ public:
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    void setBatchedReceiveEnabled(bool enabled) { _nodeSocket.setBatchedReceiveEnabled(enabled); }
+    void setBatchedSendEnabled(bool enabled) { _nodeSocket.setBatchedSendEnabled(enabled); }
+
+    // unreliable sends from the calling thread are coalesced until flushSendBatch (if batched send is enabled)
+    void beginSendBatch() { _nodeSocket.beginSendBatch(); }
+    void flushSendBatch() { _nodeSocket.flushSendBatch(); }
+    udt::Socket::SendStats sampleSendStats() { return _nodeSocket.sampleSendStats(); }
+
+    // process received packets on this many threads, sharded by sender (0 keeps everything on the NodeList thread)
+    void setNumIngressShards(int numShards) { _nodeSocket.setNumIngressShards(numShards); }
+    int getNumIngressShards() const { return _nodeSocket.getNumIngressShards(); }
+    quint64 sampleNumIngressDropped() { return _nodeSocket.sampleNumIngressDropped(); }
 
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
@@ -491,6 +504,8 @@ private:
 
     size_t _maxConnectionRate { DEFAULT_MAX_CONNECTION_RATE };
     size_t _nodesAddedInCurrentTimeSlice { 0 };
+    // looked up by isDelayedNode when packets are verified on the ingress shard threads
+    QMutex _delayedNodeAddsLock;
     std::vector<NewNodeInfo> _delayedNodeAdds;
 
     int _inboundPPS { 0 };
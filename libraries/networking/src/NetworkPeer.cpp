@@ -60,8 +60,11 @@ void NetworkPeer::setPublicSocket(const HifiSockAddr& publicSocket) {
         bool wasOldSocketNull = _publicSocket.isNull();
 
         auto previousSocket = _publicSocket;
-        _publicSocket = publicSocket;
-        _publicSocket.setObjectName(previousSocket.objectName());
+        {
+            QWriteLocker socketsLocker(&_socketsLock);
+            _publicSocket = publicSocket;
+            _publicSocket.setObjectName(previousSocket.objectName());
+        }
         
         if (!wasOldSocketNull) {
             qCDebug(networking) << "Public socket change for node" << *this << "; previously" << previousSocket;
@@ -80,8 +83,11 @@ void NetworkPeer::setLocalSocket(const HifiSockAddr& localSocket) {
         bool wasOldSocketNull = _localSocket.isNull();
         
         auto previousSocket = _localSocket;
-        _localSocket = localSocket;
-        _localSocket.setObjectName(previousSocket.objectName());
+        {
+            QWriteLocker socketsLocker(&_socketsLock);
+            _localSocket = localSocket;
+            _localSocket.setObjectName(previousSocket.objectName());
+        }
 
         if (!wasOldSocketNull) {
             qCDebug(networking) << "Local socket change for node" << *this << "; previously" << previousSocket;
@@ -100,8 +106,11 @@ void NetworkPeer::setSymmetricSocket(const HifiSockAddr& symmetricSocket) {
         bool wasOldSocketNull = _symmetricSocket.isNull();
         
         auto previousSocket = _symmetricSocket;
-        _symmetricSocket = symmetricSocket;
-        _symmetricSocket.setObjectName(previousSocket.objectName());
+        {
+            QWriteLocker socketsLocker(&_socketsLock);
+            _symmetricSocket = symmetricSocket;
+            _symmetricSocket.setObjectName(previousSocket.objectName());
+        }
         
         if (!wasOldSocketNull) {
             qCDebug(networking) << "Symmetric socket change for node" << *this << "; previously" << previousSocket;
@@ -110,6 +119,11 @@ void NetworkPeer::setSymmetricSocket(const HifiSockAddr& symmetricSocket) {
     }
 }
 
+bool NetworkPeer::hasSockAddr(const HifiSockAddr& sockAddr) const {
+    QReadLocker socketsLocker(&_socketsLock);
+    return _publicSocket == sockAddr || _localSocket == sockAddr || _symmetricSocket == sockAddr;
+}
+
 void NetworkPeer::setActiveSocket(HifiSockAddr* discoveredSocket) {
     _activeSocket = discoveredSocket;
 
@@ -160,9 +174,12 @@ void NetworkPeer::activateMatchingOrNewSymmetricSocket(const HifiSockAddr& match
 void NetworkPeer::softReset() {
     qCDebug(networking) << "Soft reset ";
     // a soft reset should clear the sockets and reset the number of connection attempts
-    _localSocket.clear();
-    _publicSocket.clear();
-    _symmetricSocket.clear();
+    {
+        QWriteLocker socketsLocker(&_socketsLock);
+        _localSocket.clear();
+        _publicSocket.clear();
+        _symmetricSocket.clear();
+    }
     _activeSocket = NULL;
 
     // stop our ping timer since we don't have sockets to ping anymore anyways
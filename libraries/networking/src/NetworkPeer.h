@@ -15,6 +15,7 @@
 #include <atomic>
 
 #include <QtCore/QObject>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QTimer>
 #include <QtCore/QUuid>
 
@@ -57,6 +58,9 @@ public:
     void setLocalSocket(const HifiSockAddr& localSocket);
     void setSymmetricSocket(const HifiSockAddr& symmetricSocket);
 
+    // the sockets are only changed on the thread of the node list, this can be called from any thread
+    bool hasSockAddr(const HifiSockAddr& sockAddr) const;
+
     const HifiSockAddr* getActiveSocket() const { return _activeSocket; }
 
     void activatePublicSocket();
@@ -106,6 +110,8 @@ protected:
     HifiSockAddr _localSocket;
     HifiSockAddr _symmetricSocket;
     HifiSockAddr* _activeSocket;
+    // taken to change the sockets, and by hasSockAddr
+    mutable QReadWriteLock _socketsLock;
 
     quint64 _wakeTimestamp;
     std::atomic_ullong _lastHeardMicrostamp;
@@ -212,12 +212,9 @@ void Node::setConnectionSecret(const QUuid& connectionSecret) {
         return;
     }
 
-    if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
-    }
-
     _connectionSecret = connectionSecret;
     _authenticateHash->setKey(_connectionSecret);
+    _hasAuthenticateHash = true;
 }
 
 void Node::updateStats(Stats stats) {
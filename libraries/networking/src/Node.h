@@ -61,7 +61,8 @@ public:
 
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
     void setConnectionSecret(const QUuid& connectionSecret);
-    HMACAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
+    // null until there is a connection secret, read when packets are verified on the ingress shard threads
+    HMACAuth* getAuthenticateHash() const { return _hasAuthenticateHash ? _authenticateHash.get() : nullptr; }
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
     void setLinkedData(std::unique_ptr<NodeData> linkedData) { _linkedData = std::move(linkedData); }
@@ -114,7 +115,9 @@ private:
     NodeType_t _type;
 
     QUuid _connectionSecret;
-    std::unique_ptr<HMACAuth> _authenticateHash { nullptr };
+    // made up front so that it is never replaced while another thread uses it
+    std::unique_ptr<HMACAuth> _authenticateHash { new HMACAuth() };
+    std::atomic<bool> _hasAuthenticateHash { false };
     std::unique_ptr<NodeData> _linkedData;
     bool _isReplicated { false };
     int _pingMs;
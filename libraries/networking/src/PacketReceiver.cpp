@@ -219,29 +219,39 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
     auto nlPacket = NLPacket::fromBase(std::move(packet));
 
     auto key = std::pair<HifiSockAddr, udt::Packet::MessageNumber>(nlPacket->getSenderSockAddr(), nlPacket->getMessageNumber());
-    auto it = _pendingMessages.find(key);
     QSharedPointer<ReceivedMessage> message;
+    bool justReceived = false;
 
-    if (it == _pendingMessages.end()) {
-        // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
-        if (!message->isComplete()) {
-            _pendingMessages[key] = message;
-        }
-        handleVerifiedMessage(message, true);
-    } else {
-        message = it->second;
-        message->appendPacket(*nlPacket);
+    {
+        QMutexLocker pendingMessagesLocker(&_pendingMessagesLock);
+        auto it = _pendingMessages.find(key);
+
+        if (it == _pendingMessages.end()) {
+            // Create message
+            message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+            if (!message->isComplete()) {
+                _pendingMessages[key] = message;
+            }
+            justReceived = true;
+        } else {
+            message = it->second;
+            message->appendPacket(*nlPacket);
 
-        if (message->isComplete()) {
+            if (!message->isComplete()) {
+                return;
+            }
             _pendingMessages.erase(it);
-            handleVerifiedMessage(message, false);
         }
     }
+
+    // listeners are called outside of the lock, they may well send (or receive) messages of their own
+    handleVerifiedMessage(message, justReceived);
 }
 
 void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::MessageNumber messageNumber) {
     auto key = std::pair<HifiSockAddr, udt::Packet::MessageNumber>(from, messageNumber);
+
+    QMutexLocker pendingMessagesLocker(&_pendingMessagesLock);
     auto it = _pendingMessages.find(key);
     if (it != _pendingMessages.end()) {
         auto message = it->second;
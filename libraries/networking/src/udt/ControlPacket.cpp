@@ -27,6 +27,11 @@ int ControlPacket::maxPayloadSize() {
 
 std::unique_ptr<ControlPacket> ControlPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
                                                                  const HifiSockAddr &senderSockAddr) {
+    return fromReceivedPacket(PacketBuffer(data.release()), size, senderSockAddr);
+}
+
+std::unique_ptr<ControlPacket> ControlPacket::fromReceivedPacket(PacketBuffer data, qint64 size,
+                                                                 const HifiSockAddr &senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
     
@@ -56,7 +61,7 @@ ControlPacket::ControlPacket(Type type, qint64 size) :
     writeType();
 }
 
-ControlPacket::ControlPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
+ControlPacket::ControlPacket(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) :
     BasePacket(std::move(data), size, senderSockAddr)
 {
     // sanity check before we decrease the payloadSize with the payloadCapacity
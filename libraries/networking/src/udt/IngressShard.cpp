@@ -0,0 +1,72 @@
+//
+//  IngressShard.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-06-10.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IngressShard.h"
+
+#include <QtCore/QThread>
+
+#include "Socket.h"
+
+using namespace udt;
+
+IngressShard::IngressShard(Socket& socket, int index) :
+    _socket(socket)
+{
+    _thread = new QThread;
+    _thread->setObjectName("Networking: Ingress Shard " + QString::number(index)); // Name thread for easier debug
+
+    moveToThread(_thread);
+    _thread->start();
+}
+
+IngressShard::~IngressShard() {
+    // anything still queued is dropped with the shard
+    _thread->quit();
+    _thread->wait();
+    delete _thread;
+}
+
+bool IngressShard::queueDatagram(PacketBuffer buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                                 p_high_resolution_clock::time_point receiveTime) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+
+        if (_queue.size() >= MAX_QUEUED_DATAGRAMS) {
+            ++_numDropped;
+            return false;
+        }
+
+        wasEmpty = _queue.empty();
+        _queue.push_back({ std::move(buffer), size, senderSockAddr, receiveTime });
+    }
+
+    if (wasEmpty) {
+        // only the first datagram of a run needs to wake the shard, it drains the whole queue
+        QMetaObject::invokeMethod(this, "processQueuedDatagrams", Qt::QueuedConnection);
+    }
+
+    return true;
+}
+
+void IngressShard::processQueuedDatagrams() {
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _processing.swap(_queue);
+    }
+
+    for (auto& datagram : _processing) {
+        _socket.processConnectionDatagram(std::move(datagram.buffer), datagram.size,
+                                          datagram.senderSockAddr, datagram.receiveTime);
+    }
+
+    _processing.clear();
+}
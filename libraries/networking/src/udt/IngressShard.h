@@ -0,0 +1,76 @@
+//
+//  IngressShard.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-06-10.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_IngressShard_h
+#define hifi_IngressShard_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QObject>
+
+#include <PortableHighResolutionClock.h>
+
+#include "../HifiSockAddr.h"
+#include "PacketBufferPool.h"
+
+class QThread;
+
+namespace udt {
+
+class Socket;
+
+// One receive processing thread of a sharded udt::Socket.
+// The socket thread still reads from the OS socket; datagrams are then handed to the shard that owns
+// the sender's address, so a Connection (and its receive state) is only ever touched by one shard thread.
+class IngressShard : public QObject {
+    Q_OBJECT
+public:
+    static const size_t MAX_QUEUED_DATAGRAMS = 8192;
+
+    IngressShard(Socket& socket, int index);
+    ~IngressShard();
+
+    // returns false (and drops the datagram) if the shard is too far behind
+    bool queueDatagram(PacketBuffer buffer, qint64 size, const HifiSockAddr& senderSockAddr,
+                       p_high_resolution_clock::time_point receiveTime);
+
+    QThread* getThread() const { return _thread; }
+
+    quint64 sampleNumDropped() { return _numDropped.exchange(0); }
+
+private slots:
+    void processQueuedDatagrams();
+
+private:
+    struct QueuedDatagram {
+        PacketBuffer buffer;
+        qint64 size;
+        HifiSockAddr senderSockAddr;
+        p_high_resolution_clock::time_point receiveTime;
+    };
+
+    Socket& _socket;
+    QThread* _thread { nullptr };
+
+    std::mutex _queueMutex;
+    std::vector<QueuedDatagram> _queue; // guarded by _queueMutex
+    std::vector<QueuedDatagram> _processing; // only touched on the shard thread
+
+    std::atomic<quint64> _numDropped { 0 };
+};
+
+} // namespace udt
+
+#endif // hifi_IngressShard_h
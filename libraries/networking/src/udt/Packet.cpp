@@ -62,6 +62,10 @@ std::unique_ptr<Packet> Packet::create(qint64 size, bool isReliable, bool isPart
 }
 
 std::unique_ptr<Packet> Packet::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) {
+    return fromReceivedPacket(PacketBuffer(data.release()), size, senderSockAddr);
+}
+
+std::unique_ptr<Packet> Packet::fromReceivedPacket(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) {
     // Fail with invalid size
     Q_ASSERT(size >= 0);
 
@@ -88,6 +92,12 @@ Packet::Packet(qint64 size, bool isReliable, bool isPartOfMessage) :
 }
 
 Packet::Packet(std::unique_ptr<char[]> data, qint64 size, const HifiSockAddr& senderSockAddr) :
+    Packet(PacketBuffer(data.release()), size, senderSockAddr)
+{
+
+}
+
+Packet::Packet(PacketBuffer data, qint64 size, const HifiSockAddr& senderSockAddr) :
     BasePacket(std::move(data), size, senderSockAddr)
 {
     readHeader();
@@ -0,0 +1,72 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-06-03.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+using namespace udt;
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (isPooled) {
+        PacketBufferPool::getInstance().release(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+PacketBufferPool& PacketBufferPool::getInstance() {
+    // packets can be destroyed during static destruction (queued messages, etc.)
+    // so the pool is intentionally never torn down
+    static PacketBufferPool* instance = new PacketBufferPool();
+    return *instance;
+}
+
+PacketBuffer PacketBufferPool::acquire() {
+    char* buffer = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(_freeBuffersMutex);
+        if (!_freeBuffers.empty()) {
+            buffer = _freeBuffers.back();
+            _freeBuffers.pop_back();
+        }
+    }
+
+    if (buffer) {
+        _numRecycles.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        buffer = new char[BUFFER_SIZE];
+        _numAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return PacketBuffer(buffer, PacketBufferDeleter { true });
+}
+
+void PacketBufferPool::release(char* buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_freeBuffersMutex);
+        if (_freeBuffers.size() < MAX_FREE_BUFFERS) {
+            _freeBuffers.push_back(buffer);
+            return;
+        }
+    }
+
+    // the pool is full, let this one go
+    delete[] buffer;
+}
+
+size_t PacketBufferPool::getNumFreeBuffers() const {
+    std::lock_guard<std::mutex> lock(_freeBuffersMutex);
+    return _freeBuffers.size();
+}
@@ -0,0 +1,67 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by High Fidelity on 2019-06-03.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Constants.h"
+
+namespace udt {
+
+// Deleter for packet memory - buffers that came from the PacketBufferPool go back to it,
+// anything else was allocated with new[] and is simply deleted
+struct PacketBufferDeleter {
+    bool isPooled { false };
+
+    void operator()(char* buffer) const;
+};
+
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+// Process-wide free list of MTU sized receive buffers.
+// The socket read path acquires from here instead of allocating for every datagram, and the buffer
+// is handed back by whichever thread ends up destroying the packet that owns it.
+class PacketBufferPool {
+public:
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE;
+    static const size_t MAX_FREE_BUFFERS = 4096;
+
+    static PacketBufferPool& getInstance();
+
+    PacketBuffer acquire();
+    void release(char* buffer);
+
+    size_t getNumFreeBuffers() const;
+    uint64_t getNumAllocations() const { return _numAllocations.load(std::memory_order_relaxed); }
+    uint64_t getNumRecycles() const { return _numRecycles.load(std::memory_order_relaxed); }
+
+private:
+    PacketBufferPool() = default;
+    PacketBufferPool(const PacketBufferPool&) = delete;
+    PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+
+    mutable std::mutex _freeBuffersMutex;
+    std::vector<char*> _freeBuffers;
+
+    std::atomic<uint64_t> _numAllocations { 0 };
+    std::atomic<uint64_t> _numRecycles { 0 };
+};
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
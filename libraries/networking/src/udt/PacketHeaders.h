@@ -135,6 +135,8 @@ public:
         AudioSoloRequest,
         BulkAvatarTraitsAck,
         StopInjector,
+        BulkAvatarDataAck,
+        OctreeDataCompressionDictionary,
         NUM_PACKET_TYPE
     };
 
@@ -292,7 +294,8 @@ enum class EntityQueryPacketVersion: PacketVersion {
     ConnectionIdentifier = 20,
     RemovedJurisdictions = 21,
     MultiFrustumQuery = 22,
-    ConicalFrustums = 23
+    ConicalFrustums = 23,
+    ZstdCompression = 24
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
@@ -340,7 +343,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    JointDeltas
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -11,7 +11,7 @@
 
 #include "Socket.h"
 
-#ifdef Q_OS_ANDROID
+#if defined(Q_OS_ANDROID) || defined(Q_OS_LINUX)
 #include <sys/socket.h>
 #endif
 
@@ -23,6 +23,7 @@
 #include "../NetworkLogging.h"
 #include "Connection.h"
 #include "ControlPacket.h"
+#include "IngressShard.h"
 #include "Packet.h"
 #include "../NLPacket.h"
 #include "../NLPacketList.h"
@@ -38,6 +39,23 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+namespace udt {
+
+struct SendBatch {
+    static const int MAX_DATAGRAMS = 64;
+
+    Socket* socket { nullptr };
+    int numDatagrams { 0 };
+    char data[MAX_DATAGRAMS][MAX_PACKET_SIZE];
+    int sizes[MAX_DATAGRAMS];
+    sockaddr_in destinations[MAX_DATAGRAMS];
+};
+
+} // namespace udt
+
+// each sending thread (mixer slaves, mainly) has its own batch so that queueing never needs a lock
+static thread_local std::unique_ptr<SendBatch> currentSendBatch;
+
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
@@ -207,7 +225,14 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Hif
 
 void Socket::writeReliablePacket(Packet* packet, const HifiSockAddr& sockAddr) {
     auto connection = findOrCreateConnection(sockAddr);
-    if (connection) {
+    if (connection && connection->thread() != QThread::currentThread()) {
+        // the connection is owned by an ingress shard, its send state is only touched from there.
+        // Qt drops the call if the connection is deleted first, the holder then frees the packet
+        auto packetHolder = std::make_shared<std::unique_ptr<Packet>>(packet);
+        QMetaObject::invokeMethod(connection, [connection, packetHolder] {
+            connection->sendReliablePacket(std::move(*packetHolder));
+        }, Qt::QueuedConnection);
+    } else if (connection) {
         connection->sendReliablePacket(std::unique_ptr<Packet>(packet));
     }
 #ifdef UDT_CONNECTION_DEBUG
@@ -220,7 +245,14 @@ void Socket::writeReliablePacket(Packet* packet, const HifiSockAddr& sockAddr) {
 
 void Socket::writeReliablePacketList(PacketList* packetList, const HifiSockAddr& sockAddr) {
     auto connection = findOrCreateConnection(sockAddr);
-    if (connection) {
+    if (connection && connection->thread() != QThread::currentThread()) {
+        // the connection is owned by an ingress shard, its send state is only touched from there.
+        // Qt drops the call if the connection is deleted first, the holder then frees the packet list
+        auto packetListHolder = std::make_shared<std::unique_ptr<PacketList>>(packetList);
+        QMetaObject::invokeMethod(connection, [connection, packetListHolder] {
+            connection->sendReliablePacketList(std::move(*packetListHolder));
+        }, Qt::QueuedConnection);
+    } else if (connection) {
         connection->sendReliablePacketList(std::unique_ptr<PacketList>(packetList));
     }
 #ifdef UDT_CONNECTION_DEBUG
@@ -243,6 +275,35 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
         qCDebug(networking) << "Attempt to writeDatagram when in unbound state to" << sockAddr;
         return -1;
     }
+
+    auto batch = currentSendBatch.get();
+    if (batch && batch->socket == this && datagram.size() <= MAX_PACKET_SIZE
+        && sockAddr.getAddress().protocol() == QAbstractSocket::IPv4Protocol) {
+        // queue a copy, the caller is free to re-use or destroy its packet once we return
+        auto index = batch->numDatagrams++;
+        memcpy(batch->data[index], datagram.constData(), datagram.size());
+        batch->sizes[index] = datagram.size();
+
+        auto& destination = batch->destinations[index];
+        memset(&destination, 0, sizeof(sockaddr_in));
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(sockAddr.getPort());
+        destination.sin_addr.s_addr = htonl(sockAddr.getAddress().toIPv4Address());
+
+        if (batch->numDatagrams == SendBatch::MAX_DATAGRAMS) {
+            sendBatchedDatagrams(*batch);
+        }
+
+        return datagram.size();
+    }
+
+    return sendDatagram(datagram, sockAddr);
+}
+
+qint64 Socket::sendDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr) {
+    ++_numDatagramsSent;
+    ++_numSendSyscalls;
+
     qint64 bytesWritten = _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
     int pending = _udpSocket.bytesToWrite();
     if (bytesWritten < 0 || pending) {
@@ -270,6 +331,81 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+void Socket::beginSendBatch() {
+    if (!_isBatchedSendEnabled) {
+        return;
+    }
+
+    if (!currentSendBatch) {
+        currentSendBatch.reset(new SendBatch());
+    } else if (currentSendBatch->socket && currentSendBatch->socket != this) {
+        // this thread was batching for another socket, send that out before we take over
+        currentSendBatch->socket->flushSendBatch();
+    }
+
+    currentSendBatch->socket = this;
+}
+
+void Socket::flushSendBatch() {
+    auto batch = currentSendBatch.get();
+    if (batch && batch->socket == this) {
+        sendBatchedDatagrams(*batch);
+        batch->socket = nullptr;
+    }
+}
+
+void Socket::sendBatchedDatagrams(SendBatch& batch) {
+    int numDatagrams = batch.numDatagrams;
+    batch.numDatagrams = 0;
+
+    int numSent = 0;
+
+#if defined(Q_OS_LINUX)
+    mmsghdr messages[SendBatch::MAX_DATAGRAMS];
+    iovec ioVectors[SendBatch::MAX_DATAGRAMS];
+
+    for (int i = 0; i < numDatagrams; ++i) {
+        ioVectors[i].iov_base = batch.data[i];
+        ioVectors[i].iov_len = batch.sizes[i];
+
+        memset(&messages[i], 0, sizeof(mmsghdr));
+        messages[i].msg_hdr.msg_name = &batch.destinations[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        messages[i].msg_hdr.msg_iov = &ioVectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // UDP GSO would need equally sized segments to a single destination, which is not what a
+    // mixer's fan-out looks like (one datagram per listener) - so this sticks with sendmmsg
+    auto socketDescriptor = _udpSocket.socketDescriptor();
+    while (numSent < numDatagrams) {
+        int result = sendmmsg(socketDescriptor, messages + numSent, numDatagrams - numSent, 0);
+        ++_numSendSyscalls;
+
+        if (result <= 0) {
+            break;
+        }
+
+        numSent += result;
+        _numDatagramsSent += result;
+    }
+#endif
+
+    // anything the batched path did not take (or every datagram, where it isn't available)
+    // goes out individually so that errors are reported the usual way
+    for (int i = numSent; i < numDatagrams; ++i) {
+        HifiSockAddr destination(reinterpret_cast<const sockaddr*>(&batch.destinations[i]));
+        sendDatagram(QByteArray::fromRawData(batch.data[i], batch.sizes[i]), destination);
+    }
+}
+
+Socket::SendStats Socket::sampleSendStats() {
+    SendStats stats;
+    stats.datagrams = _numDatagramsSent.exchange(0);
+    stats.syscalls = _numSendSyscalls.exchange(0);
+    return stats;
+}
+
 Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreate) {
     Lock connectionsLock(_connectionsHashMutex);
     auto it = _connectionsHash.find(sockAddr);
@@ -288,9 +424,10 @@ Connection* Socket::findOrCreateConnection(const HifiSockAddr& sockAddr, bool fi
             auto congestionControl = _ccFactory->create();
             congestionControl->setMaxBandwidth(_maxBandwidth);
             auto connection = std::unique_ptr<Connection>(new Connection(this, sockAddr, std::move(congestionControl)));
-            if (QThread::currentThread() != thread()) {
-                qCDebug(networking) << "Moving new Connection to NodeList thread";
-                connection->moveToThread(thread());
+            QThread* connectionThread = ingressThreadForSockAddr(sockAddr);
+            if (QThread::currentThread() != connectionThread) {
+                qCDebug(networking) << "Moving new Connection to" << connectionThread->objectName();
+                connection->moveToThread(connectionThread);
             }
             // allow higher-level classes to find out when connections have completed a handshake
             QObject::connect(connection.get(), &Connection::receiverHandshakeRequestComplete,
@@ -315,21 +452,90 @@ void Socket::clearConnections() {
     if (_connectionsHash.size() > 0) {
         // clear all of the current connections in the socket
         qCDebug(networking) << "Clearing all remaining connections in Socket.";
+        for (auto& pair : _connectionsHash) {
+            destroyConnection(std::move(pair.second));
+        }
         _connectionsHash.clear();
     }
 }
 
 void Socket::cleanupConnection(HifiSockAddr sockAddr) {
     Lock connectionsLock(_connectionsHashMutex);
-    auto numErased = _connectionsHash.erase(sockAddr);
+    auto it = _connectionsHash.find(sockAddr);
 
-    if (numErased > 0) {
+    if (it != _connectionsHash.end()) {
+        destroyConnection(std::move(it->second));
+        _connectionsHash.erase(it);
 #ifdef UDT_CONNECTION_DEBUG
         qCDebug(networking) << "Socket::cleanupConnection called for UDT connection to" << sockAddr;
 #endif
     }
 }
 
+void Socket::destroyConnection(std::unique_ptr<Connection> connection) {
+    if (connection && connection->thread() != QThread::currentThread()) {
+        // the connection belongs to an ingress shard that may be processing a packet for it right now,
+        // let that shard delete it once it gets back to its event loop
+        connection.release()->deleteLater();
+    }
+}
+
+QThread* Socket::ingressThreadForSockAddr(const HifiSockAddr& sockAddr) const {
+    if (_ingressShards.empty()) {
+        return thread();
+    } else {
+        return _ingressShards[std::hash<HifiSockAddr>()(sockAddr) % _ingressShards.size()]->getThread();
+    }
+}
+
+void Socket::setNumIngressShards(int numShards) {
+    if (QThread::currentThread() != thread()) {
+        BLOCKING_INVOKE_METHOD(this, "setNumIngressShards", Q_ARG(int, numShards));
+        return;
+    }
+
+    numShards = std::max(numShards, 0);
+
+    // the shards are looked up under the connections lock by the shard threads themselves
+    Lock connectionsLock(_connectionsHashMutex);
+    if (numShards == (int)_ingressShards.size()) {
+        return;
+    }
+
+    if (!_ingressShards.empty()) {
+        // a connection can only be moved off a thread by that thread, so once the connections
+        // have been handed to the shards they stay where they are
+        qCWarning(networking) << "udt::Socket already has" << _ingressShards.size()
+            << "ingress shards - ignoring request for" << numShards;
+        return;
+    }
+
+    for (int i = 0; i < numShards; ++i) {
+        _ingressShards.emplace_back(new IngressShard(*this, i));
+    }
+
+    // until now every connection lived on this thread, hand each one to the shard its address hashes to
+    for (auto& pair : _connectionsHash) {
+        pair.second->moveToThread(ingressThreadForSockAddr(pair.first));
+    }
+
+    qCDebug(networking) << "udt::Socket is processing received packets on" << numShards << "ingress shard threads";
+}
+
+int Socket::getNumIngressShards() const {
+    Lock connectionsLock(_connectionsHashMutex);
+    return (int)_ingressShards.size();
+}
+
+quint64 Socket::sampleNumIngressDropped() {
+    Lock connectionsLock(_connectionsHashMutex);
+    quint64 numDropped = 0;
+    for (auto& shard : _ingressShards) {
+        numDropped += shard->sampleNumDropped();
+    }
+    return numDropped;
+}
+
 void Socket::messageReceived(std::unique_ptr<Packet> packet) {
     if (_messageHandler) {
         _messageHandler(std::move(packet));
@@ -349,7 +555,7 @@ void Socket::checkForReadyReadBackup() {
         // so that birarda can possibly figure out how the heck we get into this state in the first place
         // output the sequence number and socket address of the last processed packet
         qCDebug(networking) << "Socket::checkForReadyReadyBackup() last sequence number"
-            << (uint32_t) _lastReceivedSequenceNumber << "from" << _lastPacketSockAddr << "-"
+            << _lastReceivedSequenceNumber.load(std::memory_order_relaxed) << "from" << _lastPacketSockAddr << "-"
             << _lastPacketSizeRead << "bytes";
 #ifdef DEBUG_EVENT_QUEUE
         qCDebug(networking) << "NodeList event queue size:" << ::hifi::qt::getEventQueueSize(thread());
@@ -393,8 +599,10 @@ void Socket::readPendingDatagrams() {
         // setup a HifiSockAddr to read into
         HifiSockAddr senderSockAddr;
 
-        // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        // setup a buffer to read the packet into - anything that fits in an MTU comes from the pool
+        auto buffer = (packetSizeWithHeader <= PacketBufferPool::BUFFER_SIZE)
+            ? PacketBufferPool::getInstance().acquire()
+            : PacketBuffer(new char[packetSizeWithHeader]);
 
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
@@ -410,73 +618,166 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processReceivedDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+#if defined(Q_OS_LINUX)
+        if (_isBatchedReceiveEnabled) {
+            // the QUdpSocket read above re-arms Qt's read notifier for this socket,
+            // now drain whatever else is queued in the kernel with as few syscalls as possible
+            if (!readDatagramBatches(abortTime)) {
+                break;
             }
+        }
+#endif
+    }
+}
 
-            continue;
+#if defined(Q_OS_LINUX)
+
+bool Socket::readDatagramBatches(const std::chrono::system_clock::time_point& abortTime) {
+    auto& pool = PacketBufferPool::getInstance();
+    auto socketDescriptor = _udpSocket.socketDescriptor();
+
+    mmsghdr messages[RECEIVE_BATCH_SIZE];
+    iovec ioVectors[RECEIVE_BATCH_SIZE];
+    sockaddr_storage senderAddresses[RECEIVE_BATCH_SIZE];
+
+    while (std::chrono::system_clock::now() <= abortTime) {
+        for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+            // only slots whose buffer was handed off to a packet in the last batch need a new one
+            if (!_receiveBatchBuffers[i]) {
+                _receiveBatchBuffers[i] = pool.acquire();
+            }
+
+            ioVectors[i].iov_base = _receiveBatchBuffers[i].get();
+            ioVectors[i].iov_len = PacketBufferPool::BUFFER_SIZE;
+
+            memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_name = &senderAddresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            messages[i].msg_hdr.msg_iov = &ioVectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        int numReceived = recvmmsg(socketDescriptor, messages, RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (numReceived <= 0) {
+            // EAGAIN/EWOULDBLOCK - the socket is drained
+            return true;
+        }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        _readyReadBackupTimer->start();
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+        auto receiveTime = p_high_resolution_clock::now();
+
+        for (int i = 0; i < numReceived; ++i) {
+            auto& message = messages[i];
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+            if (message.msg_len == 0 || (message.msg_hdr.msg_flags & MSG_TRUNC)) {
+                // nothing useful (or an oversized datagram that could not be ours), the buffer stays in its slot
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+            _lastPacketSizeRead = message.msg_len;
+            _lastPacketSockAddr = senderSockAddr;
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+            processReceivedDatagram(std::move(_receiveBatchBuffers[i]), message.msg_len, senderSockAddr, receiveTime);
+        }
+
+        if (numReceived < RECEIVE_BATCH_SIZE) {
+            // a partial batch means there was nothing more queued when we read
+            return true;
+        }
+    }
+
+    // we ran out of time before the socket was drained
+    return false;
+}
+
+#endif
+
+void Socket::processReceivedDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader,
+                                     const HifiSockAddr& senderSockAddr,
+                                     p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    if (!_ingressShards.empty()) {
+        // hand the rest of the work to the shard that owns this sender's connection
+        auto& shard = _ingressShards[std::hash<HifiSockAddr>()(senderSockAddr) % _ingressShards.size()];
+        shard->queueDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    } else {
+        processConnectionDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
+
+void Socket::processConnectionDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader,
+                                       const HifiSockAddr& senderSockAddr,
+                                       p_high_resolution_clock::time_point receiveTime) {
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber.store((SequenceNumber::UType)packet->getSequenceNumber(), std::memory_order_relaxed);
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+
+                if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                              packet->getDataSize(),
+                                                                              packet->getPayloadSize())) {
+                    // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                    qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                        << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
+                    return;
                 }
+            } else if (connection) {
+                connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                            packet->getPayloadSize());
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+            if (packet->isPartOfMessage()) {
+                auto connection = findOrCreateConnection(senderSockAddr, true);
+                if (connection) {
+                    connection->queueReceivedMessagePacket(std::move(packet));
                 }
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
@@ -578,6 +879,16 @@ void Socket::handleRemoteAddressChange(HifiSockAddr previousAddress, HifiSockAdd
         if (connectionIter != _connectionsHash.end() && connectionIter->second->hasReceivedHandshake()) {
             auto connection = move(connectionIter->second);
             _connectionsHash.erase(connectionIter);
+
+            if (connection->thread() != ingressThreadForSockAddr(currentAddress)) {
+                // the new address belongs to a different ingress shard - the connection cannot follow it there,
+                // so drop it and let a new one be created (with a fresh handshake) by the right shard
+                destroyConnection(move(connection));
+                qCDebug(networking) << "Dropped Connection class for" << previousAddress << "- new address" << currentAddress
+                    << "is handled by another ingress shard";
+                return;
+            }
+
             connection->setDestinationAddress(currentAddress);
             _connectionsHash[currentAddress] = move(connection);
             connectionsLock.unlock();
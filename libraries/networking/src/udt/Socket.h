@@ -14,6 +14,9 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
@@ -26,6 +29,8 @@
 #include "../HifiSockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "IngressShard.h"
+#include "PacketBufferPool.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -37,6 +42,7 @@ class BasePacket;
 class Packet;
 class PacketList;
 class SequenceNumber;
+struct SendBatch;
 
 using PacketFilterOperator = std::function<bool(const Packet&)>;
 using ConnectionCreationFilterOperator = std::function<bool(const HifiSockAddr&)>;
@@ -84,6 +90,31 @@ public:
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
+    // when enabled (Linux only) pending datagrams are drained in batches with recvmmsg into pooled buffers
+    void setBatchedReceiveEnabled(bool enabled) { _isBatchedReceiveEnabled = enabled; }
+    bool isBatchedReceiveEnabled() const { return _isBatchedReceiveEnabled; }
+
+    // when enabled, datagrams written by a thread between beginSendBatch and flushSendBatch are queued
+    // and handed to the kernel together (sendmmsg on Linux) instead of with one syscall each
+    void setBatchedSendEnabled(bool enabled) { _isBatchedSendEnabled = enabled; }
+    bool isBatchedSendEnabled() const { return _isBatchedSendEnabled; }
+    void beginSendBatch();
+    void flushSendBatch();
+
+    struct SendStats {
+        quint64 datagrams { 0 };
+        quint64 syscalls { 0 };
+    };
+    // returns the send counts since the last call
+    SendStats sampleSendStats();
+
+    // process received packets on this many threads, sharded by sender address (0 keeps it all on the socket thread)
+    // the number of shards can only be set once, before or after connections have been made
+    Q_INVOKABLE void setNumIngressShards(int numShards);
+    int getNumIngressShards() const;
+    // returns the number of datagrams dropped by overloaded shards since the last call
+    quint64 sampleNumIngressDropped();
+
     void messageReceived(std::unique_ptr<Packet> packet);
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
     
@@ -111,6 +142,21 @@ private slots:
 private:
     void setSystemBufferSizes();
     Connection* findOrCreateConnection(const HifiSockAddr& sockAddr, bool filterCreation = false);
+
+    qint64 sendDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+    void sendBatchedDatagrams(SendBatch& batch);
+
+    void processReceivedDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                                 p_high_resolution_clock::time_point receiveTime);
+    void processConnectionDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader, const HifiSockAddr& senderSockAddr,
+                                   p_high_resolution_clock::time_point receiveTime);
+    void destroyConnection(std::unique_ptr<Connection> connection);
+    // call with _connectionsHashMutex held
+    QThread* ingressThreadForSockAddr(const HifiSockAddr& sockAddr) const;
+#if defined(Q_OS_LINUX)
+    // returns false if the time box expired before the socket was drained
+    bool readDatagramBatches(const std::chrono::system_clock::time_point& abortTime);
+#endif
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
@@ -129,7 +175,7 @@ private:
     ConnectionCreationFilterOperator _connectionCreationFilterOperator;
 
     Mutex _unreliableSequenceNumbersMutex;
-    Mutex _connectionsHashMutex;
+    mutable Mutex _connectionsHashMutex;
 
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
@@ -143,11 +189,25 @@ private:
 
     bool _shouldChangeSocketOptions { true };
 
+    static const int RECEIVE_BATCH_SIZE = 32;
+    std::atomic<bool> _isBatchedReceiveEnabled { false };
+    std::array<PacketBuffer, RECEIVE_BATCH_SIZE> _receiveBatchBuffers;
+
+    std::atomic<bool> _isBatchedSendEnabled { false };
+    std::atomic<quint64> _numDatagramsSent { 0 };
+    std::atomic<quint64> _numSendSyscalls { 0 };
+
+    // declared after _connectionsHash so the shards (and their threads) go away first
+    // guarded by _connectionsHashMutex, except on the socket thread which is the only one to change it
+    std::vector<std::unique_ptr<IngressShard>> _ingressShards;
+
     int _lastPacketSizeRead { 0 };
-    SequenceNumber _lastReceivedSequenceNumber;
+    // written by every ingress shard, read on the socket thread
+    std::atomic<SequenceNumber::UType> _lastReceivedSequenceNumber { 0 };
     HifiSockAddr _lastPacketSockAddr;
     
     friend UDTTest;
+    friend IngressShard;
 };
     
 } // namespace udt
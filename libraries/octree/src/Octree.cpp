@@ -46,13 +46,14 @@
 #include <PathUtils.h>
 #include <ViewFrustum.h>
 
+#include "OctreeBinaryFile.h"
 #include "OctreeConstants.h"
 #include "OctreeLogging.h"
 #include "OctreeQueryNode.h"
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -676,6 +677,10 @@ bool Octree::readFromFile(const char* fileName) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith("." + OctreeBinaryFile::FILE_TYPE)) {
+        return readFromBinaryFile(qFileName);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -693,6 +698,21 @@ bool Octree::readFromFile(const char* fileName) {
     return success;
 }
 
+bool Octree::readFromBinaryFile(const QString& fileName) {
+    OctreeBinaryFile file;
+    if (!file.open(fileName)) {
+        return false;
+    }
+    // the items are encoded the way this version encodes them, older files have to be loaded from their JSON export
+    if (file.getVersion() != expectedVersion()) {
+        qCWarning(octree) << "Binary octree file" << fileName << "is version" << file.getVersion()
+                          << "expected version" << expectedVersion();
+        return false;
+    }
+    qCDebug(octree) << "Reading binary octree file" << fileName << "with" << (int)file.getSections().size() << "sections";
+    return readFromBinary(file);
+}
+
 bool Octree::readJSONFromGzippedFile(QString qFileName) {
     QFile file(qFileName);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -865,6 +885,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == OctreeBinaryFile::FILE_TYPE && !element) {
+        success = writeToBinaryFile(cFileName);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -970,6 +992,33 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToBinaryFile(const char* fileName) {
+    qCDebug(octree, "Saving binary octree to file %s...", fileName);
+
+    OctreeBinaryFile file;
+    if (!writeToBinary(file)) {
+        qCritical("Failed to encode octree for binary file.");
+        return false;
+    }
+
+    QSaveFile persistFile(fileName);
+    bool success = false;
+    if (persistFile.open(QIODevice::WriteOnly)) {
+        if (persistFile.write(file.toByteArray()) != -1) {
+            success = persistFile.commit();
+            if (!success) {
+                qCritical() << "Failed to commit to binary save file:" << persistFile.errorString();
+            }
+        } else {
+            qCritical("Failed to write to binary file.");
+        }
+    } else {
+        qCritical("Failed to open binary file for writing.");
+    }
+
+    return success;
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
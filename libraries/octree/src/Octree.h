@@ -12,6 +12,7 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <stdint.h>
@@ -32,6 +33,7 @@
 
 class ReadBitstreamToTreeParams;
 class Octree;
+class OctreeBinaryFile;
 class OctreeElement;
 class OctreePacketData;
 class Shape;
@@ -136,6 +138,7 @@ public:
     virtual PacketType expectedDataPacketType() const { return PacketType::Unknown; }
     virtual PacketVersion expectedVersion() const { return versionForPacketType(expectedDataPacketType()); }
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
+    // takes whatever locks it needs, so that edits can be decoded and filtered without holding up readers of the tree
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -213,6 +216,8 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    bool writeToBinaryFile(const char* filename);
+    virtual bool writeToBinary(OctreeBinaryFile& file) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -222,6 +227,15 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="");
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    bool readFromBinaryFile(const QString& filename);
+    virtual bool readFromBinary(const OctreeBinaryFile& file) { return false; }
+
+    // journaled persistence, see OctreeJournal
+    void setWantJournal(bool wantJournal) { _wantJournal = wantJournal; }
+    bool getWantJournal() const { return _wantJournal; }
+    // encodes what was added, edited or deleted since the changes were last taken, returns false if nothing was
+    virtual bool takeJournalChanges(QByteArray& changes) { return false; }
+    virtual bool replayJournalChanges(const QByteArray& changes) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -250,6 +264,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
+    int64_t getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
@@ -276,8 +292,9 @@ protected:
 
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
+    std::atomic<bool> _wantJournal { false };
 
-    bool _isDirty;
+    std::atomic<bool> _isDirty;
     bool _shouldReaverage;
 
     bool _isViewing;
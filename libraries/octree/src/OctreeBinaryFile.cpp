@@ -0,0 +1,163 @@
+//
+//  OctreeBinaryFile.cpp
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-06-23.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeBinaryFile.h"
+
+#include <cstring>
+
+#include <UUID.h>
+
+#include "OctreeLogging.h"
+
+const QString OctreeBinaryFile::FILE_TYPE = "bin";
+
+namespace {
+    const char MAGIC[8] = { 'H', 'F', 'O', 'C', 'T', 'B', 'I', 'N' };
+
+    struct Header {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t version;
+        char id[NUM_BYTES_RFC4122_UUID];
+        int64_t dataVersion;
+        uint32_t numSections;
+        uint32_t padding;
+    };
+
+    struct SectionInfo {
+        uint64_t offset;
+        uint64_t size;
+        uint32_t numItems;
+        uint32_t padding;
+    };
+}
+
+OctreeBinaryFile::~OctreeBinaryFile() {
+    if (_map) {
+        _file.unmap(_map);
+    }
+}
+
+void OctreeBinaryFile::setInfo(const QUuid& id, int64_t dataVersion, PacketVersion version) {
+    _id = id;
+    _dataVersion = dataVersion;
+    _version = version;
+}
+
+void OctreeBinaryFile::appendItem(QByteArray& section, const QByteArray& item) {
+    uint32_t size = (uint32_t)item.size();
+    section.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    section.append(item);
+}
+
+void OctreeBinaryFile::addSection(const QByteArray& section, uint32_t numItems) {
+    _sectionData.push_back(section);
+    _sections.push_back({ _sectionData.back().constData(), (uint64_t)section.size(), numItems });
+}
+
+QByteArray OctreeBinaryFile::toByteArray() const {
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.version = _version;
+    memcpy(header.id, _id.toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+    header.dataVersion = _dataVersion;
+    header.numSections = (uint32_t)_sectionData.size();
+    header.padding = 0;
+
+    uint64_t offset = sizeof(Header) + _sectionData.size() * sizeof(SectionInfo);
+    std::vector<SectionInfo> index;
+    for (size_t i = 0; i < _sectionData.size(); ++i) {
+        index.push_back({ offset, (uint64_t)_sectionData[i].size(), _sections[i].numItems, 0 });
+        offset += _sectionData[i].size();
+    }
+
+    QByteArray data;
+    data.reserve((int)offset);
+    data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char*>(index.data()), (int)(index.size() * sizeof(SectionInfo)));
+    for (const QByteArray& section : _sectionData) {
+        data.append(section);
+    }
+    return data;
+}
+
+bool OctreeBinaryFile::open(const QString& filename) {
+    _file.setFileName(filename);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(octree) << "Cannot open binary octree file for reading:" << filename << _file.errorString();
+        return false;
+    }
+
+    uint64_t fileSize = _file.size();
+    if (fileSize < sizeof(Header)) {
+        qCWarning(octree) << "Binary octree file is too small:" << filename;
+        return false;
+    }
+    _map = _file.map(0, fileSize);
+    if (!_map) {
+        qCWarning(octree) << "Cannot map binary octree file:" << filename << _file.errorString();
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, _map, sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        qCWarning(octree) << "Not a binary octree file:" << filename;
+        return false;
+    }
+    if (header.formatVersion != FORMAT_VERSION) {
+        qCWarning(octree) << "Binary octree file" << filename << "has unsupported format version" << header.formatVersion;
+        return false;
+    }
+    _id = QUuid::fromRfc4122(QByteArray::fromRawData(header.id, NUM_BYTES_RFC4122_UUID));
+    _dataVersion = header.dataVersion;
+    _version = (PacketVersion)header.version;
+
+    uint64_t indexEnd = sizeof(Header) + (uint64_t)header.numSections * sizeof(SectionInfo);
+    if (indexEnd > fileSize) {
+        qCWarning(octree) << "Binary octree file" << filename << "is cut short in its section index";
+        return false;
+    }
+    _sections.clear();
+    for (uint32_t i = 0; i < header.numSections; ++i) {
+        SectionInfo info;
+        memcpy(&info, _map + sizeof(Header) + i * sizeof(SectionInfo), sizeof(SectionInfo));
+        if (info.offset < indexEnd || info.offset > fileSize || info.size > fileSize - info.offset) {
+            qCWarning(octree) << "Binary octree file" << filename << "has a section outside of the file";
+            _sections.clear();
+            return false;
+        }
+        _sections.push_back({ reinterpret_cast<const char*>(_map + info.offset), info.size, info.numItems });
+    }
+    return true;
+}
+
+bool OctreeBinaryFile::forEachItem(const Section& section, const ItemFunctor& f) const {
+    const char* dataAt = section.data;
+    const char* end = section.data + section.size;
+    for (uint32_t i = 0; i < section.numItems; ++i) {
+        uint32_t size;
+        if ((uint64_t)(end - dataAt) < sizeof(size)) {
+            return false;
+        }
+        memcpy(&size, dataAt, sizeof(size));
+        dataAt += sizeof(size);
+        if ((uint64_t)(end - dataAt) < size) {
+            return false;
+        }
+        if (!f(reinterpret_cast<const unsigned char*>(dataAt), (int)size)) {
+            return true;
+        }
+        dataAt += size;
+    }
+    return true;
+}
@@ -0,0 +1,83 @@
+//
+//  OctreeBinaryFile.h
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-06-23.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeBinaryFile_h
+#define hifi_OctreeBinaryFile_h
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+#include <udt/PacketHeaders.h>
+
+// The binary persist file of an octree, which is written and read without going through JSON.
+//
+// The file starts with a header with the id and versions of the data and a section index, followed by the sections.
+// Each section is a run of items, and each item is its size followed by the bytes the tree encoded it to, so that the
+// file can be memory mapped and its sections decoded in parallel.
+//
+//     Header | SectionInfo[numSections] | section | section | ...
+//     section: (uint32_t size | bytes) (uint32_t size | bytes) ...
+class OctreeBinaryFile {
+public:
+    static const QString FILE_TYPE;
+    static const uint32_t FORMAT_VERSION = 1;
+
+    struct Section {
+        const char* data;
+        uint64_t size;
+        uint32_t numItems;
+    };
+
+    using ItemFunctor = std::function<bool(const unsigned char* data, int size)>;
+
+    OctreeBinaryFile() {}
+    ~OctreeBinaryFile();
+
+    // writing
+    void setInfo(const QUuid& id, int64_t dataVersion, PacketVersion version);
+    // appends an item to a section that's being built
+    static void appendItem(QByteArray& section, const QByteArray& item);
+    void addSection(const QByteArray& section, uint32_t numItems);
+    QByteArray toByteArray() const;
+
+    // reading, maps the file and checks its header and section index
+    bool open(const QString& filename);
+    // calls f with each item of the section, until f returns false, returns false if the section is cut short
+    bool forEachItem(const Section& section, const ItemFunctor& f) const;
+
+    const QUuid& getID() const { return _id; }
+    int64_t getDataVersion() const { return _dataVersion; }
+    PacketVersion getVersion() const { return _version; }
+    const std::vector<Section>& getSections() const { return _sections; }
+
+private:
+    OctreeBinaryFile(const OctreeBinaryFile&) = delete;
+    OctreeBinaryFile& operator=(const OctreeBinaryFile&) = delete;
+
+    QUuid _id;
+    int64_t _dataVersion { 0 };
+    PacketVersion _version { 0 };
+    std::vector<Section> _sections;
+
+    // the sections of a file that's being written point into these
+    std::vector<QByteArray> _sectionData;
+
+    QFile _file;
+    uchar* _map { nullptr };
+};
+
+#endif // hifi_OctreeBinaryFile_h
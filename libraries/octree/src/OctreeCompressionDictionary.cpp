@@ -0,0 +1,62 @@
+//
+//  OctreeCompressionDictionary.cpp
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-06-25.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeCompressionDictionary.h"
+
+#include <zstd.h>
+#include <zdict.h>
+
+#include "OctreeLogging.h"
+
+OctreeCompressionDictionaryPointer OctreeCompressionDictionary::create(const QByteArray& data) {
+    uint32_t id = ZDICT_getDictID(data.constData(), data.size());
+    if (id == 0) {
+        qCWarning(octree) << "Not a zstd compression dictionary," << data.size() << "bytes";
+        return nullptr;
+    }
+
+    auto dictionary = std::shared_ptr<OctreeCompressionDictionary>(new OctreeCompressionDictionary());
+    dictionary->_id = id;
+    dictionary->_data = data;
+    dictionary->_compressionDictionary = ZSTD_createCDict(data.constData(), data.size(), COMPRESSION_LEVEL);
+    dictionary->_decompressionDictionary = ZSTD_createDDict(data.constData(), data.size());
+    if (!dictionary->_compressionDictionary || !dictionary->_decompressionDictionary) {
+        qCWarning(octree) << "Failed to load zstd compression dictionary" << id;
+        return nullptr;
+    }
+    return dictionary;
+}
+
+QByteArray OctreeCompressionDictionary::train(const std::vector<QByteArray>& samples, size_t maxSize) {
+    QByteArray samplesBuffer;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const QByteArray& sample : samples) {
+        samplesBuffer.append(sample);
+        sampleSizes.push_back(sample.size());
+    }
+
+    QByteArray dictionary((int)maxSize, 0);
+    size_t size = ZDICT_trainFromBuffer(dictionary.data(), maxSize, samplesBuffer.constData(), sampleSizes.data(),
+                                        (unsigned)sampleSizes.size());
+    if (ZDICT_isError(size)) {
+        qCWarning(octree) << "Failed to train a compression dictionary on" << (int)samples.size() << "samples:"
+                          << ZDICT_getErrorName(size);
+        return QByteArray();
+    }
+    dictionary.resize((int)size);
+    return dictionary;
+}
+
+OctreeCompressionDictionary::~OctreeCompressionDictionary() {
+    ZSTD_freeCDict(_compressionDictionary);
+    ZSTD_freeDDict(_decompressionDictionary);
+}
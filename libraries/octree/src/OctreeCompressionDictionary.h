@@ -0,0 +1,64 @@
+//
+//  OctreeCompressionDictionary.h
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-06-25.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeCompressionDictionary_h
+#define hifi_OctreeCompressionDictionary_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+class OctreeCompressionDictionary;
+using OctreeCompressionDictionaryPointer = std::shared_ptr<const OctreeCompressionDictionary>;
+
+// A zstd dictionary trained offline on a domain's own entity data.
+//
+// Octree packets are small, and compress poorly on their own, but the same URLs, userData and material data show up in
+// packet after packet. The server and the clients it has sent its dictionary to compress and decompress each packet as
+// if it followed the data the dictionary was trained on.
+class OctreeCompressionDictionary {
+public:
+    static const int COMPRESSION_LEVEL = 3;
+    static const size_t DEFAULT_MAX_SIZE = 110 * 1024;
+
+    // returns nullptr if the data isn't a zstd dictionary
+    static OctreeCompressionDictionaryPointer create(const QByteArray& data);
+
+    // trains a dictionary of up to maxSize bytes on samples of the data it will compress, returns an empty array if
+    // there weren't enough samples to train it on
+    static QByteArray train(const std::vector<QByteArray>& samples, size_t maxSize = DEFAULT_MAX_SIZE);
+
+    ~OctreeCompressionDictionary();
+
+    uint32_t getID() const { return _id; }
+    const QByteArray& getData() const { return _data; }
+
+    const ZSTD_CDict_s* getCompressionDictionary() const { return _compressionDictionary; }
+    const ZSTD_DDict_s* getDecompressionDictionary() const { return _decompressionDictionary; }
+
+private:
+    OctreeCompressionDictionary() {}
+    OctreeCompressionDictionary(const OctreeCompressionDictionary&) = delete;
+    OctreeCompressionDictionary& operator=(const OctreeCompressionDictionary&) = delete;
+
+    uint32_t _id { 0 };
+    QByteArray _data;
+    ZSTD_CDict_s* _compressionDictionary { nullptr };
+    ZSTD_DDict_s* _decompressionDictionary { nullptr };
+};
+
+#endif // hifi_OctreeCompressionDictionary_h
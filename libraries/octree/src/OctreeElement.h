@@ -224,8 +224,9 @@ protected:
       unsigned char* pointer;
     } _octalCode;
 
-    quint64 _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
-    uint64_t _lastChangedContent { 0 };
+    // atomic because in-place entity edits mark elements while send threads read them, see EntityTree::updateEntityInPlace
+    std::atomic<quint64> _lastChanged { 0 }; /// Client and server, timestamp this node was last changed, 8 bytes
+    std::atomic<uint64_t> _lastChangedContent { 0 };
 
     /// Client and server, pointers to child nodes, various encodings
 #ifdef SIMPLE_CHILD_ARRAY
@@ -11,16 +11,23 @@
 
 #include "OctreeEntitiesFileParser.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cctype>
 
 #include <QUuid>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QtConcurrent/QtConcurrentRun>
 
 
 using std::string;
 
+namespace {
+    // entity objects are parsed on worker threads in batches of this many
+    const int ENTITIES_PER_PARSE_BATCH = 256;
+}
+
 std::string OctreeEntitiesFileParser::getErrorString() const {
     std::ostringstream err;
     if (_errorString.size() != 0) {
@@ -219,6 +226,8 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
         return false;
     }
 
+    // find where each entity object starts and ends here, and leave parsing them to worker threads
+    std::vector<EntitySpan> entitySpans;
     while (true) {
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
@@ -230,23 +239,57 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
-            return false;
-        }
-
-        entitiesArray.append(entity.object());
+        entitySpans.push_back({ _position - 1, matchingBrace - _position + 1, _line });
         _position = matchingBrace;
         char c = nextToken();
         if (c == ']') {
-            return true;
+            break;
         } else if (c != ',') {
             _errorString = "Entity array item incorrectly terminated";
             return false;
         }
     }
+    return parseEntityObjects(entitySpans, entitiesArray);
+}
+
+bool OctreeEntitiesFileParser::parseEntityObjects(const std::vector<EntitySpan>& entitySpans, QVariantList& entitiesArray) {
+    const int numEntities = (int)entitySpans.size();
+    QVector<QFuture<int>> batches;
+    std::vector<QJsonObject> entities(numEntities);
+    for (int start = 0; start < numEntities; start += ENTITIES_PER_PARSE_BATCH) {
+        int end = std::min(start + ENTITIES_PER_PARSE_BATCH, numEntities);
+        batches.push_back(QtConcurrent::run([this, &entitySpans, &entities, start, end] {
+            for (int i = start; i < end; ++i) {
+                const EntitySpan& span = entitySpans[i];
+                QJsonDocument entity = QJsonDocument::fromJson(
+                    QByteArray::fromRawData(_entitiesContents.constData() + span.start, span.length));
+                if (entity.isNull()) {
+                    return i;
+                }
+                entities[i] = entity.object();
+            }
+            return -1;
+        }));
+    }
+
+    int badEntity = -1;
+    for (auto& batch : batches) {
+        int batchBadEntity = batch.result();
+        if (badEntity < 0) {
+            badEntity = batchBadEntity;
+        }
+    }
+    if (badEntity >= 0) {
+        _position = entitySpans[badEntity].start;
+        _line = entitySpans[badEntity].line;
+        _errorString = "Ill-formed entity";
+        return false;
+    }
+
+    entitiesArray.reserve(numEntities);
+    for (const QJsonObject& entity : entities) {
+        entitiesArray.append(entity);
+    }
     return true;
 }
 
@@ -14,6 +14,8 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <vector>
+
 #include <QByteArray>
 #include <QVariant>
 
@@ -27,7 +29,14 @@ private:
     int nextToken();
     std::string readString();
     int readInteger();
+    struct EntitySpan {
+        int start;
+        int length;
+        int line;
+    };
+
     bool readEntitiesArray(QVariantList& entitiesArray);
+    bool parseEntityObjects(const std::vector<EntitySpan>& entitySpans, QVariantList& entitiesArray);
     int findMatchingBrace() const;
 
     QByteArray _entitiesContents;
@@ -0,0 +1,141 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-06-24.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournal.h"
+
+#include <cstring>
+
+#include <QtCore/QSaveFile>
+
+#include <UUID.h>
+
+#include "OctreeLogging.h"
+
+const QString OctreeJournal::EXTENSION = "journal";
+
+namespace {
+    const char MAGIC[8] = { 'H', 'F', 'O', 'C', 'T', 'J', 'N', 'L' };
+    const uint32_t FORMAT_VERSION = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t padding;
+        char id[NUM_BYTES_RFC4122_UUID];
+        int64_t dataVersion;
+    };
+
+    struct EntryHeader {
+        int64_t dataVersion;
+        uint32_t size;
+        uint32_t checksum;
+    };
+}
+
+OctreeJournal::OctreeJournal(const QString& filename) :
+    _filename(filename),
+    _file(filename)
+{
+}
+
+bool OctreeJournal::open(const QUuid& id, int64_t dataVersion, std::vector<Entry>& entries) {
+    _file.close();
+    if (!_file.exists() || !_file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    QByteArray data = _file.readAll();
+    Header header;
+    if (data.size() < (int)sizeof(Header)) {
+        _file.close();
+        return false;
+    }
+    memcpy(&header, data.constData(), sizeof(Header));
+    QUuid journalID = QUuid::fromRfc4122(QByteArray::fromRawData(header.id, NUM_BYTES_RFC4122_UUID));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.formatVersion != FORMAT_VERSION ||
+        journalID != id || header.dataVersion != dataVersion) {
+        // it follows another snapshot, whose changes are all in the one that's been loaded
+        qCDebug(octree) << "Journal" << _filename << "doesn't follow snapshot" << id << dataVersion;
+        _file.close();
+        return false;
+    }
+
+    int offset = sizeof(Header);
+    while (offset + (int)sizeof(EntryHeader) <= data.size()) {
+        EntryHeader entryHeader;
+        memcpy(&entryHeader, data.constData() + offset, sizeof(EntryHeader));
+        int entryEnd = offset + (int)sizeof(EntryHeader) + (int)entryHeader.size;
+        if (entryHeader.size > (uint32_t)data.size() || entryEnd > data.size()) {
+            break;
+        }
+        const char* changes = data.constData() + offset + sizeof(EntryHeader);
+        if (qChecksum(changes, entryHeader.size) != entryHeader.checksum) {
+            break;
+        }
+        entries.push_back({ entryHeader.dataVersion, QByteArray(changes, entryHeader.size) });
+        offset = entryEnd;
+    }
+
+    if (offset < data.size()) {
+        qCWarning(octree) << "Cutting off" << data.size() - offset << "bytes of unfinished entries from journal" << _filename;
+        _file.resize(offset);
+    }
+    _file.seek(offset);
+    return true;
+}
+
+bool OctreeJournal::reset(const QUuid& id, int64_t dataVersion) {
+    _file.close();
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.padding = 0;
+    memcpy(header.id, id.toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+    header.dataVersion = dataVersion;
+
+    QSaveFile journalFile(_filename);
+    if (!journalFile.open(QIODevice::WriteOnly) ||
+        journalFile.write(reinterpret_cast<const char*>(&header), sizeof(Header)) != sizeof(Header) ||
+        !journalFile.commit()) {
+        qCWarning(octree) << "Failed to start journal" << _filename << journalFile.errorString();
+        return false;
+    }
+
+    if (!_file.open(QIODevice::ReadWrite)) {
+        qCWarning(octree) << "Failed to open journal" << _filename << _file.errorString();
+        return false;
+    }
+    _file.seek(_file.size());
+    return true;
+}
+
+bool OctreeJournal::append(int64_t dataVersion, const QByteArray& changes) {
+    if (!_file.isOpen()) {
+        return false;
+    }
+
+    EntryHeader entryHeader;
+    entryHeader.dataVersion = dataVersion;
+    entryHeader.size = (uint32_t)changes.size();
+    entryHeader.checksum = qChecksum(changes.constData(), changes.size());
+
+    qint64 start = _file.pos();
+    if (_file.write(reinterpret_cast<const char*>(&entryHeader), sizeof(EntryHeader)) != sizeof(EntryHeader) ||
+        _file.write(changes) != changes.size() || !_file.flush()) {
+        qCWarning(octree) << "Failed to append to journal" << _filename << _file.errorString();
+        // don't leave half an entry for the next one to follow
+        _file.resize(start);
+        _file.seek(start);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Created by High Fidelity on 2019-06-24.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeJournal_h
+#define hifi_OctreeJournal_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+// An append-only journal of the changes made to an octree since its persist file, the snapshot, was written.
+//
+// The file starts with the id and data version of the snapshot it follows. Each entry after that has the data version
+// it brings the tree to, and the changes the tree encoded, with their size and a checksum. The tree is recovered by
+// loading the snapshot and replaying the entries in order. An entry that was cut short or garbled by a crash ends the
+// journal, and is cut off before anything is appended.
+class OctreeJournal {
+public:
+    static const QString EXTENSION;
+
+    struct Entry {
+        int64_t dataVersion;
+        QByteArray changes;
+    };
+
+    OctreeJournal(const QString& filename);
+
+    const QString& getFilename() const { return _filename; }
+
+    // reads the entries of the journal if it follows the snapshot with this id and data version, and opens it to append
+    // more, returns false if there's no journal for that snapshot
+    bool open(const QUuid& id, int64_t dataVersion, std::vector<Entry>& entries);
+    // starts an empty journal that follows the snapshot with this id and data version
+    bool reset(const QUuid& id, int64_t dataVersion);
+    bool append(int64_t dataVersion, const QByteArray& changes);
+
+    qint64 size() const { return _file.isOpen() ? _file.size() : 0; }
+
+private:
+    QString _filename;
+    QFile _file;
+};
+
+#endif // hifi_OctreeJournal_h
@@ -11,6 +11,8 @@
 
 #include "OctreePacketData.h"
 
+#include <zstd.h>
+
 #include <GLMHelpers.h>
 #include <PerfStat.h>
 
@@ -25,6 +27,19 @@ AtomicUIntStat OctreePacketData::_totalBytesOfValues { 0 };
 AtomicUIntStat OctreePacketData::_totalBytesOfPositions { 0 };
 AtomicUIntStat OctreePacketData::_totalBytesOfRawData { 0 };
 
+namespace {
+    // zstd contexts are kept for each thread, so that packets are compressed and uncompressed without allocating
+    ZSTD_CCtx* getZstdCompressionContext() {
+        thread_local std::unique_ptr<ZSTD_CCtx, size_t(*)(ZSTD_CCtx*)> context { ZSTD_createCCtx(), ZSTD_freeCCtx };
+        return context.get();
+    }
+
+    ZSTD_DCtx* getZstdDecompressionContext() {
+        thread_local std::unique_ptr<ZSTD_DCtx, size_t(*)(ZSTD_DCtx*)> context { ZSTD_createDCtx(), ZSTD_freeDCtx };
+        return context.get();
+    }
+}
+
 struct aaCubeData {
     glm::vec3 corner;
     float scale;
@@ -50,6 +65,18 @@ void OctreePacketData::changeSettings(bool enableCompression, unsigned int targe
     reset();
 }
 
+void OctreePacketData::setCompression(OctreePacketCompression compression,
+                                      const OctreeCompressionDictionaryPointer& dictionary) {
+    OctreeCompressionDictionaryPointer compressionDictionary =
+        compression == OctreePacketCompression::Zstd ? dictionary : nullptr;
+    if (compression != _compression || compressionDictionary != _compressionDictionary) {
+        _compression = compression;
+        _compressionDictionary = compressionDictionary;
+        // content that's already there is compressed again when it's finalized
+        _dirty = _dirty || hasContent();
+    }
+}
+
 void OctreePacketData::reset() {
     _bytesInUse = 0;
     _bytesAvailable = _targetSize;
@@ -598,6 +625,10 @@ bool OctreePacketData::compressContent() {
 
     _bytesInUseLastCheck = _bytesInUse;
 
+    if (_compression == OctreePacketCompression::Zstd) {
+        return compressContentWithZstd();
+    }
+
     bool success = false;
     const int MAX_COMPRESSION = 9;
 
@@ -620,12 +651,79 @@ bool OctreePacketData::compressContent() {
 }
 
 
+bool OctreePacketData::compressContentWithZstd() {
+    ZSTD_CCtx* context = getZstdCompressionContext();
+    size_t compressedSize;
+    if (_compressionDictionary) {
+        compressedSize = ZSTD_compress_usingCDict(context, _compressed, _compressedByteArray.size(), _uncompressed,
+                                                  _bytesInUse, _compressionDictionary->getCompressionDictionary());
+    } else {
+        compressedSize = ZSTD_compressCCtx(context, _compressed, _compressedByteArray.size(), _uncompressed, _bytesInUse,
+                                           OctreeCompressionDictionary::COMPRESSION_LEVEL);
+    }
+
+    if (ZSTD_isError(compressedSize)) {
+        qCWarning(octree) << "OctreePacketData::compressContentWithZstd --" << ZSTD_getErrorName(compressedSize);
+        assert(false);
+        return false;
+    }
+    _compressedBytes = (int)compressedSize;
+    _dirty = false;
+    return true;
+}
+
+bool OctreePacketData::uncompressZstdContent(const unsigned char* data, int length) {
+    // content compressed with a dictionary has its ID, which has to be the one we have
+    unsigned int dictionaryID = ZSTD_getDictID_fromFrame(data, length);
+    if (dictionaryID != 0 && (!_compressionDictionary || _compressionDictionary->getID() != dictionaryID)) {
+        qCWarning(octree) << "OctreePacketData::uncompressZstdContent -- don't have compression dictionary" << dictionaryID;
+        return false;
+    }
+
+    unsigned long long uncompressedSize = ZSTD_getFrameContentSize(data, length);
+    if (uncompressedSize == ZSTD_CONTENTSIZE_UNKNOWN || uncompressedSize == ZSTD_CONTENTSIZE_ERROR ||
+        uncompressedSize > MAX_OCTREE_UNCOMRESSED_PACKET_SIZE) {
+        qCWarning(octree) << "OctreePacketData::uncompressZstdContent -- bad content size";
+        return false;
+    }
+    if ((int)uncompressedSize > _bytesAvailable) {
+        int moreNeeded = (int)uncompressedSize - _bytesAvailable;
+        _uncompressedByteArray.resize(_uncompressedByteArray.size() + moreNeeded);
+        _uncompressed = (unsigned char*)_uncompressedByteArray.data();
+        _bytesAvailable += moreNeeded;
+    }
+
+    ZSTD_DCtx* context = getZstdDecompressionContext();
+    size_t result;
+    if (dictionaryID != 0) {
+        result = ZSTD_decompress_usingDDict(context, _uncompressed, _bytesAvailable, data, length,
+                                            _compressionDictionary->getDecompressionDictionary());
+    } else {
+        result = ZSTD_decompressDCtx(context, _uncompressed, _bytesAvailable, data, length);
+    }
+    if (ZSTD_isError(result)) {
+        qCWarning(octree) << "OctreePacketData::uncompressZstdContent --" << ZSTD_getErrorName(result);
+        return false;
+    }
+
+    _bytesInUse = (int)result;
+    _bytesAvailable -= _bytesInUse;
+    return true;
+}
+
 void OctreePacketData::loadFinalizedContent(const unsigned char* data, int length) {
     reset();
 
     if (data && length > 0) {
 
-        if (_enableCompression) {
+        if (_enableCompression && _compression == OctreePacketCompression::Zstd) {
+            _compressedBytes = length;
+            memcpy(_compressed, data, _compressedBytes);
+
+            if (!uncompressZstdContent(data, length)) {
+                reset();
+            }
+        } else if (_enableCompression) {
             _compressedBytes = length;
             memcpy(_compressed, data, _compressedBytes);
 
@@ -42,6 +42,7 @@
 #include "GizmoType.h"
 #include "TextEffect.h"
 
+#include "OctreeCompressionDictionary.h"
 #include "OctreeConstants.h"
 #include "OctreeElement.h"
 
@@ -67,6 +68,12 @@ const int REASONABLE_NUMBER_OF_PACKING_ATTEMPTS = 5;
 
 const int PACKET_IS_COLOR_BIT = 0;
 const int PACKET_IS_COMPRESSED_BIT = 1;
+const int PACKET_IS_ZSTD_COMPRESSED_BIT = 2; // only sent to clients that asked for zstd in their query
+
+enum class OctreePacketCompression : uint8_t {
+    Zlib,
+    Zstd
+};
 
 /// An opaque key used when starting, ending, and discarding encoding/packing levels of OctreePacketData
 class LevelDetails {
@@ -97,6 +104,10 @@ public:
     /// change compression and target size settings
     void changeSettings(bool enableCompression = false, unsigned int targetSize = MAX_OCTREE_PACKET_DATA_SIZE);
 
+    /// change the codec content is compressed with on finalization, zstd content is compressed with the dictionary if
+    /// there is one. Kept across changeSettings()
+    void setCompression(OctreePacketCompression compression, const OctreeCompressionDictionaryPointer& dictionary = nullptr);
+
     /// reset completely, all data is discarded
     void reset();
     
@@ -238,8 +249,9 @@ public:
     /// load finalized content to allow access to decoded content for parsing
     void loadFinalizedContent(const unsigned char* data, int length);
     
-    /// returns whether or not zlib compression enabled on finalization
+    /// returns whether or not compression enabled on finalization
     bool isCompressed() const { return _enableCompression; }
+    OctreePacketCompression getCompression() const { return _compression; }
     
     /// returns the target uncompressed size
     unsigned int getTargetSize() const { return _targetSize; }
@@ -297,6 +309,8 @@ private:
 
     unsigned int _targetSize;
     bool _enableCompression;
+    OctreePacketCompression _compression { OctreePacketCompression::Zlib };
+    OctreeCompressionDictionaryPointer _compressionDictionary;
     
     QByteArray _uncompressedByteArray;
     unsigned char* _uncompressed { nullptr };
@@ -307,6 +321,8 @@ private:
     int _subTreeBytesReserved; // the number of reserved bytes at start of a subtree
 
     bool compressContent();
+    bool compressContentWithZstd();
+    bool uncompressZstdContent(const unsigned char* data, int length);
     
     QByteArray _compressedByteArray;
     unsigned char* _compressed { nullptr };
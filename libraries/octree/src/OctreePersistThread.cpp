@@ -33,15 +33,18 @@
 #include <PathUtils.h>
 #include <Gzip.h>
 
+#include "OctreeBinaryFile.h"
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
+constexpr std::chrono::seconds OctreePersistThread::DEFAULT_SNAPSHOT_INTERVAL { 3600 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
+constexpr int64_t MAX_OCTREE_JOURNAL_SIZE_BYTES { 100 * 1000 * 1000 };
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
                                          bool debugTimestampNow, QString persistAsFileType) :
@@ -60,6 +63,24 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _filename = sansExt + "." + _persistAsFileType;
 }
 
+void OctreePersistThread::enableJournal(std::chrono::milliseconds snapshotInterval) {
+    QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
+    _journal = std::unique_ptr<OctreeJournal>(new OctreeJournal(sansExt + "." + OctreeJournal::EXTENSION));
+    _snapshotInterval = snapshotInterval;
+}
+
+int64_t OctreePersistThread::getJournaledDataVersion(const QUuid& id, int64_t dataVersion) const {
+    // the domain server is told the version of the last journal entry, which it doesn't have a newer copy of
+    if (_journal) {
+        OctreeJournal journal(_journal->getFilename());
+        std::vector<OctreeJournal::Entry> entries;
+        if (journal.open(id, dataVersion, entries) && !entries.empty()) {
+            return entries.back().dataVersion;
+        }
+    }
+    return dataVersion;
+}
+
 void OctreePersistThread::start() {
     cleanupOldReplacementBackups();
 
@@ -72,9 +93,26 @@ void OctreePersistThread::start() {
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
+    // this may be the file of another type that this one replaces, or the JSON that replaced it
+    QString filename = findMostRecentFileExtension(_filename, PERSIST_EXTENSIONS);
+    qCDebug(octree) << "Reading octree data from" << filename;
+    QFile file(filename);
+    if (filename.endsWith("." + OctreeBinaryFile::FILE_TYPE)) {
+        // the binary file is read straight into the tree once the domain server has replied, just check its header
+        OctreeBinaryFile binaryFile;
+        if (binaryFile.open(filename) && binaryFile.getVersion() == _tree->expectedVersion()) {
+            qCDebug(octree) << "Current octree data: ID(" << binaryFile.getID() << ") DataVersion("
+                            << binaryFile.getDataVersion() << ")";
+            packet->writePrimitive(true);
+            auto id = binaryFile.getID().toRfc4122();
+            packet->write(id);
+            packet->writePrimitive(getJournaledDataVersion(binaryFile.getID(), binaryFile.getDataVersion()));
+        } else {
+            // ask the domain server for its JSON export of it
+            qCWarning(octree) << "No octree data this version can read in" << filename;
+            packet->writePrimitive(false);
+        }
+    } else if (file.open(QIODevice::ReadOnly)) {
         QByteArray jsonData(file.readAll());
         file.close();
         if (!gunzip(jsonData, _cachedJSONData)) {
@@ -86,14 +124,14 @@ void OctreePersistThread::start() {
             packet->writePrimitive(true);
             auto id = data.id.toRfc4122();
             packet->write(id);
-            packet->writePrimitive(data.dataVersion);
+            packet->writePrimitive((OctreeUtils::Version)getJournaledDataVersion(data.id, data.dataVersion));
         } else {
             _cachedJSONData.clear();
             qCWarning(octree) << "No octree data found";
             packet->writePrimitive(false);
         }
     } else {
-        qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
+        qCWarning(octree) << "Couldn't access file" << filename << file.errorString();
         packet->writePrimitive(false);
     }
 
@@ -116,14 +154,15 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         _cachedJSONData.clear();
         replacementData = message->readAll();
         replaceData(replacementData);
-        hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        hasValidOctreeData = data.readOctreeDataInfoFromFile(getReplacementFilename());
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
         OctreeUtils::RawEntityData data;
         qCDebug(octree) << "Reading octree data from" << _filename;
-        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+        // a binary file is read with its id and version, and doesn't have to be parsed here
+        if (!_cachedJSONData.isEmpty() && data.readOctreeDataInfoFromData(_cachedJSONData)) {
             hasValidOctreeData = true;
             if (data.id.isNull()) {
                 qCDebug(octree) << "Current octree data has a null id, updating";
@@ -160,6 +199,11 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
         _tree->pruneTree();
+
+        if (_journal) {
+            // content from the domain server replaces what the journal was recording changes to
+            openJournal(replacementData.isNull());
+        }
     });
 
     _cachedJSONData.clear();
@@ -190,6 +234,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
+    _lastSnapshot = _lastPersistCheck;
 
     if (replacementData.isNull()) {
         sendLatestEntityDataToDS();
@@ -204,16 +249,24 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == OctreeBinaryFile::FILE_TYPE) {
         return "application/zip";
     }
     return "";
 }
 
+QString OctreePersistThread::getReplacementFilename() const {
+    // the domain server sends the JSON export of the tree, which replaces the binary file until the next persist
+    if (_persistAsFileType == OctreeBinaryFile::FILE_TYPE) {
+        return fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS) + ".json.gz";
+    }
+    return _filename;
+}
+
 void OctreePersistThread::replaceData(QByteArray data) {
     backupCurrentFile();
 
-    QFile currentFile { _filename };
+    QFile currentFile { getReplacementFilename() };
     if (currentFile.open(QIODevice::WriteOnly)) {
         currentFile.write(data);
         qDebug() << "Wrote replacement data";
@@ -258,12 +311,17 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
-    persist();
+    persist(true);
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (_persistAsFileType == OctreeBinaryFile::FILE_TYPE || _journal) {
+        // JSON stays the export format, and the persist file may not have the changes in the journal
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -301,8 +359,19 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
     qDebug() << "Found" << count << "backups";
 }
 
-void OctreePersistThread::persist() {
-    if (_tree->isDirty() && _initialLoadComplete) {
+void OctreePersistThread::persist(bool forceSnapshot) {
+    if ((_tree->isDirty() || _snapshotPending) && _initialLoadComplete) {
+
+        if (_journal) {
+            // the journal gets the changes at every persist, and a snapshot of the whole tree compacts it from time to
+            // time, so that the snapshot can fail without losing anything
+            appendToJournal();
+            bool snapshotDue = forceSnapshot || _snapshotPending || _journal->size() > MAX_OCTREE_JOURNAL_SIZE_BYTES ||
+                std::chrono::steady_clock::now() - _lastSnapshot > _snapshotInterval;
+            if (!snapshotDue) {
+                return;
+            }
+        }
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
@@ -310,11 +379,20 @@ void OctreePersistThread::persist() {
             qCDebug(octree) << "DONE pruning Octree before saving...";
         });
 
-        _tree->incrementPersistDataVersion();
+        if (!_journal) {
+            _tree->incrementPersistDataVersion();
+        }
 
         qCDebug(octree) << "Saving Octree data to:" << _filename;
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
-            _tree->clearDirtyBit(); // tree is clean after saving
+            if (_journal) {
+                // the changes since the journal entries were taken are left for the first entry of the new journal
+                _journal->reset(_tree->getPersistID(), _tree->getPersistDataVersion());
+                _lastSnapshot = std::chrono::steady_clock::now();
+                _snapshotPending = false;
+            } else {
+                _tree->clearDirtyBit(); // tree is clean after saving
+            }
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
@@ -324,6 +402,44 @@ void OctreePersistThread::persist() {
     }
 }
 
+bool OctreePersistThread::appendToJournal() {
+    // edits made while the changes are encoded make the tree dirty again, and are in the next entry
+    _tree->clearDirtyBit();
+    QByteArray changes;
+    if (!_tree->takeJournalChanges(changes)) {
+        return true;
+    }
+
+    _tree->incrementPersistDataVersion();
+    if (!_journal->append(_tree->getPersistDataVersion(), changes)) {
+        qCWarning(octree) << "Failed to journal Octree changes to" << _journal->getFilename();
+        _snapshotPending = true;
+        return false;
+    }
+    return true;
+}
+
+void OctreePersistThread::openJournal(bool replay) {
+    QUuid id = _tree->getPersistID();
+    int64_t dataVersion = _tree->getPersistDataVersion();
+    std::vector<OctreeJournal::Entry> entries;
+    if (replay && _journal->open(id, dataVersion, entries)) {
+        qCDebug(octree) << "Replaying" << (int)entries.size() << "entries from" << _journal->getFilename();
+        for (const OctreeJournal::Entry& entry : entries) {
+            if (!_tree->replayJournalChanges(entry.changes)) {
+                qCWarning(octree) << "Failed to replay journal entry for data version" << entry.dataVersion;
+                break;
+            }
+            _tree->setOctreeVersionInfo(id, entry.dataVersion);
+        }
+        // compact what was replayed at the first persist
+        _snapshotPending = !entries.empty();
+    } else {
+        _journal->reset(id, dataVersion);
+    }
+    _tree->setWantJournal(true);
+}
+
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
     auto nodeList = DependencyManager::get<NodeList>();
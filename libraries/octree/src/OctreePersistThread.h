@@ -14,9 +14,12 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <memory>
+
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeJournal.h"
 
 class OctreePersistThread : public QObject {
     Q_OBJECT
@@ -31,6 +34,7 @@ public:
     };
 
     static const std::chrono::seconds DEFAULT_PERSIST_INTERVAL;
+    static const std::chrono::seconds DEFAULT_SNAPSHOT_INTERVAL;
 
     OctreePersistThread(OctreePointer tree,
                         const QString& filename,
@@ -47,6 +51,10 @@ public:
 
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
+    /// appends the changes to a journal at each persist, and only writes the whole tree to the persist file this often,
+    /// call before the thread is started
+    void enableJournal(std::chrono::milliseconds snapshotInterval);
+
 public slots:
     void start();
 
@@ -58,10 +66,14 @@ protected slots:
     void handleOctreeDataFileReply(QSharedPointer<ReceivedMessage> message);
 
 protected:
-    void persist();
+    void persist(bool forceSnapshot = false);
+    bool appendToJournal();
+    void openJournal(bool replay);
+    int64_t getJournaledDataVersion(const QUuid& id, int64_t dataVersion) const;
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
+    QString getReplacementFilename() const;
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
 
@@ -79,6 +91,11 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    std::unique_ptr<OctreeJournal> _journal;
+    std::chrono::milliseconds _snapshotInterval;
+    std::chrono::steady_clock::time_point _lastSnapshot;
+    bool _snapshotPending { false };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -37,6 +37,19 @@ void OctreeProcessor::setTree(OctreePointer newTree) {
     _tree = newTree;
 }
 
+void OctreeProcessor::processCompressionDictionaryMessage(ReceivedMessage& message) {
+    auto dictionary = OctreeCompressionDictionary::create(message.readAll());
+    if (dictionary) {
+        qCDebug(octree) << "Received compression dictionary" << dictionary->getID() << "from" << message.getSenderSockAddr();
+        std::atomic_store(&_compressionDictionary, dictionary);
+    }
+}
+
+uint32_t OctreeProcessor::getCompressionDictionaryID() const {
+    auto dictionary = std::atomic_load(&_compressionDictionary);
+    return dictionary ? dictionary->getID() : 0;
+}
+
 void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointer sourceNode) {
     bool extraDebugging = false;
 
@@ -68,6 +81,8 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
 
         bool packetIsColored = oneAtBit(flags, PACKET_IS_COLOR_BIT);
         bool packetIsCompressed = oneAtBit(flags, PACKET_IS_COMPRESSED_BIT);
+        bool packetIsZstdCompressed = oneAtBit(flags, PACKET_IS_ZSTD_COMPRESSED_BIT);
+        auto compressionDictionary = std::atomic_load(&_compressionDictionary);
 
         OCTREE_PACKET_SENT_TIME arrivedAt = usecTimestampNow();
         qint64 clockSkew = sourceNode ? sourceNode->getClockSkewUsec() : 0;
@@ -124,6 +139,9 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
                     startUncompress = usecTimestampNow();
 
                     OctreePacketData packetData(packetIsCompressed);
+                    if (packetIsZstdCompressed) {
+                        packetData.setCompression(OctreePacketCompression::Zstd, compressionDictionary);
+                    }
                     packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
                         sectionLength);
                     if (extraDebugging) {
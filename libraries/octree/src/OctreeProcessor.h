@@ -39,6 +39,11 @@ public:
     /// process incoming data
     virtual void processDatagram(ReceivedMessage& message, SharedNodePointer sourceNode);
 
+    /// process the compression dictionary the server sent, which zstd packets are compressed with once our query has
+    /// its ID
+    void processCompressionDictionaryMessage(ReceivedMessage& message);
+    uint32_t getCompressionDictionaryID() const;
+
     /// initialize and GPU/rendering related resources
     virtual void init();
 
@@ -82,6 +87,8 @@ protected:
     int _entitiesInLastWindow = 0;
     std::atomic<OCTREE_PACKET_SEQUENCE> _lastOctreeMessageSequence;
 
+    OctreeCompressionDictionaryPointer _compressionDictionary;
+
 };
 
 #endif // hifi_OctreeProcessor_h
@@ -83,9 +83,14 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
 
     OctreeQueryFlags queryFlags { NoFlags };
     queryFlags |= (_reportInitialCompletion ? OctreeQuery::WantInitialCompletion : 0);
+    queryFlags |= (_wantZstdCompression ? OctreeQuery::WantZstdCompression : 0);
     memcpy(destinationBuffer, &queryFlags, sizeof(queryFlags));
     destinationBuffer += sizeof(queryFlags);
 
+    // the compression dictionary we have
+    memcpy(destinationBuffer, &_compressionDictionaryID, sizeof(_compressionDictionaryID));
+    destinationBuffer += sizeof(_compressionDictionaryID);
+
     return destinationBuffer - bufferStart;
 }
 
@@ -165,6 +170,10 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
     sourceBuffer += sizeof(queryFlags);
 
     _reportInitialCompletion = bool(queryFlags & OctreeQueryFlags::WantInitialCompletion);
+    _wantZstdCompression = bool(queryFlags & OctreeQueryFlags::WantZstdCompression);
+
+    memcpy(&_compressionDictionaryID, sourceBuffer, sizeof(_compressionDictionaryID));
+    sourceBuffer += sizeof(_compressionDictionaryID);
 
     return sourceBuffer - startPosition;
 }
@@ -56,6 +56,12 @@ public:
     bool wantReportInitialCompletion() const { return _reportInitialCompletion; }
     void setReportInitialCompletion(bool reportInitialCompletion) { _reportInitialCompletion = reportInitialCompletion; }
 
+    // Want packets compressed with zstd, and with the server's compression dictionary if it's the one with this ID.
+    bool wantZstdCompression() const { return _wantZstdCompression; }
+    void setWantZstdCompression(bool wantZstdCompression) { _wantZstdCompression = wantZstdCompression; }
+    uint32_t getCompressionDictionaryID() const { return _compressionDictionaryID; }
+    void setCompressionDictionaryID(uint32_t compressionDictionaryID) { _compressionDictionaryID = compressionDictionaryID; }
+
 signals:
     void incomingConnectionIDChanged();
 
@@ -78,11 +84,13 @@ protected:
     QJsonObject _jsonParameters;
     QReadWriteLock _jsonParametersLock;
     
-    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1 };
+    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1, WantZstdCompression = 0x2 };
     friend OctreeQuery::OctreeQueryFlags operator|=(OctreeQuery::OctreeQueryFlags& lhs, const int rhs);
 
     bool _hasReceivedFirstQuery { false };
     bool _reportInitialCompletion { false };
+    bool _wantZstdCompression { false };
+    uint32_t _compressionDictionaryID { 0 };
 };
 
 #endif // hifi_OctreeQuery_h
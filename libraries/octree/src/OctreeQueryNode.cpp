@@ -88,6 +88,21 @@ void OctreeQueryNode::init() {
 }
 
 
+void OctreeQueryNode::setCompressionSettings(bool allowZstdCompression,
+                                             const OctreeCompressionDictionaryPointer& dictionary) {
+    _allowZstdCompression = allowZstdCompression;
+    _compressionDictionary = dictionary;
+}
+
+bool OctreeQueryNode::shouldSendCompressionDictionary() {
+    if (_compressionDictionarySent || !_allowZstdCompression || !_compressionDictionary || !wantZstdCompression() ||
+        getCompressionDictionaryID() == _compressionDictionary->getID()) {
+        return false;
+    }
+    _compressionDictionarySent = true;
+    return true;
+}
+
 void OctreeQueryNode::resetOctreePacket() {
     // if shutting down, return immediately
     if (_isShuttingDown) {
@@ -107,6 +122,18 @@ void OctreeQueryNode::resetOctreePacket() {
     setAtBit(flags, PACKET_IS_COLOR_BIT); // always color
     setAtBit(flags, PACKET_IS_COMPRESSED_BIT); // always compressed
 
+    // every section of the packet is compressed the same way, with the dictionary only once the client has it
+    if (_allowZstdCompression && wantZstdCompression()) {
+        _packetCompression = OctreePacketCompression::Zstd;
+        bool clientHasDictionary = _compressionDictionary &&
+            getCompressionDictionaryID() == _compressionDictionary->getID();
+        _packetCompressionDictionary = clientHasDictionary ? _compressionDictionary : nullptr;
+        setAtBit(flags, PACKET_IS_ZSTD_COMPRESSED_BIT);
+    } else {
+        _packetCompression = OctreePacketCompression::Zlib;
+        _packetCompressionDictionary = nullptr;
+    }
+
     _octreePacket->reset();
 
     // pack in flags
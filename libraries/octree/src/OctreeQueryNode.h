@@ -86,6 +86,15 @@ public:
     bool shouldForceFullScene() const { return _shouldForceFullScene; }
     void setShouldForceFullScene(bool shouldForceFullScene) { _shouldForceFullScene = shouldForceFullScene; }
 
+    // whether the server allows zstd compression, and the dictionary it compresses with
+    void setCompressionSettings(bool allowZstdCompression, const OctreeCompressionDictionaryPointer& dictionary);
+    // returns true once, if the client asked for zstd and doesn't have the server's dictionary
+    bool shouldSendCompressionDictionary();
+
+    // the compression of the packet being written, picked from the client's last query when it's reset
+    OctreePacketCompression getPacketCompression() const { return _packetCompression; }
+    const OctreeCompressionDictionaryPointer& getPacketCompressionDictionary() const { return _packetCompressionDictionary; }
+
 private:
     bool _viewSent { false };
     std::unique_ptr<NLPacket> _octreePacket;
@@ -118,6 +127,12 @@ private:
     QJsonObject _lastCheckJSONParameters;
 
     bool _shouldForceFullScene { false };
+
+    bool _allowZstdCompression { false };
+    OctreeCompressionDictionaryPointer _compressionDictionary;
+    bool _compressionDictionarySent { false };
+    OctreePacketCompression _packetCompression { OctreePacketCompression::Zlib };
+    OctreeCompressionDictionaryPointer _packetCompressionDictionary;
 };
 
 #endif // hifi_OctreeQueryNode_h
@@ -0,0 +1,119 @@
+//
+//  MPSCRing.h
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 2019-06-14.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_MPSCRing_h
+#define hifi_MPSCRing_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Bounded, lock-free, multi-producer / single-consumer ring.
+//
+// Every slot carries a sequence number: producers claim a position with a CAS on the tail and publish
+// the slot by bumping its sequence, the consumer only ever looks at its own head. Values are moved in
+// and out of pre-allocated slots, so a push or pop never allocates.
+// Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class MPSCRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MPSCRing capacity must be a power of two");
+
+public:
+    MPSCRing() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // thread-safe, returns false (and leaves value untouched) if the ring is full
+    bool push(T&& value) {
+        size_t position = _tail.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Slot& slot = _slots[position & MASK];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+            if (difference == 0) {
+                if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+                // another producer claimed this position, position was reloaded by the CAS
+                _numContended.fetch_add(1, std::memory_order_relaxed);
+            } else if (difference < 0) {
+                // the consumer has not freed this slot yet
+                _numOverflows.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                // another producer got here first, catch up
+                _numContended.fetch_add(1, std::memory_order_relaxed);
+                position = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // consumer thread only, returns false if nothing has been published
+    bool pop(T& value) {
+        Slot& slot = _slots[_head & MASK];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (sequence != _head + 1) {
+            return false;
+        }
+
+        value = std::move(slot.value);
+        slot.value = T();
+        slot.sequence.store(_head + Capacity, std::memory_order_release);
+        ++_head;
+        return true;
+    }
+
+    // consumer thread only
+    bool empty() const { return _slots[_head & MASK].sequence.load(std::memory_order_acquire) != _head + 1; }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // number of producer CAS retries / full ring pushes since last sampled
+    uint32_t sampleNumContended() { return _numContended.exchange(0, std::memory_order_relaxed); }
+    uint32_t sampleNumOverflows() { return _numOverflows.exchange(0, std::memory_order_relaxed); }
+
+private:
+    static const size_t MASK = Capacity - 1;
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    Slot _slots[Capacity];
+
+    // keep the producer and consumer indices off each other's cache line
+    // (padding rather than alignas, the owners are heap allocated and we are still on C++14)
+    std::atomic<size_t> _tail { 0 };
+    char _tailPadding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    size_t _head { 0 };
+    char _headPadding[CACHE_LINE_SIZE - sizeof(size_t)];
+
+    std::atomic<uint32_t> _numContended { 0 };
+    std::atomic<uint32_t> _numOverflows { 0 };
+
+    // no copies
+    MPSCRing(const MPSCRing&) = delete;
+    MPSCRing& operator=(const MPSCRing&) = delete;
+};
+
+#endif // hifi_MPSCRing_h
@@ -51,6 +51,11 @@ extern "C" FILE * __cdecl __iob_func(void) {
 #include <cerrno>
 #endif
 
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include <QtCore/QDebug>
 #include <QDateTime>
 #include <QElapsedTimer>
@@ -1077,6 +1082,42 @@ void setMaxCores(uint8_t maxCores) {
 #endif
 }
 
+bool setCurrentThreadCore(int core) {
+#if defined(Q_OS_WIN)
+    DWORD_PTR processAffinity = 0, systemAffinity = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &processAffinity, &systemAffinity);
+
+    DWORD_PTR threadAffinity = processAffinity;
+    if (core >= 0) {
+        if (core >= (int)(sizeof(DWORD_PTR) * BITS_IN_BYTE)) {
+            return false;
+        }
+        DWORD_PTR coreMask = 1;
+        coreMask <<= core;
+        threadAffinity &= coreMask;
+    }
+    return threadAffinity != 0 && SetThreadAffinityMask(GetCurrentThread(), threadAffinity) != 0;
+#elif defined(Q_OS_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (core >= 0) {
+        if (core >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(core, &cpuSet);
+    } else {
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            CPU_SET(i, &cpuSet);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+    // macOS only has affinity hints between threads, not core pinning
+    Q_UNUSED(core);
+    return false;
+#endif
+}
+
 bool processIsRunning(int64_t pid) {
 #ifdef Q_OS_WIN
     HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
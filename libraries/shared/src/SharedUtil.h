@@ -225,6 +225,10 @@ const QString& getInterfaceSharedMemoryName();
 
 void setMaxCores(uint8_t maxCores);
 
+// pin the calling thread to a single core, or let it run on any core again if core is negative
+// returns false if the platform does not support it or the core is not available
+bool setCurrentThreadCore(int core);
+
 const QString PARENT_PID_OPTION = "parent-pid";
 void watchParentProcess(int parentPID);
 
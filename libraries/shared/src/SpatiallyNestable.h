@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -261,7 +263,7 @@ private:
     glm::vec3 _velocity;
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
-    bool _isDead { false };
+    std::atomic<bool> _isDead { false }; // read by entity server send threads without the tree lock
     bool _queryAACubeIsPuffed { false };
 
     void breakParentingLoop() const;
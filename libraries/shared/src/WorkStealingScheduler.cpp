@@ -0,0 +1,106 @@
+//
+//  WorkStealingScheduler.cpp
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 2019-06-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingScheduler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+void WorkStealingScheduler::setNumWorkers(int numWorkers) {
+    numWorkers = std::max(numWorkers, 1);
+    if (numWorkers != _numWorkers) {
+        _ranges.reset(new Range[numWorkers]);
+        _numWorkers = numWorkers;
+    }
+}
+
+void WorkStealingScheduler::prepare(const Costs& costs) {
+    assert(costs.size() <= std::numeric_limits<uint32_t>::max());
+    uint32_t numTasks = (uint32_t)costs.size();
+
+    auto costOf = [&](uint32_t task) { return (uint64_t)std::max(costs[task], (uint32_t)1); };
+
+    uint64_t totalCost = 0;
+    for (uint32_t task = 0; task < numTasks; ++task) {
+        totalCost += costOf(task);
+    }
+
+    uint32_t task = 0;
+    uint64_t cost = 0;
+    for (int worker = 0; worker < _numWorkers; ++worker) {
+        uint32_t rangeBegin = task;
+
+        // a task goes to the worker whose share covers the task's midpoint
+        uint64_t targetCost = (totalCost * (worker + 1)) / _numWorkers;
+        while (task < numTasks && cost + costOf(task) / 2 < targetCost) {
+            cost += costOf(task);
+            ++task;
+        }
+        if (worker == _numWorkers - 1) {
+            task = numTasks;
+        }
+
+        _ranges[worker].range.store(pack(rangeBegin, task), std::memory_order_relaxed);
+    }
+}
+
+void WorkStealingScheduler::prepare(size_t numTasks) {
+    assert(numTasks <= std::numeric_limits<uint32_t>::max());
+
+    for (int worker = 0; worker < _numWorkers; ++worker) {
+        uint32_t rangeBegin = (uint32_t)((numTasks * worker) / _numWorkers);
+        uint32_t rangeEnd = (uint32_t)((numTasks * (worker + 1)) / _numWorkers);
+        _ranges[worker].range.store(pack(rangeBegin, rangeEnd), std::memory_order_relaxed);
+    }
+}
+
+bool WorkStealingScheduler::next(int worker, size_t& task) {
+    assert(worker >= 0 && worker < _numWorkers);
+    auto& ownRange = _ranges[worker].range;
+
+    uint64_t range = ownRange.load(std::memory_order_acquire);
+    while (begin(range) < end(range)) {
+        if (ownRange.compare_exchange_weak(range, pack(begin(range) + 1, end(range)),
+                                           std::memory_order_acq_rel, std::memory_order_acquire)) {
+            task = begin(range);
+            return true;
+        }
+    }
+
+    return steal(worker, task);
+}
+
+bool WorkStealingScheduler::steal(int worker, size_t& task) {
+    for (int i = 1; i < _numWorkers; ++i) {
+        auto& victimRange = _ranges[(worker + i) % _numWorkers].range;
+
+        uint64_t range = victimRange.load(std::memory_order_acquire);
+        while (begin(range) < end(range)) {
+            uint32_t rangeBegin = begin(range);
+            uint32_t rangeEnd = end(range);
+            uint32_t middle = rangeBegin + (rangeEnd - rangeBegin) / 2;
+
+            if (victimRange.compare_exchange_weak(range, pack(rangeBegin, middle),
+                                                  std::memory_order_acq_rel, std::memory_order_acquire)) {
+                // run the first stolen task now, and leave the rest where other workers can steal it in turn
+                // (our own range is empty, so nobody can be racing us for it)
+                _ranges[worker].range.store(pack(middle + 1, rangeEnd), std::memory_order_release);
+                _numSteals.fetch_add(1, std::memory_order_relaxed);
+
+                task = middle;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
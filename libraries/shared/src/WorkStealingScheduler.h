@@ -0,0 +1,72 @@
+//
+//  WorkStealingScheduler.h
+//  libraries/shared/src
+//
+//  Created by High Fidelity on 2019-06-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_WorkStealingScheduler_h
+#define hifi_WorkStealingScheduler_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Hands out the task indices [0, numTasks) of a job to a fixed set of workers.
+//
+// Each worker starts on a contiguous range whose total (estimated) cost is about 1/numWorkers of the job,
+// so that a few expensive tasks do not all land on the same worker. A worker takes tasks from the front of
+// its own range, and once it runs dry it steals the back half of another worker's range.
+// Ranges are a single packed atomic, so taking and stealing are both one CAS.
+//
+// prepare() must not overlap with next(), the caller is expected to synchronize the start of each job.
+class WorkStealingScheduler {
+public:
+    using Costs = std::vector<uint32_t>;
+
+    WorkStealingScheduler(int numWorkers = 1) { setNumWorkers(numWorkers); }
+
+    // not thread-safe, must not be called while a job is running
+    void setNumWorkers(int numWorkers);
+    int getNumWorkers() const { return _numWorkers; }
+
+    // split the tasks between the workers, weighted by their estimated cost (a cost of 0 counts as 1)
+    void prepare(const Costs& costs);
+    // split the tasks between the workers evenly
+    void prepare(size_t numTasks);
+
+    // thread-safe, returns false once there is nothing left for this worker to run or steal
+    bool next(int worker, size_t& task);
+
+    // number of successful steals since last sampled
+    uint32_t sampleNumSteals() { return _numSteals.exchange(0, std::memory_order_relaxed); }
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    // [begin, end) packed as begin << 32 | end
+    struct Range {
+        std::atomic<uint64_t> range { 0 };
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)];
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) { return ((uint64_t)begin << 32) | end; }
+    static uint32_t begin(uint64_t range) { return (uint32_t)(range >> 32); }
+    static uint32_t end(uint64_t range) { return (uint32_t)range; }
+
+    bool steal(int worker, size_t& task);
+
+    std::unique_ptr<Range[]> _ranges;
+    int _numWorkers { 0 };
+
+    std::atomic<uint32_t> _numSteals { 0 };
+};
+
+#endif // hifi_WorkStealingScheduler_h
@@ -0,0 +1,189 @@
+//
+//  AudioMixTests.cpp
+//  tests/audio/src
+//
+//  Created by High Fidelity on 2019-06-12.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixTests.h"
+
+#include <cmath>
+#include <iostream>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioLimiter.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(AudioMixTests)
+
+namespace {
+    const int FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const int SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+
+    void fillRandom(int16_t* samples, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            samples[i] = (int16_t)(randIntInRange(AudioConstants::MIN_SAMPLE_VALUE, AudioConstants::MAX_SAMPLE_VALUE));
+        }
+    }
+}
+
+void AudioMixTests::mixMonoTest() {
+    int16_t input[FRAMES];
+    fillRandom(input, FRAMES);
+
+    float output[SAMPLES];
+    for (int i = 0; i < SAMPLES; ++i) {
+        output[i] = 0.25f;
+    }
+
+    // from the reset state there is no gain crossfade
+    const float GAIN = 0.5f;
+    AudioHRTF hrtf;
+    hrtf.mixMono(input, output, GAIN, FRAMES);
+
+    for (int i = 0; i < FRAMES; ++i) {
+        float expected = 0.25f + input[i] * (GAIN / 32768.0f);
+        QCOMPARE(output[2 * i + 0], expected);
+        QCOMPARE(output[2 * i + 1], expected);
+    }
+}
+
+void AudioMixTests::mixStereoTest() {
+    int16_t input[SAMPLES];
+    fillRandom(input, SAMPLES);
+
+    float output[SAMPLES] = {};
+
+    const float GAIN = 0.75f;
+    AudioHRTF hrtf;
+    hrtf.mixStereo(input, output, GAIN, FRAMES);
+
+    for (int i = 0; i < SAMPLES; ++i) {
+        QCOMPARE(output[i], input[i] * (GAIN / 32768.0f));
+    }
+
+    // a second block crossfades from the old gain to the new one, and must end on the new gain
+    const float NEW_GAIN = 0.25f;
+    memset(output, 0, sizeof(output));
+    hrtf.mixStereo(input, output, NEW_GAIN, FRAMES);
+
+    const float EPSILON = 1.0e-6f;
+    QVERIFY(fabsf(output[SAMPLES - 1] - input[SAMPLES - 1] * (NEW_GAIN / 32768.0f)) < EPSILON);
+}
+
+void AudioMixTests::limiterTest() {
+    // a quiet sine wave is passed through (delayed, with makeup gain and dither)
+    const float AMPLITUDE = 0.1f;
+    const float FREQUENCY = 1000.0f;
+
+    // odd sized blocks exercise the non-SIMD tail
+    const int BLOCK_SIZES[] = { FRAMES, 1, 7, 129 };
+
+    for (int numFrames : BLOCK_SIZES) {
+        AudioLimiter limiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+
+        std::vector<float> input(2 * numFrames);
+        std::vector<int16_t> output(2 * numFrames);
+
+        int maxSample = 0;
+        int frame = 0;
+        for (int block = 0; block < 4 * FRAMES / numFrames + 4; ++block) {
+            for (int i = 0; i < numFrames; ++i, ++frame) {
+                float x = AMPLITUDE * sinf(TWO_PI * FREQUENCY * frame / AudioConstants::SAMPLE_RATE);
+                input[2 * i + 0] = x;
+                input[2 * i + 1] = -x;
+            }
+
+            limiter.render(input.data(), output.data(), numFrames);
+
+            for (int i = 0; i < numFrames; ++i) {
+                // channels are equal and opposite, apart from the shared dither
+                QVERIFY(abs(output[2 * i + 0] + output[2 * i + 1]) <= 3);
+                maxSample = std::max(maxSample, abs((int)output[2 * i + 0]));
+            }
+        }
+
+        // below threshold, the limiter should not be attenuating
+        QVERIFY(maxSample > (int)(0.9f * AMPLITUDE * 32768.0f));
+        QVERIFY(maxSample < (int)(1.1f * AMPLITUDE * 32768.0f));
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void AudioMixTests::mixBenchmark() {
+    const int NUM_LISTENERS = 100;
+    const int NUM_STREAMS = 100;
+    const int NUM_FRAMES = 100;
+    const int HRTF_DATASET_INDEX = 1;
+
+    // like the mixer, each listener has its own HRTF state per stream
+    std::vector<AudioHRTF> hrtfs(NUM_LISTENERS * NUM_STREAMS);
+    std::vector<AudioLimiter*> limiters;
+    for (int i = 0; i < NUM_LISTENERS; ++i) {
+        limiters.push_back(new AudioLimiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO));
+    }
+
+    std::vector<int16_t> streams(NUM_STREAMS * SAMPLES);
+    fillRandom(streams.data(), (int)streams.size());
+
+    float mixSamples[SAMPLES];
+    int16_t outputSamples[SAMPLES];
+
+    // one pass per mix path: spatialized mono, direct mono (echo), direct stereo
+    const char* PATH_NAMES[] = { "hrtf render", "mixMono", "mixStereo" };
+
+    for (int path = 0; path < 3; ++path) {
+        uint64_t mixUsecs = 0;
+        uint64_t limitUsecs = 0;
+
+        for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+            for (int listener = 0; listener < NUM_LISTENERS; ++listener) {
+                uint64_t startTime = usecTimestampNow();
+
+                memset(mixSamples, 0, sizeof(mixSamples));
+
+                for (int stream = 0; stream < NUM_STREAMS; ++stream) {
+                    AudioHRTF& hrtf = hrtfs[listener * NUM_STREAMS + stream];
+                    int16_t* input = &streams[stream * SAMPLES];
+                    float gain = 0.5f + 0.5f * (frame & 1);
+
+                    if (path == 0) {
+                        float azimuth = (TWO_PI * (listener + stream)) / NUM_STREAMS - PI;
+                        float distance = 1.0f + (stream % 10);
+                        hrtf.render(input, mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain, FRAMES);
+                    } else if (path == 1) {
+                        hrtf.mixMono(input, mixSamples, gain, FRAMES);
+                    } else {
+                        hrtf.mixStereo(input, mixSamples, gain, FRAMES);
+                    }
+                }
+
+                uint64_t mixTime = usecTimestampNow();
+                limiters[listener]->render(mixSamples, outputSamples, FRAMES);
+
+                limitUsecs += usecTimestampNow() - mixTime;
+                mixUsecs += mixTime - startTime;
+            }
+        }
+
+        // one thread's share of the frame; AudioMixer::throttle targets a fraction of NETWORK_FRAME_USECS
+        uint64_t usecsPerFrame = (mixUsecs + limitUsecs) / NUM_FRAMES;
+        std::cout << PATH_NAMES[path] << ": " << NUM_LISTENERS << " listeners x " << NUM_STREAMS << " streams = "
+            << usecsPerFrame << " usecs/frame (mix " << mixUsecs / NUM_FRAMES << ", limiter " << limitUsecs / NUM_FRAMES
+            << "), " << (100 * usecsPerFrame) / AudioConstants::NETWORK_FRAME_USECS << "% of a "
+            << AudioConstants::NETWORK_FRAME_USECS << " usec frame on one thread" << std::endl;
+    }
+
+    for (auto limiter : limiters) {
+        delete limiter;
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,39 @@
+//
+//  AudioMixTests.h
+//  tests/audio/src
+//
+//  Created by High Fidelity on 2019-06-12.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixTests_h
+#define hifi_AudioMixTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class AudioMixTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the non-spatialized mono mix matches the scalar reference
+    void mixMonoTest();
+
+    // Test that the non-spatialized stereo mix matches the scalar reference
+    void mixStereoTest();
+
+    // Test that the stereo limiter output tracks its input when below threshold, for any block size
+    void limiterTest();
+
+#ifdef MANUAL_TEST
+    // Time one audio mixer frame of 100 listeners x 100 streams against the frame budget
+    void mixBenchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_AudioMixTests_h
@@ -0,0 +1,189 @@
+//
+//  AvatarJointDeltasTests.cpp
+//  tests/avatars/src
+//
+//  Created by High Fidelity on 2019-06-18.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarJointDeltasTests.h"
+
+#include <vector>
+
+#include <AvatarJointDeltas.h>
+
+QTEST_MAIN(AvatarJointDeltasTests)
+
+using namespace AvatarJointDeltas;
+
+namespace {
+    const int NUM_JOINTS = 60;
+    const int BUFFER_SIZE = 4096;
+    const float MIN_ROTATION_DOT = 0.99999f;
+    const float MAX_TRANSLATION_ERROR = 0.0001f;
+
+    // a skeleton whose joints all move a little as time goes on
+    QVector<JointData> makeJoints(float time) {
+        QVector<JointData> joints;
+        joints.resize(NUM_JOINTS);
+        for (int i = 0; i < NUM_JOINTS; ++i) {
+            float angle = 0.1f * i + 0.002f * time;
+            joints[i].rotation = glm::normalize(glm::quat(cosf(angle), sinf(angle), 0.5f * sinf(2.0f * angle), 0.25f));
+            joints[i].translation = glm::vec3(0.01f * i, 0.1f + 0.001f * time, -0.02f * i);
+            joints[i].rotationIsDefaultPose = false;
+            joints[i].translationIsDefaultPose = (i % 5) != 0;
+        }
+        return joints;
+    }
+
+    bool matches(const Frame& frame, const QVector<JointData>& joints) {
+        if ((int)frame.size() != joints.size()) {
+            return false;
+        }
+        for (int i = 0; i < joints.size(); ++i) {
+            if (!frame[i].hasRotation || fabsf(glm::dot(dequantizeRotation(frame[i]), joints[i].rotation)) < MIN_ROTATION_DOT) {
+                return false;
+            }
+            if (!joints[i].translationIsDefaultPose &&
+                (!frame[i].hasTranslation ||
+                 glm::distance(dequantizeTranslation(frame[i]), joints[i].translation) > MAX_TRANSLATION_ERROR)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // one avatar streamed from the mixer to one listener
+    struct Stream {
+        AckWindow acks;
+        FrameHistory sentFrames;
+        FrameHistory receivedFrames;
+        PacketID nextPacketID { 0 };
+        std::vector<unsigned char> buffer = std::vector<unsigned char>(BUFFER_SIZE);
+
+        int send(const QVector<JointData>& joints) {
+            SendState sendState;
+            sendState.packetID = nextPacketID++;
+            sendState.acks = &acks;
+            sendState.sentFrames = &sentFrames;
+            return encode(joints, sendState, false, 1.0f, 0.0f, buffer.data(), BUFFER_SIZE);
+        }
+
+        const Frame* receive(int size) {
+            PacketID packetID;
+            const Frame* frame;
+            if (decode(buffer.data(), size, receivedFrames, packetID, frame) != size) {
+                return nullptr;
+            }
+            acks.ack(packetID);
+            return frame;
+        }
+    };
+}
+
+// Test that rotations survive quantization, including when the dropped component is kept by hysteresis
+void AvatarJointDeltasTests::rotationQuantizationTest() {
+    for (int i = 0; i < 1000; ++i) {
+        float angle = 0.01f * i;
+        glm::quat rotation = glm::normalize(glm::quat(cosf(angle), sinf(3.0f * angle), cosf(5.0f * angle), sinf(angle)));
+
+        QuantizedJoint joint;
+        quantizeRotation(rotation, -1, joint);
+        QVERIFY(fabsf(glm::dot(dequantizeRotation(joint), rotation)) >= MIN_ROTATION_DOT);
+
+        QuantizedJoint preferred;
+        quantizeRotation(rotation, (joint.largestComponent + 1) % 4, preferred);
+        QVERIFY(fabsf(glm::dot(dequantizeRotation(preferred), rotation)) >= MIN_ROTATION_DOT);
+    }
+}
+
+// Test that a listener with no baseline gets every joint, absolute
+void AvatarJointDeltasTests::keyframeTest() {
+    Stream stream;
+    QVector<JointData> joints = makeJoints(0.0f);
+
+    int size = stream.send(joints);
+    QVERIFY(size > 0);
+    QCOMPARE((int)stream.buffer[3], 0);
+
+    const Frame* frame = stream.receive(size);
+    QVERIFY(frame != nullptr);
+    QVERIFY(matches(*frame, joints));
+}
+
+// Test that once a frame is acked the next one is coded against it, and is smaller
+void AvatarJointDeltasTests::deltaTest() {
+    Stream stream;
+
+    int keyframeSize = stream.send(makeJoints(0.0f));
+    QVERIFY(stream.receive(keyframeSize) != nullptr);
+
+    for (int i = 1; i < 100; ++i) {
+        QVector<JointData> joints = makeJoints((float)i);
+        int size = stream.send(joints);
+        QVERIFY(size > 0 && size < keyframeSize / 2);
+        QCOMPARE((int)stream.buffer[3], 1);
+
+        const Frame* frame = stream.receive(size);
+        QVERIFY(frame != nullptr);
+        QVERIFY(matches(*frame, joints));
+    }
+
+    // nothing moved, nothing but the header and bits is sent
+    QVector<JointData> joints = makeJoints(99.0f);
+    int size = stream.send(joints);
+    QCOMPARE(size, HEADER_SIZE + 2 * ((NUM_JOINTS + 7) / 8));
+    QVERIFY(stream.receive(size) != nullptr);
+}
+
+// Test that lost packets fall back to an older acked baseline, then to a keyframe
+void AvatarJointDeltasTests::lossTest() {
+    Stream stream;
+
+    int size = stream.send(makeJoints(0.0f));
+    QVERIFY(stream.receive(size) != nullptr);
+
+    // lose a few packets, the next one is still coded against the first
+    for (int i = 1; i <= 3; ++i) {
+        stream.send(makeJoints((float)i));
+    }
+    QVector<JointData> joints = makeJoints(4.0f);
+    size = stream.send(joints);
+    QCOMPARE((int)stream.buffer[3], 4);
+    const Frame* frame = stream.receive(size);
+    QVERIFY(frame != nullptr);
+    QVERIFY(matches(*frame, joints));
+
+    // lose everything until the acked frames are too old to be a baseline
+    for (int i = 0; i < MAX_BASELINE_AGE + 1; ++i) {
+        stream.send(makeJoints(5.0f + i));
+    }
+    joints = makeJoints(100.0f);
+    size = stream.send(joints);
+    QCOMPARE((int)stream.buffer[3], 0);
+    frame = stream.receive(size);
+    QVERIFY(frame != nullptr);
+    QVERIFY(matches(*frame, joints));
+}
+
+// Test that truncated sections are rejected, and that a delta whose baseline is unknown is read but not applied
+void AvatarJointDeltasTests::malformedTest() {
+    Stream stream;
+
+    int size = stream.send(makeJoints(0.0f));
+    QVERIFY(stream.receive(size) != nullptr);
+    size = stream.send(makeJoints(1.0f));
+
+    PacketID packetID;
+    const Frame* frame;
+    for (int truncated = 0; truncated < size; ++truncated) {
+        QCOMPARE(decode(stream.buffer.data(), truncated, stream.receivedFrames, packetID, frame), -1);
+    }
+
+    FrameHistory emptyHistory;
+    QCOMPARE(decode(stream.buffer.data(), size, emptyHistory, packetID, frame), size);
+    QVERIFY(frame == nullptr);
+}
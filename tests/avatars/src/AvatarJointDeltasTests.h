@@ -0,0 +1,28 @@
+//
+//  AvatarJointDeltasTests.h
+//  tests/avatars/src
+//
+//  Created by High Fidelity on 2019-06-18.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarJointDeltasTests_h
+#define hifi_AvatarJointDeltasTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarJointDeltasTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void rotationQuantizationTest();
+    void keyframeTest();
+    void deltaTest();
+    void lossTest();
+    void malformedTest();
+};
+
+#endif // hifi_AvatarJointDeltasTests_h
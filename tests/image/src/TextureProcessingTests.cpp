@@ -0,0 +1,368 @@
+//
+//  TextureProcessingTests.cpp
+//  tests/image/src
+//
+//  Created by High Fidelity on 2019-06-29.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingTests.h"
+
+#include <random>
+#include <vector>
+
+#include <glm/gtc/packing.hpp>
+
+#include <image/Image.h>
+#include <image/TextureProcessing.h>
+
+QTEST_GUILESS_MAIN(TextureProcessingTests)
+
+Q_DECLARE_METATYPE(gpu::BackendTarget)
+
+namespace {
+    // the 4K and 8K inputs are 2:1, the shape of the equirectangular skies that go through the HDR paths
+    const int WIDTH_4K = 4096;
+    const int HEIGHT_4K = 2048;
+    const int WIDTH_8K = 8192;
+    const int HEIGHT_8K = 4096;
+
+    std::vector<glm::vec4> makeFloatPixels(int count) {
+        std::mt19937 generator(count);
+        // HDR values, with some too small or too big for the packed formats
+        std::uniform_real_distribution<float> value(0.0f, 100.0f);
+        std::uniform_int_distribution<int> special(0, 15);
+        std::vector<glm::vec4> pixels(count);
+        for (auto& pixel : pixels) {
+            pixel = glm::vec4(value(generator), value(generator), value(generator), 1.0f);
+            switch (special(generator)) {
+                case 0:
+                    pixel.r = 1.0e-6f;
+                    break;
+                case 1:
+                    pixel.g = 1.0e6f;
+                    break;
+                case 2:
+                    pixel.b = 0.0f;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return pixels;
+    }
+
+    // RGBA halves, as OpenEXR reads them
+    std::vector<uint16_t> makeHalfPixels(const std::vector<glm::vec4>& pixels) {
+        std::vector<uint16_t> halves;
+        halves.reserve(pixels.size() * 4);
+        for (const auto& pixel : pixels) {
+            for (int channel = 0; channel < 4; channel++) {
+                halves.push_back(glm::packHalf1x16(pixel[channel]));
+            }
+        }
+        return halves;
+    }
+
+    image::Image makeColorImage(int width, int height) {
+        QImage qImage(width, height, QImage::Format_ARGB32);
+        std::mt19937 generator(width * height);
+        for (int y = 0; y < height; y++) {
+            QRgb* line = reinterpret_cast<QRgb*>(qImage.scanLine(y));
+            for (int x = 0; x < width; x++) {
+                line[x] = (QRgb)generator();
+            }
+        }
+        return image::Image(qImage);
+    }
+}
+
+// Test that the packed conversions give the same pixels as packing and unpacking them one at a time with glm
+void TextureProcessingTests::packingMatchesGlmTest() {
+    const int width = 67;
+    const int height = 31;
+    // padded lines, to check the strides
+    const int srcLinePixelStride = width + 5;
+    const int packedLinePixelStride = width + 3;
+    auto pixels = makeFloatPixels(srcLinePixelStride * height);
+    std::vector<uint32_t> packed(packedLinePixelStride * height);
+    std::vector<glm::vec4> unpacked(srcLinePixelStride * height);
+    unsigned char* packedBytes = reinterpret_cast<unsigned char*>(packed.data());
+    const size_t packedLineByteStride = packedLinePixelStride * sizeof(uint32_t);
+
+    image::convertToPackedFromFloat(packedBytes, width, height, packedLineByteStride, gpu::Element::COLOR_R11G11B10,
+                                    pixels.data(), srcLinePixelStride);
+    image::convertToFloatFromPacked(packedBytes, width, height, packedLineByteStride, gpu::Element::COLOR_R11G11B10,
+                                    unpacked.data(), srcLinePixelStride);
+    auto packFunc = image::getHDRPackingFunction();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint32_t packedPixel = packed[y * packedLinePixelStride + x];
+            QCOMPARE(packedPixel, packFunc(glm::vec3(pixels[y * srcLinePixelStride + x])));
+            QVERIFY(unpacked[y * srcLinePixelStride + x] == glm::vec4(glm::unpackF2x11_1x10(packedPixel), 1.0f));
+        }
+    }
+
+    image::convertToPackedFromFloat(packedBytes, width, height, packedLineByteStride, gpu::Element::COLOR_RGB9E5,
+                                    pixels.data(), srcLinePixelStride);
+    image::convertToFloatFromPacked(packedBytes, width, height, packedLineByteStride, gpu::Element::COLOR_RGB9E5,
+                                    unpacked.data(), srcLinePixelStride);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint32_t packedPixel = packed[y * packedLinePixelStride + x];
+            QCOMPARE(packedPixel, glm::packF3x9_E1x5(glm::vec3(pixels[y * srcLinePixelStride + x])));
+            QVERIFY(unpacked[y * srcLinePixelStride + x] == glm::vec4(glm::unpackF3x9_E1x5(packedPixel), 1.0f));
+        }
+    }
+
+    auto halves = makeHalfPixels(pixels);
+    image::convertToHDRFromHalfFloat(packedBytes, width, height, packedLineByteStride, halves.data(), srcLinePixelStride);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const uint16_t* half = &halves[(y * srcLinePixelStride + x) * 4];
+            glm::vec3 color(glm::unpackHalf1x16(half[0]), glm::unpackHalf1x16(half[1]), glm::unpackHalf1x16(half[2]));
+            QCOMPARE(packed[y * packedLinePixelStride + x], packFunc(color));
+        }
+    }
+}
+
+// Test that converting between 8 bit and packed float images gives the same pixels as converting them one at a time
+void TextureProcessingTests::colorConversionTest() {
+    const int width = 23;
+    const int height = 11;
+    const float MAX_COLOR_VALUE = 255.0f;
+    const image::Image source = makeColorImage(width, height);
+
+    image::Image packed = source.getConvertedToFormat(image::Image::Format_PACKED_FLOAT);
+    image::Image color = packed.getConvertedToFormat(image::Image::Format_ARGB32);
+    auto packFunc = image::getHDRPackingFunction();
+    auto unpackFunc = image::getHDRUnpackingFunction();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            QRgb sourcePixel = source.getPackedPixel(x, y);
+            uint32_t packedPixel = reinterpret_cast<const uint32_t*>(packed.getScanLine(y))[x];
+            QCOMPARE(packedPixel, packFunc(glm::vec3(qRed(sourcePixel), qGreen(sourcePixel), qBlue(sourcePixel)) / MAX_COLOR_VALUE));
+
+            auto expected = glm::clamp(unpackFunc(packedPixel) * MAX_COLOR_VALUE, 0.0f, MAX_COLOR_VALUE);
+            QCOMPARE(color.getPackedPixel(x, y), qRgb((int)expected.r, (int)expected.g, (int)expected.b));
+        }
+    }
+}
+
+// Test that the gamma corrected conversions between 8 bit and HDR images give the same pixels as converting them one at a time
+void TextureProcessingTests::gammaConversionTest() {
+    const int width = 29;
+    const int height = 13;
+    const float MAX_COLOR_VALUE = 255.0f;
+    const float GAMMA = 2.2f;
+    const image::Image source = makeColorImage(width, height);
+
+    image::Image hdr = image::convertToHDRFormat(image::Image(source), gpu::Element::COLOR_R11G11B10);
+    image::Image ldr = image::convertToLDRFormat(image::Image(hdr), image::Image::Format_ARGB32);
+    auto packFunc = image::getHDRPackingFunction();
+    auto unpackFunc = image::getHDRUnpackingFunction();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            QRgb sourcePixel = source.getPackedPixel(x, y);
+            glm::vec3 linear = glm::vec3(qRed(sourcePixel), qGreen(sourcePixel), qBlue(sourcePixel)) / MAX_COLOR_VALUE;
+            linear = glm::vec3(std::pow(linear.r, GAMMA), std::pow(linear.g, GAMMA), std::pow(linear.b, GAMMA));
+            uint32_t hdrPixel = reinterpret_cast<const uint32_t*>(hdr.getScanLine(y))[x];
+            QCOMPARE(hdrPixel, packFunc(linear));
+
+            glm::vec3 color = unpackFunc(hdrPixel);
+            color = glm::vec3(std::pow(color.r, 1.0f / GAMMA), std::pow(color.g, 1.0f / GAMMA), std::pow(color.b, 1.0f / GAMMA));
+            color = glm::min(color, 1.0f) * MAX_COLOR_VALUE;
+            QCOMPARE(ldr.getPackedPixel(x, y), qRgb((int)color.r, (int)color.g, (int)color.b));
+        }
+    }
+}
+
+// Test that each channel is moved to red, with the other channels cleared and alpha opaque
+void TextureProcessingTests::mapToRedChannelTest() {
+    const int width = 19;
+    const int height = 7;
+    const image::Image source = makeColorImage(width, height);
+
+    const std::vector<std::pair<image::ColorChannel, int(*)(QRgb)>> channels {
+        { image::ColorChannel::RED, qRed },
+        { image::ColorChannel::GREEN, qGreen },
+        { image::ColorChannel::BLUE, qBlue },
+        { image::ColorChannel::ALPHA, qAlpha }
+    };
+    for (const auto& channel : channels) {
+        image::Image mapped = source;
+        image::mapToRedChannel(mapped, channel.first);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                QCOMPARE(mapped.getPackedPixel(x, y), qRgba(channel.second(source.getPackedPixel(x, y)), 0, 0, 255));
+            }
+        }
+    }
+}
+
+// Test that an image over the size limit by a power of two is box filtered down, without transparent pixels bleeding
+void TextureProcessingTests::halvedSourceImageTest() {
+    const int width = WIDTH_8K;
+    const int height = 256;
+    QImage qImage(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(qImage.scanLine(y));
+        for (int x = 0; x < width; x++) {
+            // one color for each 2x2 block
+            line[x] = qRgba((x / 2) % 256, (y / 2) % 256, 64, 255);
+        }
+    }
+    // a block with a transparent top
+    qImage.setPixel(0, 0, qRgba(255, 0, 0, 0));
+    qImage.setPixel(1, 0, qRgba(255, 0, 0, 0));
+    qImage.setPixel(0, 1, qRgba(0, 0, 255, 255));
+    qImage.setPixel(1, 1, qRgba(0, 0, 255, 255));
+
+    image::Image processed = image::processSourceImage(image::Image(qImage), false, gpu::BackendTarget::GL45);
+
+    QCOMPARE(processed.getWidth(), (glm::uint32)(width / 2));
+    QCOMPARE(processed.getHeight(), (glm::uint32)(height / 2));
+    QCOMPARE(processed.getPackedPixel(0, 0), qRgba(0, 0, 255, 128));
+    for (int y = 0; y < height / 2; y += 13) {
+        for (int x = 1; x < width / 2; x += 97) {
+            QCOMPARE(processed.getPackedPixel(x, y), qRgba(x % 256, y % 256, 64, 255));
+        }
+    }
+}
+
+void TextureProcessingTests::conversionBenchmark_data() {
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<bool>("pack");
+
+    QTest::newRow("4K, to R11G11B10") << WIDTH_4K << HEIGHT_4K << true;
+    QTest::newRow("8K, to R11G11B10") << WIDTH_8K << HEIGHT_8K << true;
+    QTest::newRow("4K, from R11G11B10") << WIDTH_4K << HEIGHT_4K << false;
+    QTest::newRow("8K, from R11G11B10") << WIDTH_8K << HEIGHT_8K << false;
+}
+
+// Benchmark converting 4K and 8K images between floats and R11G11B10
+void TextureProcessingTests::conversionBenchmark() {
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(bool, pack);
+
+    auto pixels = makeFloatPixels(width * height);
+    std::vector<uint32_t> packed(width * height);
+    unsigned char* packedBytes = reinterpret_cast<unsigned char*>(packed.data());
+    const size_t packedLineByteStride = width * sizeof(uint32_t);
+    image::convertToPackedFromFloat(packedBytes, width, height, packedLineByteStride, gpu::Element::COLOR_R11G11B10,
+                                    pixels.data(), width);
+
+    QBENCHMARK {
+        if (pack) {
+            image::convertToPackedFromFloat(packedBytes, width, height, packedLineByteStride, gpu::Element::COLOR_R11G11B10,
+                                            pixels.data(), width);
+        } else {
+            image::convertToFloatFromPacked(packedBytes, width, height, packedLineByteStride, gpu::Element::COLOR_R11G11B10,
+                                            pixels.data(), width);
+        }
+    }
+}
+
+void TextureProcessingTests::gammaConversionBenchmark_data() {
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<bool>("toHDR");
+
+    QTest::newRow("4K, to HDR") << WIDTH_4K << HEIGHT_4K << true;
+    QTest::newRow("8K, to HDR") << WIDTH_8K << HEIGHT_8K << true;
+    QTest::newRow("4K, to LDR") << WIDTH_4K << HEIGHT_4K << false;
+    QTest::newRow("8K, to LDR") << WIDTH_8K << HEIGHT_8K << false;
+}
+
+// Benchmark the gamma corrected conversions of 4K and 8K images, which cube maps go through when the target
+// format differs from the source
+void TextureProcessingTests::gammaConversionBenchmark() {
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(bool, toHDR);
+
+    const image::Image source = makeColorImage(width, height);
+    const image::Image hdr = image::convertToHDRFormat(image::Image(source), gpu::Element::COLOR_R11G11B10);
+
+    QBENCHMARK {
+        // shallow copies, the conversions write to new images
+        if (toHDR) {
+            image::convertToHDRFormat(image::Image(source), gpu::Element::COLOR_R11G11B10);
+        } else {
+            image::convertToLDRFormat(image::Image(hdr), image::Image::Format_ARGB32);
+        }
+    }
+}
+
+void TextureProcessingTests::halfFloatConversionBenchmark_data() {
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    QTest::newRow("4K") << WIDTH_4K << HEIGHT_4K;
+    QTest::newRow("8K") << WIDTH_8K << HEIGHT_8K;
+}
+
+// Benchmark packing 4K and 8K images of half floats, as OpenEXR files are read
+void TextureProcessingTests::halfFloatConversionBenchmark() {
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    auto halves = makeHalfPixels(makeFloatPixels(width * height));
+    std::vector<uint32_t> packed(width * height);
+    unsigned char* packedBytes = reinterpret_cast<unsigned char*>(packed.data());
+
+    QBENCHMARK {
+        image::convertToHDRFromHalfFloat(packedBytes, width, height, width * sizeof(uint32_t), halves.data(), width);
+    }
+}
+
+void TextureProcessingTests::mapToRedChannelBenchmark_data() {
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    QTest::newRow("4K") << WIDTH_4K << HEIGHT_4K;
+    QTest::newRow("8K") << WIDTH_8K << HEIGHT_8K;
+}
+
+// Benchmark moving the green channel of 4K and 8K images to red
+void TextureProcessingTests::mapToRedChannelBenchmark() {
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    image::Image image = makeColorImage(width, height);
+
+    // mapped in place, the work is the same whatever the pixels already are
+    QBENCHMARK {
+        image::mapToRedChannel(image, image::ColorChannel::GREEN);
+    }
+}
+
+void TextureProcessingTests::processSourceImageBenchmark_data() {
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<gpu::BackendTarget>("target");
+
+    QTest::newRow("4K, GLES") << WIDTH_4K << HEIGHT_4K << gpu::BackendTarget::GLES32;
+    QTest::newRow("8K, GL") << WIDTH_8K << HEIGHT_8K << gpu::BackendTarget::GL45;
+    QTest::newRow("8K, GLES") << WIDTH_8K << HEIGHT_8K << gpu::BackendTarget::GLES32;
+}
+
+// Benchmark bringing 4K and 8K images down to the texture size limit of the target
+void TextureProcessingTests::processSourceImageBenchmark() {
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(gpu::BackendTarget, target);
+
+    const image::Image source = makeColorImage(width, height);
+
+    QBENCHMARK {
+        // a shallow copy, the source image is only read
+        image::Image image = source;
+        image = image::processSourceImage(std::move(image), false, target);
+    }
+}
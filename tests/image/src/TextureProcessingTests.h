@@ -0,0 +1,38 @@
+//
+//  TextureProcessingTests.h
+//  tests/image/src
+//
+//  Created by High Fidelity on 2019-06-29.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureProcessingTests_h
+#define hifi_TextureProcessingTests_h
+
+#include <QtTest/QtTest>
+
+class TextureProcessingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void packingMatchesGlmTest();
+    void colorConversionTest();
+    void gammaConversionTest();
+    void mapToRedChannelTest();
+    void halvedSourceImageTest();
+    void conversionBenchmark_data();
+    void conversionBenchmark();
+    void gammaConversionBenchmark_data();
+    void gammaConversionBenchmark();
+    void halfFloatConversionBenchmark_data();
+    void halfFloatConversionBenchmark();
+    void mapToRedChannelBenchmark_data();
+    void mapToRedChannelBenchmark();
+    void processSourceImageBenchmark_data();
+    void processSourceImageBenchmark();
+};
+
+#endif // hifi_TextureProcessingTests_h
@@ -0,0 +1,181 @@
+//
+//  PacketBufferPoolTests.cpp
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-06-03.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPoolTests.h"
+
+#include <iostream>
+
+#include <QtNetwork/QUdpSocket>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <udt/Packet.h>
+#include <udt/PacketBufferPool.h>
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#endif
+
+QTEST_MAIN(PacketBufferPoolTests)
+
+using namespace udt;
+
+void PacketBufferPoolTests::recycleTest() {
+    auto& pool = PacketBufferPool::getInstance();
+
+    auto buffer = pool.acquire();
+    QVERIFY(buffer.get() != nullptr);
+    QVERIFY(buffer.get_deleter().isPooled);
+
+    memset(buffer.get(), 0, PacketBufferPool::BUFFER_SIZE);
+    char* rawBuffer = buffer.get();
+    auto numFree = pool.getNumFreeBuffers();
+
+    {
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), Packet::totalHeaderSize(), HifiSockAddr());
+        QCOMPARE(packet->getData(), rawBuffer);
+        QCOMPARE(pool.getNumFreeBuffers(), numFree);
+    }
+
+    // the packet is gone, its buffer should be the next one handed out
+    QCOMPARE(pool.getNumFreeBuffers(), numFree + 1);
+
+    auto recycled = pool.acquire();
+    QCOMPARE(recycled.get(), rawBuffer);
+    QCOMPARE(pool.getNumFreeBuffers(), numFree);
+}
+
+void PacketBufferPoolTests::unpooledBufferTest() {
+    auto& pool = PacketBufferPool::getInstance();
+    auto numFree = pool.getNumFreeBuffers();
+
+    {
+        auto size = Packet::totalHeaderSize();
+        auto data = std::unique_ptr<char[]>(new char[size]());
+        auto packet = Packet::fromReceivedPacket(std::move(data), size, HifiSockAddr());
+        QCOMPARE(packet->getDataSize(), (qint64)size);
+    }
+
+    QCOMPARE(pool.getNumFreeBuffers(), numFree);
+}
+
+void PacketBufferPoolTests::copyTest() {
+    auto& pool = PacketBufferPool::getInstance();
+
+    auto buffer = pool.acquire();
+    memset(buffer.get(), 0, PacketBufferPool::BUFFER_SIZE);
+    const char PAYLOAD[] = "pooled";
+    memcpy(buffer.get() + Packet::totalHeaderSize(), PAYLOAD, sizeof(PAYLOAD));
+
+    auto packet = Packet::fromReceivedPacket(std::move(buffer), Packet::totalHeaderSize() + sizeof(PAYLOAD),
+                                             HifiSockAddr());
+    auto copy = Packet::createCopy(*packet);
+    QVERIFY(copy->getData() != packet->getData());
+    QCOMPARE(copy->getPayloadSize(), packet->getPayloadSize());
+    QCOMPARE(memcmp(copy->getPayload(), PAYLOAD, sizeof(PAYLOAD)), 0);
+
+    auto numFree = pool.getNumFreeBuffers();
+    copy.reset();
+    QCOMPARE(pool.getNumFreeBuffers(), numFree);
+    packet.reset();
+    QCOMPARE(pool.getNumFreeBuffers(), numFree + 1);
+}
+
+#ifdef MANUAL_TEST
+
+namespace {
+    const int NUM_DATAGRAMS_PER_ROUND = 512;
+    const int NUM_ROUNDS = 200;
+    const int DATAGRAM_SIZE = 1200;
+
+    void sendRound(QUdpSocket& sender, quint16 port) {
+        static const QByteArray datagram(DATAGRAM_SIZE, '\0');
+        for (int i = 0; i < NUM_DATAGRAMS_PER_ROUND; ++i) {
+            sender.writeDatagram(datagram, QHostAddress::LocalHost, port);
+        }
+    }
+}
+
+void PacketBufferPoolTests::receiveBenchmark() {
+    QUdpSocket sender;
+    sender.bind(QHostAddress::LocalHost, 0);
+
+    QUdpSocket receiver;
+    receiver.bind(QHostAddress::LocalHost, 0);
+    receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 4 * 1024 * 1024);
+
+    // current path: one readDatagram and one heap allocation per packet
+    uint64_t numReceived = 0;
+    uint64_t usecs = 0;
+    for (int round = 0; round < NUM_ROUNDS; ++round) {
+        sendRound(sender, receiver.localPort());
+        receiver.waitForReadyRead(100);
+
+        uint64_t startTime = usecTimestampNow();
+        while (receiver.hasPendingDatagrams()) {
+            auto size = receiver.pendingDatagramSize();
+            auto buffer = std::unique_ptr<char[]>(new char[size]);
+            HifiSockAddr senderSockAddr;
+            receiver.readDatagram(buffer.get(), size, senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
+            auto packet = Packet::fromReceivedPacket(std::move(buffer), size, senderSockAddr);
+            ++numReceived;
+        }
+        usecs += usecTimestampNow() - startTime;
+    }
+    std::cout << "readDatagram: " << numReceived << " packets in " << usecs << " usecs = "
+        << (numReceived * USECS_PER_SECOND) / std::max(usecs, (uint64_t)1) << " packets/sec" << std::endl;
+
+#ifdef Q_OS_LINUX
+    // batched path: recvmmsg into pooled buffers
+    const int BATCH_SIZE = 32;
+    auto& pool = PacketBufferPool::getInstance();
+    PacketBuffer buffers[BATCH_SIZE];
+    mmsghdr messages[BATCH_SIZE];
+    iovec ioVectors[BATCH_SIZE];
+    sockaddr_storage senderAddresses[BATCH_SIZE];
+
+    numReceived = 0;
+    usecs = 0;
+    for (int round = 0; round < NUM_ROUNDS; ++round) {
+        sendRound(sender, receiver.localPort());
+        receiver.waitForReadyRead(100);
+
+        uint64_t startTime = usecTimestampNow();
+        int batchReceived = BATCH_SIZE;
+        while (batchReceived == BATCH_SIZE) {
+            for (int i = 0; i < BATCH_SIZE; ++i) {
+                if (!buffers[i]) {
+                    buffers[i] = pool.acquire();
+                }
+                ioVectors[i].iov_base = buffers[i].get();
+                ioVectors[i].iov_len = PacketBufferPool::BUFFER_SIZE;
+                memset(&messages[i], 0, sizeof(mmsghdr));
+                messages[i].msg_hdr.msg_name = &senderAddresses[i];
+                messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                messages[i].msg_hdr.msg_iov = &ioVectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            batchReceived = recvmmsg(receiver.socketDescriptor(), messages, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+            for (int i = 0; i < batchReceived; ++i) {
+                HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
+                auto packet = Packet::fromReceivedPacket(std::move(buffers[i]), messages[i].msg_len, senderSockAddr);
+                ++numReceived;
+            }
+        }
+        usecs += usecTimestampNow() - startTime;
+    }
+    std::cout << "recvmmsg + pool: " << numReceived << " packets in " << usecs << " usecs = "
+        << (numReceived * USECS_PER_SECOND) / std::max(usecs, (uint64_t)1) << " packets/sec" << std::endl;
+#endif
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,39 @@
+//
+//  PacketBufferPoolTests.h
+//  tests/networking/src
+//
+//  Created by High Fidelity on 2019-06-03.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketBufferPoolTests_h
+#define hifi_PacketBufferPoolTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class PacketBufferPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that buffers handed to packets come back to the pool
+    void recycleTest();
+
+    // Test that heap allocated buffers are never put in the pool
+    void unpooledBufferTest();
+
+    // Test that a packet copied from a pooled packet owns its own memory
+    void copyTest();
+
+#ifdef MANUAL_TEST
+    // Compare packets/sec of the per-datagram receive path against the batched, pooled path
+    void receiveBenchmark();
+#endif // MANUAL_TEST
+};
+
+#endif // hifi_PacketBufferPoolTests_h
@@ -0,0 +1,608 @@
+//
+//  EntityEncodingTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-06-26.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodingTests.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <random>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTreeElement.h>
+#include <EntityTypes.h>
+#include <GLMHelpers.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <OctreePacketData.h>
+
+QTEST_MAIN(EntityEncodingTests)
+
+// every allocation made by this test is counted, so that the benchmark can report allocations per entity
+static std::atomic<uint64_t> allocationCount { 0 };
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = malloc(size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    free(pointer);
+}
+
+namespace {
+    const int BENCHMARK_ENTITIES = 100;
+    const int FUZZ_ITERATIONS = 2000;
+    // large enough for any entity the tests make, so that entity data is never cut short where a server would carry
+    // the rest over to its next packet
+    const int ENTITY_DATA_SIZE = 64 * 1024;
+
+    enum Operation {
+        EncodeEditPacket,
+        DecodeEditPacket,
+        AppendEntityData,
+        ReadEntityData,
+        NUM_OPERATIONS
+    };
+
+    const char* OPERATION_NAMES[NUM_OPERATIONS] = {
+        "encodeEntityEditPacket",
+        "decodeEntityEditPacket",
+        "appendEntityData",
+        "readEntityDataFromBuffer"
+    };
+
+    QVector<glm::vec3> makePoints(int numPoints, float scale) {
+        QVector<glm::vec3> points;
+        for (int i = 0; i < numPoints; ++i) {
+            points.push_back(scale * glm::vec3(cosf(0.1f * i), 0.01f * i, sinf(0.1f * i)));
+        }
+        return points;
+    }
+
+    // properties like the ones of entities in a typical domain, for each type
+    EntityItemProperties makeProperties(EntityTypes::EntityType type, int index) {
+        const int NUM_LINE_POINTS = 20;
+        const int NUM_POLY_LINE_POINTS = 50;
+
+        EntityItemProperties properties;
+        properties.setType(type);
+        properties.setName(QString("%1 %2").arg(EntityTypes::getEntityTypeName(type)).arg(index));
+        properties.setPosition(glm::vec3(0.5f * index, 1.5f, -0.25f * index));
+        properties.setDimensions(glm::vec3(1.0f, 2.0f, 0.5f));
+        properties.setRotation(glm::angleAxis(0.1f * index, Vectors::UNIT_Y));
+        properties.setUserData(QString("{\"grabbableKey\":{\"grabbable\":true},\"index\":%1}").arg(index));
+        properties.setScript("https://cdn.example.com/scripts/doorOpener.js");
+        properties.setCreated(usecTimestampNow());
+        properties.setLastEdited(usecTimestampNow());
+
+        switch (type) {
+            case EntityTypes::Shape:
+                properties.setShape("Cylinder");
+                // fall through
+            case EntityTypes::Box:
+            case EntityTypes::Sphere:
+                properties.setColor(glm::u8vec3(200, 100, 50));
+                properties.setAlpha(0.8f);
+                break;
+            case EntityTypes::Model:
+                properties.setModelURL("https://cdn.example.com/models/building-tower-03.fbx");
+                properties.setTextures("{\"tex.diffuse\":\"https://cdn.example.com/textures/brick.jpg\"}");
+                properties.getAnimation().setURL("https://cdn.example.com/animations/idle.fbx");
+                properties.getAnimation().setFPS(30.0f);
+                properties.getAnimation().setRunning(true);
+                break;
+            case EntityTypes::Text:
+                properties.setText("Welcome to the gallery, please take a look around");
+                properties.setLineHeight(0.1f);
+                properties.setTextColor(glm::u8vec3(255, 255, 255));
+                properties.setBackgroundColor(glm::u8vec3(0, 0, 0));
+                break;
+            case EntityTypes::Image:
+                properties.setImageURL("https://cdn.example.com/images/poster.png");
+                properties.setEmissive(true);
+                break;
+            case EntityTypes::Web:
+                properties.setSourceUrl("https://example.com/events");
+                properties.setDPI(30);
+                properties.setScriptURL("https://cdn.example.com/scripts/webEvents.js");
+                break;
+            case EntityTypes::ParticleEffect:
+                properties.setTextures("https://cdn.example.com/textures/spark.png");
+                properties.setMaxParticles(1000);
+                properties.setEmitRate(50.0f);
+                properties.setLifespan(3.0f);
+                properties.setColorStart(glm::vec3(255.0f, 200.0f, 0.0f));
+                properties.setColorFinish(glm::vec3(255.0f, 0.0f, 0.0f));
+                break;
+            case EntityTypes::Line:
+                properties.setLinePoints(makePoints(NUM_LINE_POINTS, 0.5f));
+                properties.setColor(glm::u8vec3(0, 255, 0));
+                break;
+            case EntityTypes::PolyLine: {
+                QVector<glm::vec3> points = makePoints(NUM_POLY_LINE_POINTS, 0.5f);
+                properties.setLinePoints(points);
+                properties.setNormals(QVector<glm::vec3>(points.size(), Vectors::UNIT_Y));
+                properties.setStrokeWidths(QVector<float>(points.size(), 0.02f));
+                properties.setStrokeColors(QVector<glm::vec3>(points.size(), glm::vec3(1.0f, 0.5f, 0.0f)));
+                properties.setTextures("https://cdn.example.com/textures/stroke.png");
+                break;
+            }
+            case EntityTypes::PolyVox:
+                properties.setVoxelVolumeSize(glm::vec3(16.0f));
+                properties.setVoxelData(qCompress(QByteArray(16 * 16 * 16, 1)));
+                properties.setXTextureURL("https://cdn.example.com/textures/grass.png");
+                break;
+            case EntityTypes::Grid:
+                properties.setMajorGridEvery(5);
+                properties.setMinorGridEvery(0.5f);
+                properties.setColor(glm::u8vec3(128, 128, 128));
+                break;
+            case EntityTypes::Gizmo:
+                properties.setGizmoType(GizmoType::RING);
+                properties.getRing().setInnerRadius(0.5f);
+                break;
+            case EntityTypes::Light:
+                properties.setIsSpotlight(true);
+                properties.setIntensity(5.0f);
+                properties.setFalloffRadius(2.0f);
+                properties.setColor(glm::u8vec3(255, 240, 200));
+                break;
+            case EntityTypes::Zone:
+                properties.setKeyLightMode((uint32_t)COMPONENT_MODE_ENABLED);
+                properties.getKeyLight().setIntensity(2.0f);
+                properties.setSkyboxMode((uint32_t)COMPONENT_MODE_ENABLED);
+                properties.getSkybox().setURL("https://cdn.example.com/skyboxes/sunset.jpg");
+                break;
+            case EntityTypes::Material:
+                properties.setMaterialURL("materialData");
+                properties.setMaterialData("{\"materials\":{\"albedo\":[0.5,0.5,0.5],\"roughness\":0.8,"
+                                           "\"albedoMap\":\"https://cdn.example.com/textures/wood.jpg\"}}");
+                properties.setParentMaterialName("0");
+                break;
+            default:
+                break;
+        }
+        return properties;
+    }
+
+    template <typename Generator>
+    QString randomString(Generator& generator) {
+        const QString CHARACTERS = QString::fromUtf8("abcdefghijklmnopqrstuvwxyz0123456789 :/.{}\"é漢");
+        std::uniform_int_distribution<int> length(0, 200);
+        std::uniform_int_distribution<int> character(0, CHARACTERS.size() - 1);
+        QString string;
+        for (int i = length(generator); i > 0; --i) {
+            string += CHARACTERS[character(generator)];
+        }
+        return string;
+    }
+
+    template <typename Generator>
+    glm::vec3 randomVec3(Generator& generator) {
+        std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+        return glm::vec3(value(generator), value(generator), value(generator));
+    }
+
+    template <typename Generator>
+    glm::quat randomQuat(Generator& generator) {
+        std::uniform_real_distribution<float> angle(0.0f, TWO_PI);
+        return glm::angleAxis(angle(generator), glm::normalize(randomVec3(generator) + glm::vec3(0.0f, 0.0f, 1000.0f)));
+    }
+
+    template <typename Generator>
+    QVector<glm::vec3> randomPoints(Generator& generator) {
+        std::uniform_int_distribution<int> numPoints(0, 20);
+        QVector<glm::vec3> points;
+        for (int i = numPoints(generator); i > 0; --i) {
+            points.push_back(0.01f * randomVec3(generator));
+        }
+        return points;
+    }
+
+    using PropertySetter = std::function<void(EntityItemProperties&, std::mt19937&)>;
+
+    // each sets one property, or group of properties that go together, to a random value
+    const std::vector<PropertySetter>& getPropertySetters() {
+        static const std::vector<PropertySetter> setters = {
+            [](EntityItemProperties& p, std::mt19937& g) { p.setName(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setUserData(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setHref(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setDescription(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setPosition(randomVec3(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setDimensions(glm::abs(randomVec3(g)) + glm::vec3(0.1f)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setRotation(randomQuat(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setRegistrationPoint(0.005f * randomVec3(g) + glm::vec3(0.5f)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setVisible(g() % 2); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setLocked(g() % 2); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setParentID(QUuid::createUuid()); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setVelocity(randomVec3(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setGravity(randomVec3(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setDamping(0.01f * (g() % 100)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setLifetime(0.5f * (g() % 1000)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setCollisionless(g() % 2); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setCollisionMask((uint16_t)(g() % 256)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setDynamic(g() % 2); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setCollisionSoundURL(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setScript(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setServerScripts(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setColor(glm::u8vec3(g() % 256, g() % 256, g() % 256)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setAlpha(0.01f * (g() % 100)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setShape((g() % 2) ? "Cylinder" : "Cone"); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setTextures(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setModelURL(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) {
+                p.getAnimation().setURL(randomString(g));
+                p.getAnimation().setFPS((float)(g() % 60));
+                p.getAnimation().setRunning(g() % 2);
+            },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setText(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setLineHeight(0.01f * (g() % 100)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setTextColor(glm::u8vec3(g() % 256, g() % 256, g() % 256)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setImageURL(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setEmissive(g() % 2); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setSourceUrl(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setDPI((uint16_t)(1 + g() % 100)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setMaxParticles((quint32)(g() % 10000)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setEmitRate((float)(g() % 1000)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setEmitOrientation(randomQuat(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setLinePoints(randomPoints(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) {
+                QVector<glm::vec3> points = randomPoints(g);
+                p.setLinePoints(points);
+                p.setNormals(QVector<glm::vec3>(points.size(), Vectors::UNIT_Y));
+                p.setStrokeWidths(QVector<float>(points.size(), 0.01f * (g() % 10)));
+            },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setVoxelVolumeSize(glm::vec3((float)(1 + g() % 32))); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setVoxelData(randomString(g).toUtf8()); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setXTextureURL(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setIsSpotlight(g() % 2); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setIntensity(0.1f * (g() % 100)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setFalloffRadius(0.1f * (g() % 100)); },
+            [](EntityItemProperties& p, std::mt19937& g) {
+                p.setKeyLightMode((uint32_t)COMPONENT_MODE_ENABLED);
+                p.getKeyLight().setIntensity(0.1f * (g() % 100));
+            },
+            [](EntityItemProperties& p, std::mt19937& g) { p.getSkybox().setURL(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setMaterialURL(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setMaterialData(randomString(g)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setPriority((quint16)(g() % 10)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setMajorGridEvery((uint32_t)(1 + g() % 10)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.setMinorGridEvery(0.1f * (1 + g() % 10)); },
+            [](EntityItemProperties& p, std::mt19937& g) { p.getRing().setInnerRadius(0.01f * (g() % 100)); }
+        };
+        return setters;
+    }
+
+    EntityItemProperties makeRandomProperties(std::mt19937& generator) {
+        EntityItemProperties properties;
+        properties.setType((EntityTypes::EntityType)(1 + generator() % (EntityTypes::NUM_TYPES - 1)));
+        properties.setLastEdited(usecTimestampNow());
+        for (const PropertySetter& setter : getPropertySetters()) {
+            const int ONE_IN = 4;
+            if (generator() % ONE_IN == 0) {
+                setter(properties, generator);
+            }
+        }
+        return properties;
+    }
+
+    // encodes edit packets into one buffer, sized the way EntityEditPacketSender sizes the one of an entity add
+    class EditPacketEncoder {
+    public:
+        OctreeElement::AppendState encode(const EntityItemID& id, const EntityItemProperties& properties) {
+            // the encoding shrinks the buffer to the packet, growing it back keeps its allocation
+            _buffer.resize(NLPacket::maxPayloadSize(PacketType::EntityAdd) * 10);
+            EntityPropertyFlags didntFitProperties;
+            return EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, id, properties, _buffer,
+                                                                properties.getChangedProperties(), didntFitProperties);
+        }
+        const QByteArray& getPacket() const { return _buffer; }
+
+    private:
+        QByteArray _buffer;
+    };
+
+    // appends entity data to one packet data that is reset for each entity
+    class EntityDataEncoder {
+    public:
+        OctreeElement::AppendState append(const EntityItemPointer& entity) {
+            _packetData.reset();
+            return entity->appendEntityData(&_packetData, _params, _extraEncodeData);
+        }
+        int getSize() { return _packetData.getUncompressedSize(); }
+        QByteArray getData() { return QByteArray((const char*)_packetData.getUncompressedData(), getSize()); }
+
+    private:
+        OctreePacketData _packetData { false, ENTITY_DATA_SIZE };
+        EncodeBitstreamParams _params;
+        EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
+    };
+
+    bool isCloseTo(const glm::quat& a, const glm::quat& b) {
+        const float MIN_DOT = 0.999f;
+        return fabsf(glm::dot(a, b)) > MIN_DOT;
+    }
+}
+
+void EntityEncodingTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+}
+
+// Test that random properties of random types come back the same from an edit packet, and that entities read back all
+// of the data they were encoded to
+void EntityEncodingTests::roundTripFuzzTest() {
+    EditPacketEncoder editPacketEncoder;
+    EntityDataEncoder entityDataEncoder;
+    std::mt19937 generator(FUZZ_ITERATIONS);
+    for (int i = 0; i < FUZZ_ITERATIONS; ++i) {
+        EntityItemID id(QUuid::createUuid());
+        EntityItemProperties properties = makeRandomProperties(generator);
+
+        // edit packets, every property has to fit for the decoded ones to be compared
+        QCOMPARE((int)editPacketEncoder.encode(id, properties), (int)OctreeElement::COMPLETED);
+        QByteArray editPacket = editPacketEncoder.getPacket();
+        QVERIFY(!editPacket.isEmpty());
+        int processedBytes = 0;
+        EntityItemID decodedID;
+        EntityItemProperties decoded;
+        QVERIFY(EntityItemProperties::decodeEntityEditPacket((const unsigned char*)editPacket.constData(),
+                                                             editPacket.size(), processedBytes, decodedID, decoded));
+        QCOMPARE(processedBytes, editPacket.size());
+        QCOMPARE(decodedID, id);
+        QCOMPARE(decoded.getType(), properties.getType());
+
+        // rotations are packed to a few bits, and don't come back exactly, so they're checked and then put back
+        if (decoded.rotationChanged()) {
+            QVERIFY(isCloseTo(decoded.getRotation(), properties.getRotation()));
+            decoded.setRotation(properties.getRotation());
+        }
+        if (decoded.emitOrientationChanged()) {
+            QVERIFY(isCloseTo(decoded.getEmitOrientation(), properties.getEmitOrientation()));
+            decoded.setEmitOrientation(properties.getEmitOrientation());
+        }
+        QCOMPARE((int)editPacketEncoder.encode(decodedID, decoded), (int)OctreeElement::COMPLETED);
+        QCOMPARE(editPacketEncoder.getPacket(), editPacket);
+
+        // entity data
+        EntityItemPointer entity = EntityTypes::constructEntityItem(properties.getType(), id, properties);
+        QVERIFY(entity);
+        QCOMPARE((int)entityDataEncoder.append(entity), (int)OctreeElement::COMPLETED);
+        QByteArray entityData = entityDataEncoder.getData();
+        QVERIFY(!entityData.isEmpty());
+        EntityItemPointer readEntity = EntityTypes::constructEntityItem((const unsigned char*)entityData.constData(),
+                                                                         entityData.size());
+        QVERIFY(readEntity);
+        ReadBitstreamToTreeParams args;
+        int bytesRead = readEntity->readEntityDataFromBuffer((const unsigned char*)entityData.constData(),
+                                                             entityData.size(), args);
+        QCOMPARE(bytesRead, entityData.size());
+        QCOMPARE(readEntity->getEntityItemID(), id);
+        QCOMPARE(readEntity->getType(), entity->getType());
+        QCOMPARE(readEntity->getName(), entity->getName());
+        QCOMPARE(readEntity->getUserData(), entity->getUserData());
+        QCOMPARE(readEntity->getParentID(), entity->getParentID());
+    }
+}
+
+// Test that edits read straight into an entity leave it the same as edits decoded to properties and then set on it,
+// and that only edits of the properties that can be read that way are
+void EntityEncodingTests::streamedEditTest() {
+    const std::vector<PropertySetter> streamedSetters = {
+        [](EntityItemProperties& p, std::mt19937& g) { p.setVisible(g() % 2); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setName(randomString(g)); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setUserData(randomString(g)); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setPrivateUserData(randomString(g)); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setHref(randomString(g)); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setDescription(randomString(g)); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setLastEditedBy(QUuid::createUuid()); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setCanCastShadow(g() % 2); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setRenderLayer((RenderLayer)(g() % 3)); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setPrimitiveMode((PrimitiveMode)(g() % 2)); },
+        [](EntityItemProperties& p, std::mt19937& g) { p.setIgnorePickIntersection(g() % 2); }
+    };
+
+    EditPacketEncoder editPacketEncoder;
+    EntityDataEncoder entityDataEncoder;
+    std::mt19937 generator(FUZZ_ITERATIONS);
+    for (int i = 0; i < FUZZ_ITERATIONS; ++i) {
+        EntityTypes::EntityType type = (EntityTypes::EntityType)(1 + generator() % (EntityTypes::NUM_TYPES - 1));
+        EntityItemID id(QUuid::createUuid());
+        EntityItemProperties properties;
+        properties.setLastEdited(usecTimestampNow());
+        while (properties.getChangedProperties().isEmpty()) {
+            for (const PropertySetter& setter : streamedSetters) {
+                const int ONE_IN = 3;
+                if (generator() % ONE_IN == 0) {
+                    setter(properties, generator);
+                }
+            }
+        }
+        QCOMPARE((int)editPacketEncoder.encode(id, properties), (int)OctreeElement::COMPLETED);
+        QByteArray editPacket = editPacketEncoder.getPacket();
+        const unsigned char* data = (const unsigned char*)editPacket.constData();
+
+        EntityItemPointer decodedEntity = EntityTypes::constructEntityItem(type, id, makeProperties(type, i));
+        QVERIFY(decodedEntity);
+        int processedBytes = 0;
+        EntityItemID decodedID;
+        EntityItemProperties decoded;
+        QVERIFY(EntityItemProperties::decodeEntityEditPacket(data, editPacket.size(), processedBytes, decodedID, decoded));
+        decodedEntity->setProperties(decoded);
+
+        EntityItemPointer streamedEntity = EntityTypes::constructEntityItem(type, id, makeProperties(type, i));
+        int headerBytes = 0;
+        EntityItemID streamedID;
+        EntityTypes::EntityType streamedType;
+        quint64 lastEdited;
+        EntityPropertyFlags propertyFlags;
+        QVERIFY(EntityItemProperties::decodeEntityEditPacketHeader(data, editPacket.size(), headerBytes, streamedID,
+                                                                   streamedType, lastEdited, propertyFlags));
+        QCOMPARE(streamedID, id);
+        QCOMPARE(lastEdited, properties.getLastEdited());
+        QVERIFY(EntityItem::canReadEditFromBuffer(propertyFlags));
+        int bytesRead = streamedEntity->readEditFromBuffer(data + headerBytes, editPacket.size() - headerBytes,
+                                                           propertyFlags);
+        QCOMPARE(headerBytes + bytesRead, processedBytes);
+
+        QCOMPARE(streamedEntity->getVisible(), decodedEntity->getVisible());
+        QCOMPARE(streamedEntity->getName(), decodedEntity->getName());
+        QCOMPARE(streamedEntity->getUserData(), decodedEntity->getUserData());
+        QCOMPARE(streamedEntity->getPrivateUserData(), decodedEntity->getPrivateUserData());
+        QCOMPARE(streamedEntity->getHref(), decodedEntity->getHref());
+        QCOMPARE(streamedEntity->getDescription(), decodedEntity->getDescription());
+        QCOMPARE(streamedEntity->getLastEditedBy(), decodedEntity->getLastEditedBy());
+        QCOMPARE(streamedEntity->getCanCastShadow(), decodedEntity->getCanCastShadow());
+        QCOMPARE((int)streamedEntity->getRenderLayer(), (int)decodedEntity->getRenderLayer());
+        QCOMPARE((int)streamedEntity->getPrimitiveMode(), (int)decodedEntity->getPrimitiveMode());
+        QCOMPARE(streamedEntity->getIgnorePickIntersection(), decodedEntity->getIgnorePickIntersection());
+        QCOMPARE((int)entityDataEncoder.append(streamedEntity), (int)OctreeElement::COMPLETED);
+        int streamedSize = entityDataEncoder.getSize();
+        QCOMPARE((int)entityDataEncoder.append(decodedEntity), (int)OctreeElement::COMPLETED);
+        QCOMPARE(streamedSize, entityDataEncoder.getSize());
+    }
+
+    // anything that can move the entity needs the full decode
+    EntityItemProperties moved;
+    moved.setName("moved");
+    moved.setPosition(glm::vec3(1.0f));
+    editPacketEncoder.encode(EntityItemID(QUuid::createUuid()), moved);
+    QByteArray editPacket = editPacketEncoder.getPacket();
+    int headerBytes = 0;
+    EntityItemID id;
+    EntityTypes::EntityType type;
+    quint64 lastEdited;
+    EntityPropertyFlags propertyFlags;
+    QVERIFY(EntityItemProperties::decodeEntityEditPacketHeader((const unsigned char*)editPacket.constData(),
+                                                               editPacket.size(), headerBytes, id, type, lastEdited,
+                                                               propertyFlags));
+    QVERIFY(!EntityItem::canReadEditFromBuffer(propertyFlags));
+}
+
+void EntityEncodingTests::encodingBenchmark_data() {
+    QTest::addColumn<int>("type");
+    QTest::addColumn<int>("operation");
+
+    for (int type = EntityTypes::Unknown + 1; type < EntityTypes::NUM_TYPES; ++type) {
+        for (int operation = 0; operation < NUM_OPERATIONS; ++operation) {
+            QString name = EntityTypes::getEntityTypeName((EntityTypes::EntityType)type) + ", " + OPERATION_NAMES[operation];
+            QTest::newRow(name.toUtf8().constData()) << type << operation;
+        }
+    }
+}
+
+// Benchmark encoding and decoding 100 entities of each type, as edit packets and as the entity data servers send, and
+// report the time, bytes and allocations each entity takes
+void EntityEncodingTests::encodingBenchmark() {
+    QFETCH(int, type);
+    QFETCH(int, operation);
+
+    QVector<EntityItemID> ids;
+    QVector<EntityItemProperties> properties;
+    QVector<EntityItemPointer> entities;
+    QVector<QByteArray> editPackets;
+    QVector<QByteArray> entityData;
+    // one buffer each, made before the timed passes, as the senders keep theirs
+    EditPacketEncoder editPacketEncoder;
+    EntityDataEncoder entityDataEncoder;
+    for (int i = 0; i < BENCHMARK_ENTITIES; ++i) {
+        EntityItemID id(QUuid::createUuid());
+        ids.push_back(id);
+        properties.push_back(makeProperties((EntityTypes::EntityType)type, i));
+        entities.push_back(EntityTypes::constructEntityItem((EntityTypes::EntityType)type, id, properties.back()));
+        QVERIFY(entities.back());
+        QCOMPARE((int)editPacketEncoder.encode(id, properties.back()), (int)OctreeElement::COMPLETED);
+        editPackets.push_back(editPacketEncoder.getPacket());
+        QCOMPARE((int)entityDataEncoder.append(entities.back()), (int)OctreeElement::COMPLETED);
+        entityData.push_back(entityDataEncoder.getData());
+    }
+
+    int numBytes = 0;
+    auto run = [&] {
+        numBytes = 0;
+        for (int i = 0; i < BENCHMARK_ENTITIES; ++i) {
+            switch (operation) {
+                case EncodeEditPacket:
+                    editPacketEncoder.encode(ids[i], properties[i]);
+                    numBytes += editPacketEncoder.getPacket().size();
+                    break;
+                case DecodeEditPacket: {
+                    int processedBytes = 0;
+                    EntityItemID decodedID;
+                    EntityItemProperties decoded;
+                    EntityItemProperties::decodeEntityEditPacket((const unsigned char*)editPackets[i].constData(),
+                        editPackets[i].size(), processedBytes, decodedID, decoded);
+                    numBytes += processedBytes;
+                    break;
+                }
+                case AppendEntityData:
+                    entityDataEncoder.append(entities[i]);
+                    numBytes += entityDataEncoder.getSize();
+                    break;
+                case ReadEntityData: {
+                    const unsigned char* data = (const unsigned char*)entityData[i].constData();
+                    EntityItemPointer entity = EntityTypes::constructEntityItem(data, entityData[i].size());
+                    ReadBitstreamToTreeParams args;
+                    numBytes += entity->readEntityDataFromBuffer(data, entityData[i].size(), args);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    };
+
+    // warm up, then take one pass for the report
+    run();
+    uint64_t allocationsBefore = allocationCount.load();
+    QElapsedTimer timer;
+    timer.start();
+    run();
+    qint64 elapsed = timer.nsecsElapsed();
+    uint64_t numAllocations = allocationCount.load() - allocationsBefore;
+    qDebug() << QTest::currentDataTag() << ":"
+             << elapsed / BENCHMARK_ENTITIES << "ns per entity,"
+             << numBytes / BENCHMARK_ENTITIES << "bytes per entity,"
+             << (double)numAllocations / BENCHMARK_ENTITIES << "allocations per entity";
+    QVERIFY(numBytes > 0);
+
+    QBENCHMARK {
+        run();
+    }
+}
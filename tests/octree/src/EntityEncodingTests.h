@@ -0,0 +1,28 @@
+//
+//  EntityEncodingTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-06-26.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodingTests_h
+#define hifi_EntityEncodingTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEncodingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void roundTripFuzzTest();
+    void streamedEditTest();
+    void encodingBenchmark_data();
+    void encodingBenchmark();
+};
+
+#endif // hifi_EntityEncodingTests_h
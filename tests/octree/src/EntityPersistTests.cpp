@@ -0,0 +1,284 @@
+//
+//  EntityPersistTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-06-23.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPersistTests.h"
+
+#include <random>
+
+#include <QtCore/QTemporaryDir>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreeBinaryFile.h>
+#include <OctreeJournal.h>
+
+QTEST_MAIN(EntityPersistTests)
+
+namespace {
+    const int SMALL_SCENE_ENTITIES = 1000;
+    const int BENCHMARK_SCENE_ENTITIES = 20000;
+    const float SCENE_SIZE = 1000.0f;
+
+    EntityTreePointer makeTree() {
+        EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
+        tree->setIsServer(true);
+        tree->createRootElement();
+        return tree;
+    }
+
+    EntityTreePointer makeScene(int numEntities, QVector<EntityItemID>& ids) {
+        EntityTreePointer tree = makeTree();
+        std::mt19937 generator(numEntities);
+        std::uniform_real_distribution<float> position(-0.5f * SCENE_SIZE, 0.5f * SCENE_SIZE);
+        std::uniform_real_distribution<float> size(0.2f, 2.0f);
+        tree->withWriteLock([&] {
+            for (int i = 0; i < numEntities; ++i) {
+                EntityItemProperties properties;
+                properties.setType((i % 2) ? EntityTypes::Box : EntityTypes::Text);
+                properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+                properties.setDimensions(glm::vec3(size(generator)));
+                properties.setName(QString("entity %1").arg(i));
+                properties.setUserData(QString("{\"index\":%1}").arg(i));
+                if (!(i % 2)) {
+                    properties.setText(QString("text %1").arg(i));
+                }
+                EntityItemID id(QUuid::createUuid());
+                if (tree->addEntity(id, properties)) {
+                    ids.push_back(id);
+                }
+            }
+        });
+        return tree;
+    }
+
+    bool load(const EntityTreePointer& tree, const QString& filename) {
+        bool success = false;
+        tree->withWriteLock([&] {
+            success = tree->readFromFile(filename.toLocal8Bit().constData());
+        });
+        return success;
+    }
+}
+
+void EntityPersistTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+// Test that a tree saved to a binary file loads back with the same entities, id and data version
+void EntityPersistTests::binaryRoundTripTest() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeScene(SMALL_SCENE_ENTITIES, ids);
+    QCOMPARE(ids.size(), SMALL_SCENE_ENTITIES);
+    tree->incrementPersistDataVersion();
+
+    QTemporaryDir directory;
+    QString filename = directory.filePath("models." + OctreeBinaryFile::FILE_TYPE);
+    QVERIFY(tree->writeToFile(filename.toLocal8Bit().constData(), nullptr, OctreeBinaryFile::FILE_TYPE));
+
+    EntityTreePointer loaded = makeTree();
+    QVERIFY(load(loaded, filename));
+    QCOMPARE(loaded->getPersistID(), tree->getPersistID());
+    QCOMPARE(loaded->getPersistDataVersion(), tree->getPersistDataVersion());
+
+    for (const EntityItemID& id : ids) {
+        EntityItemPointer original = tree->findEntityByEntityItemID(id);
+        EntityItemPointer copy = loaded->findEntityByEntityItemID(id);
+        QVERIFY(copy);
+        QCOMPARE(copy->getType(), original->getType());
+        QCOMPARE(copy->getName(), original->getName());
+        QCOMPARE(copy->getUserData(), original->getUserData());
+        QCOMPARE(copy->getLocalPosition(), original->getLocalPosition());
+        QCOMPARE(copy->getScaledDimensions(), original->getScaledDimensions());
+        QCOMPARE(copy->getCreated(), original->getCreated());
+    }
+}
+
+// Test that a binary file that's cut short isn't loaded
+void EntityPersistTests::corruptBinaryFileTest() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeScene(SMALL_SCENE_ENTITIES, ids);
+
+    QTemporaryDir directory;
+    QString filename = directory.filePath("models." + OctreeBinaryFile::FILE_TYPE);
+    QVERIFY(tree->writeToFile(filename.toLocal8Bit().constData(), nullptr, OctreeBinaryFile::FILE_TYPE));
+
+    QFile file(filename);
+    QVERIFY(file.resize(file.size() / 2));
+
+    EntityTreePointer loaded = makeTree();
+    QVERIFY(!load(loaded, filename));
+}
+
+// Test that replaying the journal over the snapshot it follows brings back the edits, adds and deletes, and that an
+// entry cut short by a crash is dropped
+void EntityPersistTests::journalReplayTest() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeScene(SMALL_SCENE_ENTITIES, ids);
+
+    QTemporaryDir directory;
+    QString filename = directory.filePath("models." + OctreeBinaryFile::FILE_TYPE);
+    QVERIFY(tree->writeToFile(filename.toLocal8Bit().constData(), nullptr, OctreeBinaryFile::FILE_TYPE));
+    OctreeJournal journal(directory.filePath("models." + OctreeJournal::EXTENSION));
+    QVERIFY(journal.reset(tree->getPersistID(), tree->getPersistDataVersion()));
+
+    tree->setWantJournal(true);
+    const glm::vec3 MOVED_POSITION(10.0f, 20.0f, 30.0f);
+    EntityItemID addedID(QUuid::createUuid());
+    tree->withWriteLock([&] {
+        EntityItemProperties properties;
+        properties.setName("edited");
+        properties.setPosition(MOVED_POSITION);
+        properties.setLastEdited(usecTimestampNow());
+        QVERIFY(tree->updateEntity(ids[0], properties));
+        tree->deleteEntity(ids[1], true);
+
+        EntityItemProperties addedProperties;
+        addedProperties.setType(EntityTypes::Box);
+        addedProperties.setName("added");
+        QVERIFY(tree->addEntity(addedID, addedProperties));
+    });
+    QByteArray changes;
+    QVERIFY(tree->takeJournalChanges(changes));
+    QVERIFY(!tree->takeJournalChanges(changes));
+    QVERIFY(journal.append(tree->getPersistDataVersion() + 1, changes));
+
+    tree->withWriteLock([&] {
+        tree->deleteEntity(ids[2], true);
+    });
+    QByteArray lostChanges;
+    QVERIFY(tree->takeJournalChanges(lostChanges));
+    QVERIFY(journal.append(tree->getPersistDataVersion() + 2, lostChanges));
+    {
+        // a crash while the last entry was written
+        QFile file(journal.getFilename());
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(file.size() - 1));
+    }
+
+    EntityTreePointer loaded = makeTree();
+    QVERIFY(load(loaded, filename));
+    OctreeJournal loadedJournal(journal.getFilename());
+    std::vector<OctreeJournal::Entry> entries;
+    QVERIFY(loadedJournal.open(loaded->getPersistID(), loaded->getPersistDataVersion(), entries));
+    QCOMPARE((int)entries.size(), 1);
+    loaded->withWriteLock([&] {
+        QVERIFY(loaded->replayJournalChanges(entries[0].changes));
+    });
+
+    EntityItemPointer edited = loaded->findEntityByEntityItemID(ids[0]);
+    QVERIFY(edited);
+    QCOMPARE(edited->getName(), QString("edited"));
+    QCOMPARE(edited->getLocalPosition(), MOVED_POSITION);
+    QVERIFY(!loaded->findEntityByEntityItemID(ids[1]));
+    QVERIFY(loaded->findEntityByEntityItemID(ids[2]));
+    EntityItemPointer added = loaded->findEntityByEntityItemID(addedID);
+    QVERIFY(added);
+    QCOMPARE(added->getName(), QString("added"));
+
+    // the journal doesn't follow any other snapshot
+    std::vector<OctreeJournal::Entry> otherEntries;
+    QVERIFY(!OctreeJournal(journal.getFilename()).open(QUuid::createUuid(), 0, otherEntries));
+}
+
+// Test that children which come before their parents in a file are hooked up to them once it's loaded
+void EntityPersistTests::parentFixupTest() {
+    const int NUM_FAMILIES = 100;
+    const int GENERATIONS = 5;
+    const glm::vec3 LOCAL_OFFSET(1.0f, 2.0f, 3.0f);
+    auto toVariant = [](const glm::vec3& v) {
+        QVariantMap map;
+        map["x"] = v.x;
+        map["y"] = v.y;
+        map["z"] = v.z;
+        return map;
+    };
+
+    // each family is written youngest generation first
+    QVector<QVector<QUuid>> families;
+    QVariantList entities;
+    for (int family = 0; family < NUM_FAMILIES; ++family) {
+        QVector<QUuid> ids;
+        for (int generation = 0; generation < GENERATIONS; ++generation) {
+            ids.push_back(QUuid::createUuid());
+        }
+        for (int generation = GENERATIONS - 1; generation >= 0; --generation) {
+            QVariantMap entity;
+            entity["id"] = ids[generation].toString();
+            entity["type"] = "Box";
+            if (generation > 0) {
+                entity["parentID"] = ids[generation - 1].toString();
+                entity["position"] = toVariant(LOCAL_OFFSET);
+            } else {
+                entity["position"] = toVariant(glm::vec3((float)family, 0.0f, 0.0f));
+            }
+            entities.push_back(entity);
+        }
+        families.push_back(ids);
+    }
+
+    EntityTreePointer loaded = makeTree();
+    QVariantMap map;
+    map["Version"] = (int)loaded->expectedVersion();
+    map["Entities"] = entities;
+    loaded->withWriteLock([&] {
+        QVERIFY(loaded->readFromMap(map));
+    });
+
+    for (int family = 0; family < NUM_FAMILIES; ++family) {
+        for (int generation = 1; generation < GENERATIONS; ++generation) {
+            EntityItemPointer entity = loaded->findEntityByEntityItemID(families[family][generation]);
+            QVERIFY(entity);
+            QCOMPARE(entity->getParentID(), families[family][generation - 1]);
+            QVERIFY(entity->isParentIDValid());
+            QCOMPARE(entity->getWorldPosition(), glm::vec3((float)family, 0.0f, 0.0f) + (float)generation * LOCAL_OFFSET);
+        }
+    }
+}
+
+void EntityPersistTests::persistBenchmark_data() {
+    QTest::addColumn<QString>("fileType");
+    QTest::addColumn<bool>("save");
+
+    QTest::newRow("json.gz, save") << QString("json.gz") << true;
+    QTest::newRow("binary, save") << OctreeBinaryFile::FILE_TYPE << true;
+    QTest::newRow("json.gz, load") << QString("json.gz") << false;
+    QTest::newRow("binary, load") << OctreeBinaryFile::FILE_TYPE << false;
+}
+
+// Benchmark saving and loading a 20k entity scene as compressed JSON and as a binary file
+void EntityPersistTests::persistBenchmark() {
+    QFETCH(QString, fileType);
+    QFETCH(bool, save);
+
+    static QVector<EntityItemID> ids;
+    static EntityTreePointer tree = makeScene(BENCHMARK_SCENE_ENTITIES, ids);
+    static QTemporaryDir directory;
+    QString filename = directory.filePath("models." + fileType);
+    if (!save) {
+        QVERIFY(tree->writeToFile(filename.toLocal8Bit().constData(), nullptr, fileType));
+    }
+
+    QBENCHMARK {
+        if (save) {
+            QVERIFY(tree->writeToFile(filename.toLocal8Bit().constData(), nullptr, fileType));
+        } else {
+            EntityTreePointer loaded = makeTree();
+            QVERIFY(load(loaded, filename));
+        }
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  EntityPersistTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-06-23.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPersistTests_h
+#define hifi_EntityPersistTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPersistTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void binaryRoundTripTest();
+    void corruptBinaryFileTest();
+    void journalReplayTest();
+    void parentFixupTest();
+    void persistBenchmark_data();
+    void persistBenchmark();
+};
+
+#endif // hifi_EntityPersistTests_h
@@ -0,0 +1,200 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-06-22.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <random>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+namespace {
+    const int SMALL_SCENE_ENTITIES = 5000;
+    const int BENCHMARK_SCENE_ENTITIES = 100000;
+    const float SCENE_SIZE = 1000.0f;
+    // one entity in this many is big enough to cross the boundaries of large elements
+    const int BIG_ENTITY_PERIOD = 100;
+    const int NUM_SEARCHES = 200;
+
+    struct Search {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        float radius;
+    };
+
+    EntityTreePointer makeScene(int numEntities, QVector<EntityItemID>& ids) {
+        EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
+        tree->setIsServer(true);
+        tree->createRootElement();
+
+        std::mt19937 generator(numEntities);
+        std::uniform_real_distribution<float> position(-0.5f * SCENE_SIZE, 0.5f * SCENE_SIZE);
+        std::uniform_real_distribution<float> smallSize(0.2f, 2.0f);
+        std::uniform_real_distribution<float> bigSize(20.0f, 100.0f);
+        tree->withWriteLock([&] {
+            for (int i = 0; i < numEntities; ++i) {
+                EntityItemProperties properties;
+                properties.setType(EntityTypes::Box);
+                properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+                float size = (i % BIG_ENTITY_PERIOD) ? smallSize(generator) : bigSize(generator);
+                properties.setDimensions(glm::vec3(size));
+                EntityItemID id(QUuid::createUuid());
+                if (tree->addEntity(id, properties)) {
+                    ids.push_back(id);
+                }
+            }
+        });
+        return tree;
+    }
+
+    QVector<Search> makeSearches() {
+        std::mt19937 generator(NUM_SEARCHES);
+        std::uniform_real_distribution<float> position(-0.5f * SCENE_SIZE, 0.5f * SCENE_SIZE);
+        std::uniform_real_distribution<float> radius(1.0f, 20.0f);
+        QVector<Search> searches;
+        for (int i = 0; i < NUM_SEARCHES; ++i) {
+            glm::vec3 origin(position(generator), position(generator), position(generator));
+            glm::vec3 target(position(generator), position(generator), position(generator));
+            searches.push_back({ origin, glm::normalize(target - origin), radius(generator) });
+        }
+        return searches;
+    }
+
+    EntityItemID findRayIntersection(const EntityTreePointer& tree, const Search& search, float& distance) {
+        OctreeElementPointer element;
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+        return tree->evalRayIntersection(search.origin, search.direction, QVector<EntityItemID>(), QVector<EntityItemID>(),
+                                         PickFilter(), element, distance, face, surfaceNormal, extraInfo, Octree::Lock);
+    }
+
+    QSet<QUuid> findEntitiesInSphere(const EntityTreePointer& tree, const glm::vec3& center, float radius) {
+        QVector<QUuid> found;
+        tree->withReadLock([&] {
+            tree->evalEntitiesInSphere(center, radius, PickFilter(), found);
+        });
+        return QSet<QUuid>::fromList(found.toList());
+    }
+}
+
+void EntitySpatialIndexTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+// Test that searching the spatial index finds what recursing through the tree's elements does
+void EntitySpatialIndexTests::searchesMatchTest() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeScene(SMALL_SCENE_ENTITIES, ids);
+    QCOMPARE(ids.size(), SMALL_SCENE_ENTITIES);
+    QCOMPARE(tree->getSpatialIndex().size(), SMALL_SCENE_ENTITIES);
+
+    int numHits = 0;
+    for (const Search& search : makeSearches()) {
+        tree->setUseSpatialIndex(false);
+        QSet<QUuid> expected = findEntitiesInSphere(tree, search.origin, search.radius);
+        float expectedDistance;
+        EntityItemID expectedHit = findRayIntersection(tree, search, expectedDistance);
+
+        tree->setUseSpatialIndex(true);
+        QCOMPARE(findEntitiesInSphere(tree, search.origin, search.radius), expected);
+        float distance;
+        EntityItemID hit = findRayIntersection(tree, search, distance);
+
+        // the elements are searched nearest first, but the search stops in the first one with a hit, which may not
+        // have the nearest one
+        QCOMPARE(hit.isNull(), expectedHit.isNull());
+        if (!hit.isNull()) {
+            QVERIFY(distance <= expectedDistance);
+            ++numHits;
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+// Test that the index follows entities that move, and forgets the ones that are deleted
+void EntitySpatialIndexTests::movedAndDeletedEntitiesTest() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeScene(SMALL_SCENE_ENTITIES, ids);
+    QCOMPARE(ids.size(), SMALL_SCENE_ENTITIES);
+
+    const glm::vec3 FAR_AWAY(2.0f * SCENE_SIZE);
+    QVERIFY(findEntitiesInSphere(tree, FAR_AWAY, 1.0f).isEmpty());
+
+    tree->withWriteLock([&] {
+        EntityItemProperties properties;
+        properties.setPosition(FAR_AWAY);
+        // as the client that moves an entity sends
+        properties.setQueryAACube(AACube(FAR_AWAY - glm::vec3(5.0f), 10.0f));
+        properties.setLastEdited(usecTimestampNow());
+        QVERIFY(tree->updateEntity(ids[0], properties));
+        tree->deleteEntity(ids[1], true);
+    });
+
+    QCOMPARE(findEntitiesInSphere(tree, FAR_AWAY, 1.0f), QSet<QUuid>({ ids[0] }));
+    QCOMPARE(tree->getSpatialIndex().size(), SMALL_SCENE_ENTITIES - 1);
+
+    EntityItemPointer deleted = tree->findEntityByEntityItemID(ids[2]);
+    glm::vec3 position = deleted->getWorldPosition();
+    QVERIFY(findEntitiesInSphere(tree, position, 0.1f).contains(ids[2]));
+    tree->withWriteLock([&] {
+        tree->deleteEntity(ids[2], true);
+    });
+    QVERIFY(!findEntitiesInSphere(tree, position, 0.1f).contains(ids[2]));
+}
+
+void EntitySpatialIndexTests::queryBenchmark_data() {
+    QTest::addColumn<bool>("useSpatialIndex");
+    QTest::addColumn<bool>("rays");
+
+    QTest::newRow("rays, elements") << false << true;
+    QTest::newRow("rays, spatial index") << true << true;
+    QTest::newRow("spheres, elements") << false << false;
+    QTest::newRow("spheres, spatial index") << true << false;
+}
+
+// Benchmark ray and sphere searches of a 100k entity scene, recursing through the elements or with the spatial index
+void EntitySpatialIndexTests::queryBenchmark() {
+    QFETCH(bool, useSpatialIndex);
+    QFETCH(bool, rays);
+
+    static QVector<EntityItemID> ids;
+    static EntityTreePointer tree = makeScene(BENCHMARK_SCENE_ENTITIES, ids);
+    static QVector<Search> searches = makeSearches();
+    tree->setUseSpatialIndex(useSpatialIndex);
+
+    int numFound = 0;
+    QBENCHMARK {
+        numFound = 0;
+        for (const Search& search : searches) {
+            if (rays) {
+                float distance;
+                numFound += findRayIntersection(tree, search, distance).isNull() ? 0 : 1;
+            } else {
+                QVector<QUuid> found;
+                tree->withReadLock([&] {
+                    tree->evalEntitiesInSphere(search.origin, search.radius, PickFilter(), found);
+                });
+                numFound += found.size();
+            }
+        }
+    }
+    QVERIFY(numFound > 0);
+}
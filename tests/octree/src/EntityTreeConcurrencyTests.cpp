@@ -0,0 +1,288 @@
+//
+//  EntityTreeConcurrencyTests.cpp
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-06-20.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeConcurrencyTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityMap.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <EntityTreeSnapshot.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityTreeConcurrencyTests)
+
+namespace {
+    const int NUM_ENTITIES = 2000;
+    const int NUM_READERS = 4;
+    const int TRAVERSALS_PER_READER = 50;
+    const int LOOKUPS_PER_TRAVERSAL = 100;
+    const int NUM_EDITS = 2000;
+    // one edit in this many moves its entity, the others can be applied in place
+    const int MOVING_EDIT_PERIOD = 10;
+
+    void collectElements(const EntityTreeSnapshot::ElementPointer& element, QSet<const EntityTreeSnapshot::Element*>& elements,
+                         QSet<EntityItem*>& entities) {
+        elements.insert(element.get());
+        element->forEachEntity([&](const EntityItemPointer& entity) {
+            entities.insert(entity.get());
+        });
+        for (int i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+            if (element->getChildAtIndex(i)) {
+                collectElements(element->getChildAtIndex(i), elements, entities);
+            }
+        }
+    }
+
+    glm::vec3 positionOf(int i) {
+        return glm::vec3((float)(i % 20) * 10.0f, (float)((i / 20) % 10) * 10.0f, (float)(i / 200) * 10.0f);
+    }
+
+    EntityTreePointer makeTree(QVector<EntityItemID>& ids) {
+        EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
+        tree->setIsServer(true);
+        tree->createRootElement();
+
+        tree->withWriteLock([&] {
+            for (int i = 0; i < NUM_ENTITIES; ++i) {
+                EntityItemProperties properties;
+                properties.setType(EntityTypes::Box);
+                properties.setPosition(positionOf(i));
+                properties.setDimensions(glm::vec3(1.0f));
+                properties.setName(QString("entity %1").arg(i));
+                EntityItemID id(QUuid::createUuid());
+                if (tree->addEntity(id, properties)) {
+                    ids.push_back(id);
+                }
+            }
+        });
+        return tree;
+    }
+}
+
+void EntityTreeConcurrencyTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+// Test that the sharded entity map finds, replaces and removes entities like a single hash
+void EntityTreeConcurrencyTests::entityMapTest() {
+    EntityMap map;
+    QHash<EntityItemID, EntityItemPointer> expected;
+    for (int i = 0; i < 500; ++i) {
+        EntityItemID id(QUuid::createUuid());
+        EntityItemPointer entity = EntityTypes::constructEntityItem(EntityTypes::Box, id, EntityItemProperties());
+        QVERIFY(map.insert(id, entity));
+        QVERIFY(!map.insert(id, entity));
+        expected.insert(id, entity);
+    }
+    QCOMPARE(map.size(), expected.size());
+    for (auto itr = expected.begin(); itr != expected.end(); ++itr) {
+        QCOMPARE(map.value(itr.key()), itr.value());
+    }
+
+    int removed = 0;
+    map.removeIf([&](const EntityItemPointer& entity) {
+        if (entity->getID().data1 % 2) {
+            expected.remove(entity->getID());
+            ++removed;
+            return true;
+        }
+        return false;
+    });
+    QVERIFY(removed > 0);
+    QCOMPARE(map.size(), expected.size());
+    QCOMPARE(map.values().size(), expected.size());
+
+    QHash<EntityItemID, EntityItemPointer> taken = map.takeAll();
+    QCOMPARE(taken, expected);
+    QCOMPARE(map.size(), 0);
+    QVERIFY(!map.value(expected.begin().key()));
+}
+
+// Test that only edits which leave the entity where it is in the tree are applied in place
+void EntityTreeConcurrencyTests::inPlaceUpdateTest() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeTree(ids);
+    QCOMPARE(ids.size(), NUM_ENTITIES);
+
+    EntityItemProperties rename;
+    rename.setName("renamed");
+    rename.setUserData("{}");
+    QVERIFY(EntityTree::canUpdateEntityInPlace(rename));
+
+    EntityItemProperties move;
+    move.setName("moved");
+    move.setPosition(glm::vec3(500.0f));
+    QVERIFY(!EntityTree::canUpdateEntityInPlace(move));
+    QVERIFY(!EntityTree::canUpdateEntityInPlace(EntityItemProperties()));
+
+    EntityItemPointer entity = tree->findEntityByEntityItemID(ids[0]);
+    QVERIFY(entity);
+    EntityTreeElementPointer element = entity->getElement();
+    quint64 lastChanged = element->getLastChanged();
+    quint64 lastChangedContent = element->getLastChangedContent();
+    QTest::qSleep(1);
+
+    bool updatedInPlace = false;
+    tree->withReadLock([&] {
+        updatedInPlace = tree->updateEntityInPlace(entity, rename);
+    });
+    QVERIFY(updatedInPlace);
+    QCOMPARE(entity->getName(), QString("renamed"));
+    QCOMPARE(entity->getElement(), element);
+    QVERIFY(element->getLastChanged() > lastChanged);
+    QVERIFY(element->getLastChangedContent() > lastChangedContent);
+    QVERIFY(tree->getRoot()->getLastChanged() > lastChanged);
+
+    // a locked entity is left to updateEntity()
+    entity->setLocked(true);
+    tree->withReadLock([&] {
+        updatedInPlace = tree->updateEntityInPlace(entity, rename);
+    });
+    QVERIFY(!updatedInPlace);
+}
+
+// Test that snapshots are only made again after the tree changes, share what didn't change, and don't see later changes
+void EntityTreeConcurrencyTests::snapshotTest() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeTree(ids);
+    QCOMPARE(ids.size(), NUM_ENTITIES);
+
+    EntityTreeSnapshotPointer snapshot = tree->getSnapshot();
+    QVERIFY(snapshot);
+    QCOMPARE(tree->getSnapshot(), snapshot);
+
+    QSet<const EntityTreeSnapshot::Element*> elements;
+    QSet<EntityItem*> entities;
+    collectElements(snapshot->getRoot(), elements, entities);
+    QCOMPARE(entities.size(), NUM_ENTITIES);
+
+    // move one entity far away and delete another
+    EntityItemPointer deleted = tree->findEntityByEntityItemID(ids[1]);
+    tree->withWriteLock([&] {
+        EntityItemProperties move;
+        move.setPosition(glm::vec3(-1000.0f));
+        move.setLastEdited(usecTimestampNow());
+        QVERIFY(tree->updateEntity(ids[0], move));
+        tree->deleteEntity(ids[1], true);
+    });
+    QVERIFY(deleted->isDead());
+
+    EntityTreeSnapshotPointer nextSnapshot = tree->getSnapshot();
+    QVERIFY(nextSnapshot && nextSnapshot != snapshot);
+    QVERIFY(nextSnapshot->getRoot() != snapshot->getRoot());
+    QVERIFY(nextSnapshot->getTimestamp() > snapshot->getTimestamp());
+    QCOMPARE(tree->getSnapshot(), nextSnapshot);
+
+    QSet<const EntityTreeSnapshot::Element*> nextElements;
+    QSet<EntityItem*> nextEntities;
+    collectElements(nextSnapshot->getRoot(), nextElements, nextEntities);
+    QCOMPARE(nextEntities.size(), NUM_ENTITIES - 1);
+    QVERIFY(!nextEntities.contains(deleted.get()));
+    QVERIFY(nextElements.intersects(elements));
+
+    // the old snapshot is as it was
+    QSet<const EntityTreeSnapshot::Element*> oldElements;
+    QSet<EntityItem*> oldEntities;
+    collectElements(snapshot->getRoot(), oldElements, oldEntities);
+    QCOMPARE(oldElements, elements);
+    QCOMPARE(oldEntities, entities);
+}
+
+// Benchmark send-thread-like readers traversing the tree and looking entities up while one writer edits it
+void EntityTreeConcurrencyTests::concurrentReadersAndWritersBenchmark() {
+    QVector<EntityItemID> ids;
+    EntityTreePointer tree = makeTree(ids);
+    QCOMPARE(ids.size(), NUM_ENTITIES);
+
+    std::atomic<int> entitiesVisited { 0 };
+    std::atomic<int> inPlaceEdits { 0 };
+
+    QBENCHMARK {
+        std::vector<std::thread> threads;
+        for (int reader = 0; reader < NUM_READERS; ++reader) {
+            threads.emplace_back([&, reader] {
+                int visited = 0;
+                for (int traversal = 0; traversal < TRAVERSALS_PER_READER; ++traversal) {
+                    tree->withReadLock([&] {
+                        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+                            auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+                            entityTreeElement->forEachEntity([&](EntityItemPointer entity) {
+                                visited += entity->getName().isEmpty() ? 0 : 1;
+                            });
+                            return true;
+                        });
+                    });
+                    for (int i = 0; i < LOOKUPS_PER_TRAVERSAL; ++i) {
+                        int index = (reader * 7919 + traversal * LOOKUPS_PER_TRAVERSAL + i) % ids.size();
+                        if (tree->findEntityByEntityItemID(ids[index])) {
+                            ++visited;
+                        }
+                    }
+                }
+                entitiesVisited += visited;
+            });
+        }
+
+        threads.emplace_back([&] {
+            for (int edit = 0; edit < NUM_EDITS; ++edit) {
+                EntityItemPointer entity = tree->findEntityByEntityItemID(ids[edit % ids.size()]);
+                if (!entity) {
+                    continue;
+                }
+                EntityItemProperties properties;
+                properties.setName(QString("edit %1").arg(edit));
+                properties.setLastEdited(usecTimestampNow());
+                if (edit % MOVING_EDIT_PERIOD == 0) {
+                    properties.setPosition(positionOf(edit) + glm::vec3(0.5f));
+                }
+
+                // as EntityTree::processEditPacketData applies an edit
+                bool updatedInPlace = false;
+                if (EntityTree::canUpdateEntityInPlace(properties)) {
+                    tree->withReadLock([&] {
+                        updatedInPlace = tree->updateEntityInPlace(entity, properties);
+                    });
+                }
+                if (updatedInPlace) {
+                    ++inPlaceEdits;
+                } else {
+                    tree->withWriteLock([&] {
+                        tree->updateEntity(entity->getEntityItemID(), properties);
+                    });
+                }
+            }
+        });
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    QVERIFY(entitiesVisited > 0);
+    QVERIFY(inPlaceEdits > 0);
+    // every entity has the name of the last edit to it, whichever way it was applied
+    for (int edit = qMax(0, NUM_EDITS - ids.size()); edit < NUM_EDITS; ++edit) {
+        EntityItemPointer entity = tree->findEntityByEntityItemID(ids[edit % ids.size()]);
+        QVERIFY(entity);
+        QCOMPARE(entity->getName(), QString("edit %1").arg(edit));
+    }
+}
@@ -0,0 +1,28 @@
+//
+//  EntityTreeConcurrencyTests.h
+//  tests/octree/src
+//
+//  Created by High Fidelity on 2019-06-20.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeConcurrencyTests_h
+#define hifi_EntityTreeConcurrencyTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeConcurrencyTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void entityMapTest();
+    void inPlaceUpdateTest();
+    void snapshotTest();
+    void concurrentReadersAndWritersBenchmark();
+};
+
+#endif // hifi_EntityTreeConcurrencyTests_h
@@ -21,7 +21,9 @@
 #include <EntityTree.h>
 #include <EntityTreeElement.h>
 #include <Octree.h>
+#include <OctreeCompressionDictionary.h>
 #include <OctreeConstants.h>
+#include <OctreePacketData.h>
 #include <PropertyFlags.h>
 #include <SharedUtil.h>
 
@@ -827,3 +829,42 @@ void OctreeTests::elementAddChildTests() {
         }
     }
 }
+
+// Test that packet content compressed with zlib, zstd and zstd with a dictionary loads back the same, that the dictionary
+// makes packets smaller, and that content compressed with another dictionary isn't loaded
+void OctreeTests::packetCompressionTests() {
+    auto makeContent = [](int i) {
+        return QString("{\"modelURL\":\"https://cdn.example.com/models/building-%1.fbx\",\"userData\":"
+                       "{\"grabbableKey\":{\"grabbable\":false},\"index\":%2}}").arg(i % 7).arg(i).toUtf8();
+    };
+    const int NUM_SAMPLES = 2000;
+    std::vector<QByteArray> samples;
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        samples.push_back(makeContent(i));
+    }
+    auto dictionary = OctreeCompressionDictionary::create(OctreeCompressionDictionary::train(samples, 16 * 1024));
+    QVERIFY(dictionary);
+
+    QByteArray content = makeContent(NUM_SAMPLES) + makeContent(NUM_SAMPLES + 1);
+    auto roundTrip = [&](OctreePacketCompression compression, const OctreeCompressionDictionaryPointer& packDictionary,
+                         const OctreeCompressionDictionaryPointer& loadDictionary, int& compressedSize) {
+        OctreePacketData packed(true);
+        packed.setCompression(compression, packDictionary);
+        packed.appendRawData(content);
+        QByteArray compressed((const char*)packed.getFinalizedData(), packed.getFinalizedSize());
+        compressedSize = compressed.size();
+
+        OctreePacketData loaded(true);
+        loaded.setCompression(compression, loadDictionary);
+        loaded.loadFinalizedContent((const unsigned char*)compressed.constData(), compressed.size());
+        return QByteArray((const char*)loaded.getUncompressedData(), loaded.getUncompressedSize());
+    };
+
+    int zlibSize, zstdSize, dictionarySize, mismatchSize;
+    QCOMPARE(roundTrip(OctreePacketCompression::Zlib, nullptr, nullptr, zlibSize), content);
+    QCOMPARE(roundTrip(OctreePacketCompression::Zstd, nullptr, nullptr, zstdSize), content);
+    QCOMPARE(roundTrip(OctreePacketCompression::Zstd, dictionary, dictionary, dictionarySize), content);
+    QVERIFY(dictionarySize < zstdSize);
+
+    QVERIFY(roundTrip(OctreePacketCompression::Zstd, dictionary, nullptr, mismatchSize).isEmpty());
+}
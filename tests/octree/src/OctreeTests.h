@@ -27,6 +27,8 @@ private slots:
 
     void elementAddChildTests();
 
+    void packetCompressionTests();
+
     // TODO: Break these into separate test functions
 };
 
@@ -0,0 +1,112 @@
+//
+//  MPSCRingTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-06-14.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MPSCRingTests.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <MPSCRing.h>
+
+QTEST_MAIN(MPSCRingTests)
+
+namespace {
+    const int NUM_PRODUCERS = 4;
+    const int NUM_VALUES = 100000;
+}
+
+void MPSCRingTests::orderTest() {
+    MPSCRing<int, 8> ring;
+    int value = -1;
+
+    QVERIFY(ring.empty());
+    QVERIFY(!ring.pop(value));
+
+    int next = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            QVERIFY(ring.push(round * 5 + i));
+        }
+        while (ring.pop(value)) {
+            QCOMPARE(value, next++);
+        }
+        QVERIFY(ring.empty());
+    }
+    QCOMPARE(next, 50);
+}
+
+void MPSCRingTests::overflowTest() {
+    MPSCRing<std::unique_ptr<int>, 4> ring;
+
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(ring.push(std::unique_ptr<int>(new int(i))));
+    }
+
+    // a refused push must not consume the value
+    std::unique_ptr<int> extra(new int(4));
+    QVERIFY(!ring.push(std::move(extra)));
+    QVERIFY(extra);
+    QCOMPARE(ring.sampleNumOverflows(), (uint32_t)1);
+    QCOMPARE(ring.sampleNumOverflows(), (uint32_t)0);
+
+    std::unique_ptr<int> value;
+    QVERIFY(ring.pop(value));
+    QCOMPARE(*value, 0);
+    QVERIFY(ring.push(std::move(extra)));
+
+    for (int i = 1; i <= 4; ++i) {
+        QVERIFY(ring.pop(value));
+        QCOMPARE(*value, i);
+    }
+    QVERIFY(ring.empty());
+}
+
+void MPSCRingTests::concurrentProducersTest() {
+    auto ring = std::unique_ptr<MPSCRing<int, 64>>(new MPSCRing<int, 64>());
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back([&ring, producer] {
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                while (!ring->push(producer * NUM_VALUES + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> lastValues(NUM_PRODUCERS, -1);
+    int numReceived = 0;
+    bool inOrder = true;
+    int value;
+    while (numReceived < NUM_PRODUCERS * NUM_VALUES) {
+        if (ring->pop(value)) {
+            int producer = value / NUM_VALUES;
+            int index = value % NUM_VALUES;
+            inOrder = inOrder && (index == lastValues[producer] + 1);
+            lastValues[producer] = index;
+            ++numReceived;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    QVERIFY(inOrder);
+    QVERIFY(ring->empty());
+    for (int lastValue : lastValues) {
+        QCOMPARE(lastValue, NUM_VALUES - 1);
+    }
+}
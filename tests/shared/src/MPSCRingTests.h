@@ -0,0 +1,30 @@
+//
+//  MPSCRingTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-06-14.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MPSCRingTests_h
+#define hifi_MPSCRingTests_h
+
+#include <QtTest/QtTest>
+
+class MPSCRingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that values come out in the order they were pushed, across several wraps of the ring
+    void orderTest();
+
+    // Test that a full ring refuses (and counts) pushes until the consumer catches up
+    void overflowTest();
+
+    // Test that concurrent producers never lose or reorder their own values
+    void concurrentProducersTest();
+};
+
+#endif // hifi_MPSCRingTests_h
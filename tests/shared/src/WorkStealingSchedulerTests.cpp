@@ -0,0 +1,109 @@
+//
+//  WorkStealingSchedulerTests.cpp
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-06-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingSchedulerTests.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <WorkStealingScheduler.h>
+
+QTEST_MAIN(WorkStealingSchedulerTests)
+
+void WorkStealingSchedulerTests::partitionTest() {
+    WorkStealingScheduler scheduler(2);
+
+    // one expensive task up front should get a worker to itself
+    WorkStealingScheduler::Costs costs { 100, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10 };
+    scheduler.prepare(costs);
+
+    size_t task;
+    QVERIFY(scheduler.next(0, task));
+    QCOMPARE(task, (size_t)0);
+
+    std::vector<size_t> tasks;
+    while (scheduler.next(1, task)) {
+        tasks.push_back(task);
+    }
+    QCOMPARE(tasks.size(), costs.size() - 1);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        QCOMPARE(tasks[i], i + 1);
+    }
+    QVERIFY(!scheduler.next(0, task));
+    QCOMPARE(scheduler.sampleNumSteals(), (uint32_t)0);
+
+    // uniform costs split evenly
+    scheduler.setNumWorkers(4);
+    scheduler.prepare(WorkStealingScheduler::Costs(16, 0));
+    for (int worker = 0; worker < 4; ++worker) {
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(scheduler.next(worker, task));
+            QCOMPARE(task, (size_t)(worker * 4 + i));
+        }
+    }
+}
+
+void WorkStealingSchedulerTests::stealTest() {
+    const size_t NUM_TASKS = 100;
+    WorkStealingScheduler scheduler(4);
+    scheduler.prepare(NUM_TASKS);
+
+    std::vector<int> runs(NUM_TASKS, 0);
+    size_t task;
+    while (scheduler.next(0, task)) {
+        ++runs[task];
+    }
+
+    for (int count : runs) {
+        QCOMPARE(count, 1);
+    }
+    QVERIFY(scheduler.sampleNumSteals() > 0);
+    QVERIFY(!scheduler.next(3, task));
+}
+
+void WorkStealingSchedulerTests::concurrentTest() {
+    const int NUM_WORKERS = 4;
+    const size_t NUM_TASKS = 1000;
+    const int NUM_JOBS = 20;
+
+    WorkStealingScheduler scheduler(NUM_WORKERS);
+    std::vector<std::atomic<int>> runs(NUM_TASKS);
+
+    for (int job = 0; job < NUM_JOBS; ++job) {
+        for (auto& count : runs) {
+            count = 0;
+        }
+        scheduler.prepare(NUM_TASKS);
+
+        std::vector<std::thread> workers;
+        for (int worker = 0; worker < NUM_WORKERS; ++worker) {
+            workers.emplace_back([&scheduler, &runs, worker] {
+                size_t task;
+                while (scheduler.next(worker, task)) {
+                    ++runs[task];
+                    // the first worker is slow, the others have to steal from it
+                    if (worker == 0) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(10));
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        for (auto& count : runs) {
+            QCOMPARE(count.load(), 1);
+        }
+    }
+}
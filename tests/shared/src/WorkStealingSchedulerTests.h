@@ -0,0 +1,30 @@
+//
+//  WorkStealingSchedulerTests.h
+//  tests/shared/src
+//
+//  Created by High Fidelity on 2019-06-17.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_WorkStealingSchedulerTests_h
+#define hifi_WorkStealingSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class WorkStealingSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the initial ranges are contiguous and balanced by cost
+    void partitionTest();
+
+    // Test that a single worker steals everything the others left behind
+    void stealTest();
+
+    // Test that concurrent workers run every task exactly once, over several jobs
+    void concurrentTest();
+};
+
+#endif // hifi_WorkStealingSchedulerTests_h
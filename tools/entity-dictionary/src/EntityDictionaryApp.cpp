@@ -0,0 +1,118 @@
+//
+//  EntityDictionaryApp.cpp
+//  tools/entity-dictionary/src
+//
+//  Created by High Fidelity on 2019-06-25.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityDictionaryApp.h"
+
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreeBinaryFile.h>
+#include <OctreeCompressionDictionary.h>
+
+EntityDictionaryApp::EntityDictionaryApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Entity Compression Dictionary Trainer");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input persist file", "models.json.gz");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output dictionary file", "entities.dict");
+    parser.addOption(outputFilenameOption);
+
+    const QCommandLineOption maxSizeOption("s", "maximum dictionary size in bytes", "size",
+                                           QString::number(OctreeCompressionDictionary::DEFAULT_MAX_SIZE));
+    parser.addOption(maxSizeOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(inputFilenameOption) || !parser.isSet(outputFilenameOption)) {
+        qCritical() << "Both an input and an output file are needed";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+    QString inputFilename = parser.value(inputFilenameOption);
+    QString outputFilename = parser.value(outputFilenameOption);
+    size_t maxSize = parser.value(maxSizeOption).toULongLong();
+
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+
+    EntityTreePointer tree = EntityTreePointer(new EntityTree(true));
+    tree->setIsServer(true);
+    tree->createRootElement();
+    bool loaded = false;
+    tree->withWriteLock([&] {
+        loaded = tree->readFromFile(inputFilename.toLocal8Bit().constData());
+    });
+    if (!loaded) {
+        qCritical() << "Failed to load entities from" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    // each item of a binary persist file is one entity, with all of its properties encoded the way they're sent
+    QTemporaryDir directory;
+    QString binaryFilename = directory.filePath("models." + OctreeBinaryFile::FILE_TYPE);
+    OctreeBinaryFile binaryFile;
+    if (!tree->writeToFile(binaryFilename.toLocal8Bit().constData(), nullptr, OctreeBinaryFile::FILE_TYPE) ||
+        !binaryFile.open(binaryFilename)) {
+        qCritical() << "Failed to encode the entities of" << inputFilename;
+        _returnCode = 3;
+        return;
+    }
+    std::vector<QByteArray> samples;
+    for (const OctreeBinaryFile::Section& section : binaryFile.getSections()) {
+        binaryFile.forEachItem(section, [&](const unsigned char* data, int size) {
+            samples.emplace_back(reinterpret_cast<const char*>(data), size);
+            return true;
+        });
+    }
+
+    QByteArray dictionary = OctreeCompressionDictionary::train(samples, maxSize);
+    if (dictionary.isEmpty()) {
+        qCritical() << "Failed to train a dictionary on" << samples.size() << "entities";
+        _returnCode = 4;
+        return;
+    }
+
+    QFile file(outputFilename);
+    if (!file.open(QIODevice::WriteOnly) || file.write(dictionary) != dictionary.size()) {
+        qCritical() << "Failed to write" << outputFilename << file.errorString();
+        _returnCode = 5;
+        return;
+    }
+    qDebug() << "Trained a" << dictionary.size() << "byte dictionary on" << samples.size() << "entities";
+}
+
+EntityDictionaryApp::~EntityDictionaryApp() {
+}
@@ -0,0 +1,30 @@
+//
+//  EntityDictionaryApp.h
+//  tools/entity-dictionary/src
+//
+//  Created by High Fidelity on 2019-06-25.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityDictionaryApp_h
+#define hifi_EntityDictionaryApp_h
+
+#include <QCoreApplication>
+
+// Trains the zstd dictionary an entity server compresses its octree packets with on the entities of a persist file.
+class EntityDictionaryApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    EntityDictionaryApp(int argc, char* argv[]);
+    ~EntityDictionaryApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif //hifi_EntityDictionaryApp_h
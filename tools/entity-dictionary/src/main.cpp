@@ -0,0 +1,20 @@
+//
+//  main.cpp
+//  tools/entity-dictionary/src
+//
+//  Created by High Fidelity on 2019-06-25.
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+
+#include <SharedUtil.h>
+
+#include "EntityDictionaryApp.h"
+
+int main(int argc, char * argv[]) {
+    setupHifiApplication("Entity Dictionary App");
+
+    EntityDictionaryApp app(argc, argv);
+    return app.getReturnCode();
+}
@@ -30,12 +30,17 @@
 #include "MaterialBaker.h"
 
 Oven* Oven::_staticInstance { nullptr };
+int Oven::_requestedNumWorkerThreads { 0 };
 
 Oven::Oven() {
     _staticInstance = this;
 
     // setup our worker threads
-    setupWorkerThreads(QThread::idealThreadCount());
+    setupWorkerThreads(_requestedNumWorkerThreads > 0 ? _requestedNumWorkerThreads : QThread::idealThreadCount());
+    if (_requestedNumWorkerThreads > 0) {
+        // texture processing runs its own parallel loops, keep those within the same number of threads
+        image::setMaxProcessingThreads(_requestedNumWorkerThreads);
+    }
 
     // Initialize dependencies for OBJ Baker
     DependencyManager::set<StatTracker>();
@@ -26,6 +26,10 @@ public:
 
     static Oven& instance() { return *_staticInstance; }
 
+    // the number of worker threads ovens are made with, and the cap on texture processing threads, the ideal thread
+    // count (and no cap) if 0
+    static void setNumWorkerThreads(int numWorkerThreads) { _requestedNumWorkerThreads = numWorkerThreads; }
+
     QThread* getNextWorkerThread();
 
 private:
@@ -38,6 +42,7 @@ private:
     int _numWorkerThreads;
 
     static Oven* _staticInstance;
+    static int _requestedNumWorkerThreads;
 };
 
 